@@ -34,74 +34,153 @@
 /*================== Includes =============================================*/
 #include "bms.h"
 #include "interlock.h"
+#include "fasttrip.h"
+#include "latency.h"
 #include "os.h"
 #include "diag.h"
 #include "database.h"
 #include "batterycell_cfg.h"
 #include "batterysystem_cfg.h"
+#include "soa.h"
+#include "mcu.h"
+#include "stm32f4xx_hal.h"
 
 /*================== Macros and Definitions ===============================*/
 
+/*================== Constant and Variable Definitions ====================*/
+
 /**
- * Saves the last state and the last substate
+ * bitmasks of the cells violating the voltage limits, bit n = cell n
  */
-#define BMS_SAVELASTSTATES()    bms_state.laststate = bms_state.state; \
-                                bms_state.lastsubstate = bms_state.substate;
+static uint32_t bms_cellvoltage_undermask[SOA_MASK_WORDS(BS_NR_OF_BAT_CELLS)];
+static uint32_t bms_cellvoltage_overmask[SOA_MASK_WORDS(BS_NR_OF_BAT_CELLS)];
 
-/*================== Constant and Variable Definitions ====================*/
+/**
+ * bitmasks of the sensors violating the temperature limits, bit n = sensor n
+ */
+static uint32_t bms_celltemperature_undermask[SOA_MASK_WORDS(BS_NR_OF_TEMP_SENSORS)];
+static uint32_t bms_celltemperature_overmask[SOA_MASK_WORDS(BS_NR_OF_TEMP_SENSORS)];
+
+static uint8_t BMS_GuardInitRequest(void);
+static uint8_t BMS_GuardErrorFlagSet(void);
+static uint8_t BMS_GuardErrorFlagsCleared(void);
+static void BMS_ActionCloseInterlock(void);
+static void BMS_ActionOpenInterlock(void);
+
+/**
+ * transition table of the BMS state machine, rows of a state are evaluated in order
+ */
+static const SM_TRANSITION_s bms_transitions[] = {
+    /* state                            substate                            guard                       action                      next state                      next substate                       timer */
+    {BMS_STATEMACH_UNINITIALIZED,       SM_SUBSTATE_ANY,                    BMS_GuardInitRequest,       NULL_PTR,                   BMS_STATEMACH_INITIALIZATION,   BMS_ENTRY,                          BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_INITIALIZATION,      SM_SUBSTATE_ANY,                    NULL_PTR,                   NULL_PTR,                   BMS_STATEMACH_INITIALIZED,      BMS_ENTRY,                          BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_INITIALIZED,         SM_SUBSTATE_ANY,                    NULL_PTR,                   NULL_PTR,                   BMS_STATEMACH_STANDBY,          BMS_ENTRY,                          BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_STANDBY,             BMS_ENTRY,                          NULL_PTR,                   BMS_ActionCloseInterlock,   BMS_STATEMACH_STANDBY,          BMS_CHECK_ERROR_FLAGS_INTERLOCK,    BMS_STATEMACH_MEDIUMTIME_MS},
+    {BMS_STATEMACH_STANDBY,             BMS_CHECK_ERROR_FLAGS_INTERLOCK,    BMS_GuardErrorFlagSet,      NULL_PTR,                   BMS_STATEMACH_ERROR,            BMS_ENTRY,                          BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_STANDBY,             BMS_CHECK_ERROR_FLAGS_INTERLOCK,    NULL_PTR,                   NULL_PTR,                   BMS_STATEMACH_STANDBY,          BMS_INTERLOCK_CHECKED,              BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_STANDBY,             BMS_INTERLOCK_CHECKED,              NULL_PTR,                   NULL_PTR,                   BMS_STATEMACH_STANDBY,          BMS_CHECK_ERROR_FLAGS,              BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_STANDBY,             BMS_CHECK_ERROR_FLAGS,              BMS_GuardErrorFlagSet,      NULL_PTR,                   BMS_STATEMACH_ERROR,            BMS_ENTRY,                          BMS_STATEMACH_SHORTTIME_MS},
+    {BMS_STATEMACH_ERROR,               BMS_ENTRY,                          NULL_PTR,                   BMS_ActionOpenInterlock,    BMS_STATEMACH_ERROR,            BMS_CHECK_ERROR_FLAGS,              BMS_STATEMACH_MEDIUMTIME_MS},
+    {BMS_STATEMACH_ERROR,               BMS_CHECK_ERROR_FLAGS,              BMS_GuardErrorFlagsCleared, BMS_ActionCloseInterlock,   BMS_STATEMACH_STANDBY,          BMS_ENTRY,                          BMS_STATEMACH_MEDIUMTIME_MS},
+};
+
+/**
+ * states of the BMS state machine with statistics
+ */
+static const uint8_t bms_states[] = {
+    BMS_STATEMACH_UNINITIALIZED,
+    BMS_STATEMACH_INITIALIZATION,
+    BMS_STATEMACH_INITIALIZED,
+    BMS_STATEMACH_STANDBY,
+    BMS_STATEMACH_ERROR,
+};
+
+/**
+ * statistics of the states in bms_states
+ */
+static SM_STATS_s bms_stats[sizeof(bms_states)];
 
 /**
  * contains the state of the contactor state machine
  */
 static BMS_STATE_s bms_state = {
-    .timer                  = 0,
+    .sm                     = SM_INSTANCE_INIT(bms_transitions, bms_states, bms_stats, BMS_STATEMACH_UNINITIALIZED, BMS_ENTRY),
     .statereq               = BMS_STATE_NO_REQUEST,
-    .state                  = BMS_STATEMACH_UNINITIALIZED,
-    .substate               = BMS_ENTRY,
-    .laststate              = BMS_STATEMACH_UNINITIALIZED,
-    .lastsubstate           = 0,
-    .triggerentry           = 0,
     .ErrRequestCounter      = 0,
     .counter                = 0,
 };
 
+/**
+ * dynamic current limits of the derating tables, updated by BMS_CheckCurrent()
+ */
+#if BMS_TEST_CELL_SOF_LIMITS == TRUE
+static SOA_CURRENT_LIMITS_s bms_current_limits = {
+    .discharge_mA   = BC_CURRENTMAX_DISCHARGE,
+    .charge_mA      = BC_CURRENTMAX_CHARGE,
+};
+#endif
+
+/**
+ * pending events of BMS_NotifyEvent()
+ */
+static volatile uint8_t bms_events = 0;
+
+/**
+ * measurement data of the checks, read once per call of BMS_Trigger()
+ */
+static DATA_BLOCK_CELLVOLTAGE_s bms_cellvoltage;
+static DATA_BLOCK_CELLTEMPERATURE_s bms_celltemperature;
+static DATA_BLOCK_CURRENT_s bms_current;
+
+/**
+ * timestamps of the last checks and of the last current sample
+ */
+static uint32_t bms_lastcheck_voltage = 0;
+static uint32_t bms_lastcheck_temperature = 0;
+static uint32_t bms_lastcheck_current = 0;
+
+#if BMS_EVENT_DRIVEN_TRIGGER == TRUE
+/**
+ * database timestamps of the data checked last, a different timestamp marks new data
+ */
+static uint32_t bms_checked_voltage_timestamp = 0;
+static uint32_t bms_checked_temperature_timestamp = 0;
+static uint32_t bms_checked_current_timestamp = 0;
+#endif
+
+#if BMS_LOAD_MEASUREMENT == TRUE
+/**
+ * CPU load of the last complete and of the running measurement window
+ */
+static BMS_LOAD_s bms_load;
+static BMS_LOAD_s bms_load_running;
+static uint32_t bms_load_window_start = 0;
+#endif
+
 /*================== Function Prototypes ==================================*/
 
 static BMS_RETURN_TYPE_e BMS_CheckStateRequest(BMS_STATE_REQUEST_e statereq);
 static BMS_STATE_REQUEST_e BMS_TransferStateRequest(void);
-static uint8_t BMS_CheckReEntrance(void);
 static STD_RETURN_TYPE_e BMS_CheckAnyErrorFlagSet(void);
-static void BMS_CheckVoltages(void);
-static void BMS_CheckTemperatures(void);
-static void BMS_CheckCurrent(void);
+static void BMS_CheckVoltages(const DATA_BLOCK_CELLVOLTAGE_s *cellvoltage);
+static void BMS_CheckTemperatures(const DATA_BLOCK_CELLTEMPERATURE_s *celltemperature, const DATA_BLOCK_CURRENT_s *curr_tab);
+static void BMS_CheckCurrent(const DATA_BLOCK_CURRENT_s *curr_tab);
+static void BMS_Process(void);
+static uint8_t BMS_TakeEvents(void);
+static void BMS_RunChecks(uint32_t timestamp);
+#if BMS_LOAD_MEASUREMENT == TRUE
+static void BMS_UpdateLoad(uint32_t cycles, uint32_t timestamp);
+#endif
 
 /*================== Function Implementations =============================*/
 
-/**
- * @brief   re-entrance check of SYS state machine trigger function
- *
- * @details This function is not re-entrant and should only be called time- or event-triggered. It
- *          increments the triggerentry counter from the state variable ltc_state. It should never
- *          be called by two different processes, so if it is the case, triggerentry should never
- *          be higher than 0 when this function is called.
- *
- * @return  retval  0 if no further instance of the function is active, 0xff else
- */
-static uint8_t BMS_CheckReEntrance(void) {
-    uint8_t retval = 0;
-    OS_TaskEnter_Critical();
-    if (!bms_state.triggerentry) {
-        bms_state.triggerentry++;
-    } else {
-        retval = 0xFF;  // multiple calls of function
-    }
-    OS_TaskExit_Critical();
-    return (retval);
+BMS_STATEMACH_e BMS_GetState(void) {
+    return ((BMS_STATEMACH_e)bms_state.sm.state);
 }
 
 
-BMS_STATEMACH_e BMS_GetState(void) {
-    return (bms_state.state);
+const SM_INSTANCE_s *BMS_GetStateMachine(void) {
+    return (&bms_state.sm);
 }
 
 /**
@@ -156,7 +235,7 @@ static BMS_RETURN_TYPE_e BMS_CheckStateRequest(BMS_STATE_REQUEST_e statereq) {
     if (bms_state.statereq == BMS_STATE_NO_REQUEST) {
         // init only allowed from the uninitialized state
         if (statereq == BMS_STATE_INIT_REQUEST) {
-            if (bms_state.state == BMS_STATEMACH_UNINITIALIZED) {
+            if (bms_state.sm.state == BMS_STATEMACH_UNINITIALIZED) {
                 return BMS_OK;
             } else {
                 return BMS_ALREADY_INITIALIZED;
@@ -170,159 +249,276 @@ static BMS_RETURN_TYPE_e BMS_CheckStateRequest(BMS_STATE_REQUEST_e statereq) {
 }
 
 void BMS_Trigger(void) {
-    BMS_STATE_REQUEST_e statereq = BMS_STATE_NO_REQUEST;
+#if BMS_LOAD_MEASUREMENT == TRUE
+    uint32_t cycles = 0;
+
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    cycles = DWT->CYCCNT;
+    BMS_Process();
+    BMS_UpdateLoad(DWT->CYCCNT - cycles, MCU_GetTimeStamp());
+#else
+    BMS_Process();
+#endif
+}
+
+
+void BMS_NotifyEvent(BMS_EVENT_e event) {
+    OS_TaskEnter_Critical();
+    bms_events |= (uint8_t)event;
+    OS_TaskExit_Critical();
+}
+
+
+void BMS_GetLoad(BMS_LOAD_s *load) {
+#if BMS_LOAD_MEASUREMENT == TRUE
+    OS_TaskEnter_Critical();
+    *load = bms_load;
+    OS_TaskExit_Critical();
+#else
+    load->cycles_max = 0;
+    load->cycles_sum = 0;
+    load->load_ppm = 0;
+    load->calls = 0;
+    load->checks = 0;
+    load->statemachine_runs = 0;
+#endif
+}
+
+
+/**
+ * @brief   checks and state machine, called by BMS_Trigger()
+ */
+static void BMS_Process(void) {
+    uint32_t timestamp = MCU_GetTimeStamp();
+    uint8_t events = BMS_TakeEvents();
 
     DIAG_SysMonNotify(DIAG_SYSMON_BMS_ID, 0);  // task is running, state = ok
 
-    if (bms_state.state != BMS_STATEMACH_UNINITIALIZED) {
-        BMS_CheckVoltages();
-        BMS_CheckTemperatures();
-        BMS_CheckCurrent();
+    if (bms_state.sm.state != BMS_STATEMACH_UNINITIALIZED) {
+        BMS_RunChecks(timestamp);
     }
-    // Check re-entrance of function
-    if (BMS_CheckReEntrance()) {
-        return;
+
+#if BMS_EVENT_DRIVEN_TRIGGER == TRUE
+    // error flags changed by the checks of this call are taken into account
+    events |= BMS_TakeEvents();
+
+    if ((bms_state.sm.timer == 0) && ((events & BMS_EVENT_ERRORFLAG) == 0) &&
+            (bms_state.statereq == BMS_STATE_NO_REQUEST) &&
+            ((timestamp - bms_state.sm.lastrun) < BMS_EVENT_CHECK_TIMEOUT_MS)) {
+        return;    // waiting state without event
     }
+#endif
 
-    if (bms_state.timer) {
-        if (--bms_state.timer) {
-            bms_state.triggerentry--;
-            return;    // handle state machine only if timer has elapsed
-        }
+    if (SM_Trigger(&bms_state.sm, timestamp) == TRUE) {
+        bms_state.counter++;
+#if BMS_LOAD_MEASUREMENT == TRUE
+        bms_load_running.statemachine_runs++;
+#endif
     }
+}
 
-    /****Happens every time the state machine is triggered**************/
-    switch (bms_state.state) {
-        /****************************UNINITIALIZED***********************************/
-        case BMS_STATEMACH_UNINITIALIZED:
-            // waiting for Initialization Request
-            statereq = BMS_TransferStateRequest();
-            if (statereq == BMS_STATE_INIT_REQUEST) {
-                BMS_SAVELASTSTATES();
-                bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-                bms_state.state = BMS_STATEMACH_INITIALIZATION;
-                bms_state.substate = BMS_ENTRY;
-            } else if (statereq == BMS_STATE_NO_REQUEST) {
-                // no actual request pending //
-            } else {
-                bms_state.ErrRequestCounter++;  // illegal request pending
-            }
-            break;
+/*================== Static functions =====================================*/
 
+/**
+ * @brief   guard: initialization requested
+ *
+ * @details Takes the pending state request, illegal requests are counted.
+ *
+ * @return  TRUE if the initialization has been requested
+ */
+static uint8_t BMS_GuardInitRequest(void) {
+    BMS_STATE_REQUEST_e statereq = BMS_TransferStateRequest();
 
-        /****************************INITIALIZATION**********************************/
-        case BMS_STATEMACH_INITIALIZATION:
-            BMS_SAVELASTSTATES();
-            // CONT_SetStateRequest(CONT_STATE_INIT_REQUEST);
+    if (statereq == BMS_STATE_INIT_REQUEST) {
+        return TRUE;
+    } else if (statereq != BMS_STATE_NO_REQUEST) {
+        bms_state.ErrRequestCounter++;  // illegal request pending
+    }
+    return FALSE;
+}
 
-            bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-            bms_state.state = BMS_STATEMACH_INITIALIZED;
-            bms_state.substate = BMS_ENTRY;
 
-            break;
+/**
+ * @brief   guard: any error flag set
+ *
+ * @return  TRUE if an error flag is set
+ */
+static uint8_t BMS_GuardErrorFlagSet(void) {
+    if (BMS_CheckAnyErrorFlagSet() == E_NOT_OK) {
+        LAT_Mark(LAT_STAGE_STATE);
+        return TRUE;
+    }
+    return FALSE;
+}
 
-        /****************************INITIALIZED*************************************/
-        case BMS_STATEMACH_INITIALIZED:
-            BMS_SAVELASTSTATES();
-            bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-            bms_state.state = BMS_STATEMACH_STANDBY;
-            bms_state.substate = BMS_ENTRY;
-            break;
 
+/**
+ * @brief   guard: leaving the error state allowed
+ *
+ * @return  TRUE if no error flag is set and SECONDARY_OUT_OF_ERROR_STATE is enabled
+ */
+static uint8_t BMS_GuardErrorFlagsCleared(void) {
+    if (SECONDARY_OUT_OF_ERROR_STATE == TRUE) {
+        return (BMS_CheckAnyErrorFlagSet() == E_OK) ? TRUE : FALSE;
+    }
+    return FALSE;
+}
 
-        /****************************STANDBY*************************************/
-        case BMS_STATEMACH_STANDBY:
-            BMS_SAVELASTSTATES();
 
-            if (bms_state.substate == BMS_ENTRY){
-                ILCK_SetStateRequest(ILCK_STATE_CLOSE_REQUEST);
-                bms_state.timer = BMS_STATEMACH_MEDIUMTIME_MS;
-                bms_state.substate = BMS_CHECK_ERROR_FLAGS_INTERLOCK;
-                break;
-            }
+/**
+ * @brief   action: requests to close the interlock
+ */
+static void BMS_ActionCloseInterlock(void) {
+    ILCK_SetStateRequest(ILCK_STATE_CLOSE_REQUEST);
+}
 
-            else if (bms_state.substate == BMS_CHECK_ERROR_FLAGS_INTERLOCK){
-                if (BMS_CheckAnyErrorFlagSet() == E_NOT_OK){
-                    bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-                    bms_state.state = BMS_STATEMACH_ERROR;
-                    bms_state.substate = BMS_ENTRY;
-                    break;
-                }
-                else{
-                    bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-                    bms_state.substate = BMS_INTERLOCK_CHECKED;
-                    break;
-                }
-            }
-            else if (bms_state.substate == BMS_INTERLOCK_CHECKED){
-                bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-                bms_state.substate = BMS_CHECK_ERROR_FLAGS;
-                break;
-            }
-            else if (bms_state.substate == BMS_CHECK_ERROR_FLAGS){
-                if (BMS_CheckAnyErrorFlagSet() == E_NOT_OK){
-                    bms_state.timer = BMS_STATEMACH_SHORTTIME_MS;
-                    bms_state.state = BMS_STATEMACH_ERROR;
-                    bms_state.substate = BMS_ENTRY;
-                    break;
-                }
-            }
-            break;
 
-        /****************************ERROR*************************************/
-        case BMS_STATEMACH_ERROR:
-            BMS_SAVELASTSTATES();
+/**
+ * @brief   action: requests to open the interlock, then a fast trip may be re-armed
+ */
+static void BMS_ActionOpenInterlock(void) {
+    ILCK_SetStateRequest(ILCK_STATE_OPEN_REQUEST);
+    LAT_Mark(LAT_STAGE_REQUEST);
+    FTRIP_Rearm();
+}
+
 
-            if (bms_state.substate == BMS_ENTRY){
-                ILCK_SetStateRequest(ILCK_STATE_OPEN_REQUEST);
-                bms_state.timer = BMS_STATEMACH_MEDIUMTIME_MS;
-                bms_state.substate = BMS_CHECK_ERROR_FLAGS;
-                break;
-            }
-            else if (bms_state.substate == BMS_CHECK_ERROR_FLAGS){
-                if (BMS_CheckAnyErrorFlagSet() == E_NOT_OK){
-                    // we stay already in requested state, nothing to do
-                }
-                else {
-                    if (SECONDARY_OUT_OF_ERROR_STATE == TRUE) {
-                        ILCK_SetStateRequest(ILCK_STATE_CLOSE_REQUEST);
-                        bms_state.timer = BMS_STATEMACH_MEDIUMTIME_MS;
-                        bms_state.substate = BMS_CHECK_INTERLOCK_CLOSE_AFTER_ERROR;
-                        bms_state.state = BMS_STATEMACH_STANDBY;
-                        bms_state.substate = BMS_ENTRY;
-                    }
-                    break;
-                }
-            }
-            break;
-        default:
-            break;
-    }  // end switch(bms_state.state)
+/**
+ * @brief   returns and clears the pending events
+ *
+ * @return  pending events, bits of BMS_EVENT_e
+ */
+static uint8_t BMS_TakeEvents(void) {
+    uint8_t events = 0;
 
-    bms_state.triggerentry--;
-    bms_state.counter++;
+    OS_TaskEnter_Critical();
+    events = bms_events;
+    bms_events = 0;
+    OS_TaskExit_Critical();
+    return events;
 }
 
-/*================== Static functions =====================================*/
+
+/**
+ * @brief   runs the safe operating area checks
+ *
+ * @details The measurement blocks are read once per call. In cyclic mode all checks run on
+ *          every call. In event-driven mode a check runs if the database timestamp of its
+ *          data has changed (new measurement) or if it has not run for
+ *          BMS_EVENT_CHECK_TIMEOUT_MS.
+ *
+ * @param   timestamp:  actual time in ms
+ */
+static void BMS_RunChecks(uint32_t timestamp) {
+    DB_ReadBlock(&bms_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+    DB_ReadBlock(&bms_celltemperature, DATA_BLOCK_ID_CELLTEMPERATURE);
+    DB_ReadBlock(&bms_current, DATA_BLOCK_ID_CURRENT);
+
+#if BMS_EVENT_DRIVEN_TRIGGER == TRUE
+    if ((bms_cellvoltage.timestamp != bms_checked_voltage_timestamp) ||
+            ((timestamp - bms_lastcheck_voltage) >= BMS_EVENT_CHECK_TIMEOUT_MS)) {
+        bms_checked_voltage_timestamp = bms_cellvoltage.timestamp;
+        bms_lastcheck_voltage = timestamp;
+        BMS_CheckVoltages(&bms_cellvoltage);
+#if BMS_LOAD_MEASUREMENT == TRUE
+        bms_load_running.checks++;
+#endif
+    }
+    /* the temperature limits depend on the current direction */
+    if ((bms_celltemperature.timestamp != bms_checked_temperature_timestamp) ||
+            (bms_current.timestamp != bms_checked_current_timestamp) ||
+            ((timestamp - bms_lastcheck_temperature) >= BMS_EVENT_CHECK_TIMEOUT_MS)) {
+        bms_checked_temperature_timestamp = bms_celltemperature.timestamp;
+        bms_lastcheck_temperature = timestamp;
+        BMS_CheckTemperatures(&bms_celltemperature, &bms_current);
+#if BMS_LOAD_MEASUREMENT == TRUE
+        bms_load_running.checks++;
+#endif
+    }
+    if ((bms_current.timestamp != bms_checked_current_timestamp) ||
+            ((timestamp - bms_lastcheck_current) >= BMS_EVENT_CHECK_TIMEOUT_MS)) {
+        bms_checked_current_timestamp = bms_current.timestamp;
+        BMS_CheckCurrent(&bms_current);
+#if BMS_LOAD_MEASUREMENT == TRUE
+        bms_load_running.checks++;
+#endif
+    }
+#else
+    BMS_CheckVoltages(&bms_cellvoltage);
+    BMS_CheckTemperatures(&bms_celltemperature, &bms_current);
+    BMS_CheckCurrent(&bms_current);
+#if BMS_LOAD_MEASUREMENT == TRUE
+    bms_load_running.checks += 3;
+#endif
+#endif
+}
+
+
+#if BMS_LOAD_MEASUREMENT == TRUE
+/**
+ * @brief   accumulates the CPU cycles of BMS_Trigger() and closes the measurement window
+ *
+ * @param   cycles:     CPU cycles of the call
+ * @param   timestamp:  actual time in ms
+ */
+static void BMS_UpdateLoad(uint32_t cycles, uint32_t timestamp) {
+    uint32_t window = timestamp - bms_load_window_start;
+
+    bms_load_running.calls++;
+    bms_load_running.cycles_sum += cycles;
+    if (cycles > bms_load_running.cycles_max) {
+        bms_load_running.cycles_max = cycles;
+    }
+
+    if (window >= BMS_LOAD_WINDOW_MS) {
+        /* cycles_sum / (SystemCoreClock * window / 1000), in ppm */
+        bms_load_running.load_ppm = (uint32_t)(((uint64_t)bms_load_running.cycles_sum * 1000000000ULL) /
+                                               ((uint64_t)SystemCoreClock * window));
+        OS_TaskEnter_Critical();
+        bms_load = bms_load_running;
+        OS_TaskExit_Critical();
+        bms_load_running.calls = 0;
+        bms_load_running.cycles_sum = 0;
+        bms_load_running.cycles_max = 0;
+        bms_load_running.checks = 0;
+        bms_load_running.statemachine_runs = 0;
+        bms_load_window_start = timestamp;
+    }
+}
+#endif
+
 
 
 /**
  * @brief   checks the abidance by the safe operating area
  *
- * @details verify for cell voltage measurements (U), if minimum and maximum values are out of range
+ * @details verify for cell voltage measurements (U), if minimum and maximum values are out of range.
+ *          Besides the min/max values, every single cell is checked so that a violation is
+ *          detected even if the received MINMAX data is stale or wrong.
+ *
+ * @param   cellvoltage:    cell voltages
  */
-static void BMS_CheckVoltages(void) {
+static void BMS_CheckVoltages(const DATA_BLOCK_CELLVOLTAGE_s *cellvoltage) {
     DATA_BLOCK_MINMAX_s minmax;
+    uint8_t violation = 0;
 
     DB_ReadBlock(&minmax, DATA_BLOCK_ID_MINMAX);
 
-    if (minmax.voltage_max > BC_VOLTMAX) {
+    violation = SOA_CheckVoltages(cellvoltage->voltage, BS_NR_OF_BAT_CELLS, BC_VOLTMIN, BC_VOLTMAX,
+                                  bms_cellvoltage_undermask, bms_cellvoltage_overmask);
+
+    if ((minmax.voltage_max > BC_VOLTMAX) || ((violation & SOA_VIOLATION_OVER) != 0)) {
+        LAT_MarkSample(DIAG_CH_CELLVOLTAGE_OVERVOLTAGE, cellvoltage->timestamp);
         DIAG_Handler(DIAG_CH_CELLVOLTAGE_OVERVOLTAGE, DIAG_EVENT_NOK, 0, NULL_PTR);
     } else {
         DIAG_Handler(DIAG_CH_CELLVOLTAGE_OVERVOLTAGE, DIAG_EVENT_OK, 0, NULL_PTR);
     }
 
-    if (minmax.voltage_min < BC_VOLTMIN) {
+    if ((minmax.voltage_min < BC_VOLTMIN) || ((violation & SOA_VIOLATION_UNDER) != 0)) {
+        LAT_MarkSample(DIAG_CH_CELLVOLTAGE_UNDERVOLTAGE, cellvoltage->timestamp);
         DIAG_Handler(DIAG_CH_CELLVOLTAGE_UNDERVOLTAGE, DIAG_EVENT_NOK, 0, NULL_PTR);
     } else {
         DIAG_Handler(DIAG_CH_CELLVOLTAGE_UNDERVOLTAGE, DIAG_EVENT_OK, 0, NULL_PTR);
@@ -333,37 +529,55 @@ static void BMS_CheckVoltages(void) {
 /**
  * @brief   checks the abidance by the safe operating area
  *
- * @details verify for cell temperature measurements (T), if minimum and maximum values are out of range
+ * @details verify for cell temperature measurements (T), if minimum and maximum values are out of range.
+ *          Besides the min/max values, every single sensor is checked against the limits
+ *          of the current direction.
+ *
+ * @param   celltemperature:    cell temperatures
+ * @param   curr_tab:           current, selects the charge or discharge limits
  */
-static void BMS_CheckTemperatures(void) {
+static void BMS_CheckTemperatures(const DATA_BLOCK_CELLTEMPERATURE_s *celltemperature, const DATA_BLOCK_CURRENT_s *curr_tab) {
     DATA_BLOCK_MINMAX_s minmax;
-    DATA_BLOCK_CURRENT_s curr_tab;
+    uint8_t violation = 0;
 
-    DB_ReadBlock(&curr_tab, DATA_BLOCK_ID_CURRENT);
     DB_ReadBlock(&minmax, DATA_BLOCK_ID_MINMAX);
 
-    if(curr_tab.current>=0.0){
-        if (minmax.temperature_max > BC_TEMPMAX_DISCHARGE) {
+    if (curr_tab->current >= 0.0) {
+        violation = SOA_CheckTemperatures(celltemperature->temperature, BS_NR_OF_TEMP_SENSORS,
+                                          BC_TEMPMIN_DISCHARGE, BC_TEMPMAX_DISCHARGE,
+                                          bms_celltemperature_undermask, bms_celltemperature_overmask);
+    } else {
+        violation = SOA_CheckTemperatures(celltemperature->temperature, BS_NR_OF_TEMP_SENSORS,
+                                          BC_TEMPMIN_CHARGE, BC_TEMPMAX_CHARGE,
+                                          bms_celltemperature_undermask, bms_celltemperature_overmask);
+    }
+
+    if(curr_tab->current>=0.0){
+        if ((minmax.temperature_max > BC_TEMPMAX_DISCHARGE) || ((violation & SOA_VIOLATION_OVER) != 0)) {
+            LAT_MarkSample(DIAG_CH_TEMP_OVERTEMPERATURE_DISCHARGE, celltemperature->timestamp);
             DIAG_Handler(DIAG_CH_TEMP_OVERTEMPERATURE_DISCHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
         } else{
             DIAG_Handler(DIAG_CH_TEMP_OVERTEMPERATURE_DISCHARGE,DIAG_EVENT_OK,0, NULL_PTR);
         }
     } else{
-        if (minmax.temperature_max > BC_TEMPMAX_CHARGE) {
+        if ((minmax.temperature_max > BC_TEMPMAX_CHARGE) || ((violation & SOA_VIOLATION_OVER) != 0)) {
+            LAT_MarkSample(DIAG_CH_TEMP_OVERTEMPERATURE_CHARGE, celltemperature->timestamp);
             DIAG_Handler(DIAG_CH_TEMP_OVERTEMPERATURE_CHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
         } else{
             DIAG_Handler(DIAG_CH_TEMP_OVERTEMPERATURE_CHARGE,DIAG_EVENT_OK,0, NULL_PTR);
         }
     }
 
-    if(curr_tab.current>=0.0){
-        if (minmax.temperature_min < BC_TEMPMIN_DISCHARGE) {
+    if(curr_tab->current>=0.0){
+        if ((minmax.temperature_min < BC_TEMPMIN_DISCHARGE) || ((violation & SOA_VIOLATION_UNDER) != 0)) {
+            LAT_MarkSample(DIAG_CH_TEMP_UNDERTEMPERATURE_DISCHARGE, celltemperature->timestamp);
             DIAG_Handler(DIAG_CH_TEMP_UNDERTEMPERATURE_DISCHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
         } else{
             DIAG_Handler(DIAG_CH_TEMP_UNDERTEMPERATURE_DISCHARGE,DIAG_EVENT_OK,0, NULL_PTR);
         }
     } else{
-        if (minmax.temperature_min < BC_TEMPMIN_CHARGE) {
+        if ((minmax.temperature_min < BC_TEMPMIN_CHARGE) || ((violation & SOA_VIOLATION_UNDER) != 0)) {
+            LAT_MarkSample(DIAG_CH_TEMP_UNDERTEMPERATURE_CHARGE, celltemperature->timestamp);
             DIAG_Handler(DIAG_CH_TEMP_UNDERTEMPERATURE_CHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
         } else{
             DIAG_Handler(DIAG_CH_TEMP_UNDERTEMPERATURE_CHARGE,DIAG_EVENT_OK,0, NULL_PTR);
@@ -378,37 +592,48 @@ static void BMS_CheckTemperatures(void) {
 /**
  * @brief   checks the abidance by the safe operating area
  *
- * @details verify for cell current measurements (I), if minimum and maximum values are out of range
+ * @details verify for cell current measurements (I), if minimum and maximum values are out of range.
+ *          Besides the flat limits, the I2t curves of the SOA module catch sustained overloads
+ *          below the maximum current. Both directions are evaluated every call so that a charge
+ *          I2t violation is also reported (and released) while discharging and vice versa.
+ *
+ * @param   curr_tab:   current
  */
-static void BMS_CheckCurrent(void) {
+static void BMS_CheckCurrent(const DATA_BLOCK_CURRENT_s *curr_tab) {
+#if BMS_TEST_CELL_SOF_LIMITS == TRUE
     DATA_BLOCK_SOX_s sof_tab;
-    DATA_BLOCK_CURRENT_s curr_tab;
+    DATA_BLOCK_MINMAX_s minmax_tab;
+#endif
+    uint32_t timestamp = MCU_GetTimeStamp();
+    uint32_t limit_charge = BC_CURRENTMAX_CHARGE;
+    uint32_t limit_discharge = BC_CURRENTMAX_DISCHARGE;
+    uint8_t i2t = 0;
 
+#if BMS_TEST_CELL_SOF_LIMITS == TRUE
     DB_ReadBlock(&sof_tab, DATA_BLOCK_ID_SOX);
-    DB_ReadBlock(&curr_tab, DATA_BLOCK_ID_CURRENT);
+    DB_ReadBlock(&minmax_tab, DATA_BLOCK_ID_MINMAX_SECONDARY);
 
-#if MEAS_TEST_CELL_SOF_LIMITS == TRUE
-    if (((curr_tab.current < (-1000*(sof_tab.sof_continuous_charge))) ||
-            (curr_tab.current > (1000*sof_tab.sof_continuous_discharge)))) {
-        retVal = FALSE;
-    }
+    SOA_CalcCurrentLimits(&minmax_tab, &sof_tab, &bms_current_limits);
+    limit_charge = bms_current_limits.charge_mA;
+    limit_discharge = bms_current_limits.discharge_mA;
 #endif
 
-    if(curr_tab.current<0.0){
-        if (-curr_tab.current > BC_CURRENTMAX_CHARGE) {
-            DIAG_Handler(DIAG_CH_OVERCURRENT_CHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
-        } else{
-            DIAG_Handler(DIAG_CH_OVERCURRENT_CHARGE,DIAG_EVENT_OK,0, NULL_PTR);
-        }
-    }
-    else{
-        if (curr_tab.current > BC_CURRENTMAX_DISCHARGE) {
-            DIAG_Handler(DIAG_CH_OVERCURRENT_DISCHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
-        } else{
-            DIAG_Handler(DIAG_CH_OVERCURRENT_DISCHARGE,DIAG_EVENT_OK,0, NULL_PTR);
-        }
+    i2t = SOA_I2tUpdate(curr_tab->current, timestamp - bms_lastcheck_current);
+    bms_lastcheck_current = timestamp;
+
+    if (((curr_tab->current < 0.0) && (-curr_tab->current > limit_charge)) || ((i2t & SOA_I2T_CHARGE) != 0)) {
+        LAT_MarkSample(DIAG_CH_OVERCURRENT_CHARGE, curr_tab->timestamp);
+        DIAG_Handler(DIAG_CH_OVERCURRENT_CHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
+    } else{
+        DIAG_Handler(DIAG_CH_OVERCURRENT_CHARGE,DIAG_EVENT_OK,0, NULL_PTR);
     }
 
+    if (((curr_tab->current >= 0.0) && (curr_tab->current > limit_discharge)) || ((i2t & SOA_I2T_DISCHARGE) != 0)) {
+        LAT_MarkSample(DIAG_CH_OVERCURRENT_DISCHARGE, curr_tab->timestamp);
+        DIAG_Handler(DIAG_CH_OVERCURRENT_DISCHARGE,DIAG_EVENT_NOK,0, NULL_PTR);
+    } else{
+        DIAG_Handler(DIAG_CH_OVERCURRENT_DISCHARGE,DIAG_EVENT_OK,0, NULL_PTR);
+    }
 }
 
 /**
@@ -441,7 +666,11 @@ static STD_RETURN_TYPE_e BMS_CheckAnyErrorFlagSet(void) {
         error_flags.spi_error                   == 1 ||
         error_flags.currentsensorresponding     == 1 ||
         error_flags.can_timing_cc               == 1 ||
-        error_flags.can_timing                  == 1 ) {
+        error_flags.can_timing                  == 1 ||
+        error_flags.minmax_plausibility         == 1 ||
+        error_flags.voltage_sum_plausibility    == 1 ||
+        error_flags.temperature_gradient        == 1 ||
+        error_flags.fast_trip                   == 1 ) {
         retVal = E_NOT_OK;
     }
     else{
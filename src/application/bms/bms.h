@@ -37,6 +37,7 @@
 
 /*================== Includes =============================================*/
 #include "bms_cfg.h"
+#include "sm.h"
 
 
 /*================== Macros and Definitions ===============================*/
@@ -146,21 +147,36 @@ typedef enum {
 
 
 /**
- * This structure contains all the variables relevant for the CONT state machine.
- * The user can get the current state of the CONT state machine with this variable
+ * This structure contains all the variables relevant for the BMS state machine.
+ * State, substate, timer and re-entrance protection are handled by the state machine engine.
  */
 typedef struct {
-    uint16_t timer;                         /*!< time in ms before the state machine processes the next state, e.g. in counts of 1ms    */
+    SM_INSTANCE_s sm;                       /*!< state machine, see bms_transitions                                                     */
     BMS_STATE_REQUEST_e statereq;           /*!< current state request made to the state machine                                        */
-    BMS_STATEMACH_e state;                  /*!< state of Driver State Machine                                                          */
-    BMS_STATEMACH_SUB_e substate;           /*!< current substate of the state machine                                                  */
-    BMS_STATEMACH_e laststate;              /*!< previous state of the state machine                                                    */
-    BMS_STATEMACH_SUB_e lastsubstate;       /*!< previous substate of the state machine                                                 */
     uint32_t ErrRequestCounter;             /*!< counts the number of illegal requests to the LTC state machine */
-    uint8_t triggerentry;                   /*!< counter for re-entrance protection (function running flag) */
     uint8_t counter;                        /*!< general purpose counter*/
 } BMS_STATE_s;
 
+/**
+ * events that start the state machine in event-driven mode, new measurement data is
+ * detected by the database timestamps
+ */
+typedef enum {
+    BMS_EVENT_ERRORFLAG             = 0x08,     /*!< an error flag may have changed         */
+} BMS_EVENT_e;
+
+/**
+ * CPU load of BMS_Trigger(), values of the last complete measurement window
+ */
+typedef struct {
+    uint32_t cycles_max;            /*!< maximum CPU cycles of one call             */
+    uint32_t cycles_sum;            /*!< CPU cycles of all calls                    */
+    uint32_t load_ppm;              /*!< CPU load in parts per million              */
+    uint16_t calls;                 /*!< number of calls                            */
+    uint16_t checks;                /*!< number of executed checks                  */
+    uint16_t statemachine_runs;     /*!< number of state machine executions         */
+} BMS_LOAD_s;
+
 
 /*================== Function Prototypes ==================================*/
 /**
@@ -191,9 +207,39 @@ extern  BMS_STATEMACH_e BMS_GetState(void);
  * @brief   trigger function for the SYS driver state machine.
  *
  * @details This function contains the sequence of events in the SYS state machine. It must be
- *          called time-triggered, every 1ms.
+ *          called time-triggered, every 1ms. With BMS_EVENT_DRIVEN_TRIGGER, most calls return
+ *          after checking the pending events and the timer.
  */
 extern void BMS_Trigger(void);
 
+/**
+ * @brief   notifies an event to BMS_Trigger()
+ *
+ * @details Used in event-driven mode (BMS_EVENT_DRIVEN_TRIGGER). The error flag events are
+ *          notified by the handler of EVT_DIAG_ERROR_SET/EVT_DIAG_ERROR_RESET (evt_cfg.c).
+ *          Must not be called from an interrupt.
+ *
+ * @param   event   event, taken from BMS_EVENT_e
+ */
+extern void BMS_NotifyEvent(BMS_EVENT_e event);
+
+/**
+ * @brief   returns the CPU load of BMS_Trigger() of the last complete measurement window
+ *
+ * @details All values are 0 without BMS_LOAD_MEASUREMENT. Comparing the values with
+ *          BMS_EVENT_DRIVEN_TRIGGER set to TRUE and FALSE gives the savings of the
+ *          event-driven mode.
+ *
+ * @param   load    pointer where the values are copied to
+ */
+extern void BMS_GetLoad(BMS_LOAD_s *load);
+
+/**
+ * @brief   returns the BMS state machine, e.g. for SM_GetStatistics()
+ *
+ * @return  pointer to the state machine
+ */
+extern const SM_INSTANCE_s *BMS_GetStateMachine(void);
+
 
 #endif /* BMS_H_ */
@@ -0,0 +1,382 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    cellstat.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  CELLSTAT
+ *
+ * @brief   Streaming statistics of the cell measurements
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "cellstat.h"
+
+#include "database.h"
+#include "diag.h"
+#include "latency.h"
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * sums over a set of cell voltages
+ */
+typedef struct {
+    uint32_t n;         /*!< number of cells                    */
+    uint32_t sum;       /*!< sum of the voltages in mV          */
+    uint64_t sumsq;     /*!< sum of the squared voltages in mV2 */
+} CELLSTAT_SUMS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * local copy of the cell voltages, static because of its size at large pack sizes
+ */
+static DATA_BLOCK_CELLVOLTAGE_s cellstat_cellvoltage;
+
+/**
+ * persistence counters and flags of the outlier detection, one counter per cell
+ */
+static uint8_t cellstat_outlier_cnt[BS_NR_OF_BAT_CELLS];
+static uint32_t cellstat_outlier_mask[CELLSTAT_MASK_WORDS];
+
+static CELLSTAT_VOLTAGE_STATS_s cellstat_voltage_stats;
+
+/**
+ * local copy of the cell temperatures and state of the gradient estimator:
+ * filtered temperature in mK and filtered gradient in mK/min per sensor
+ */
+static DATA_BLOCK_CELLTEMPERATURE_s cellstat_celltemperature;
+static int32_t cellstat_temperature_level[BS_NR_OF_TEMP_SENSORS];
+static int32_t cellstat_temperature_gradient[BS_NR_OF_TEMP_SENSORS];
+static uint8_t cellstat_gradient_started = FALSE;
+
+static CELLSTAT_TEMPERATURE_STATS_s cellstat_temperature_stats;
+
+/*================== Function Prototypes ==================================*/
+
+static void CELLSTAT_UpdateVoltages(void);
+static void CELLSTAT_UpdateGradients(void);
+static uint8_t CELLSTAT_CellValid(uint16_t cell);
+static void CELLSTAT_Moments(const CELLSTAT_SUMS_s *sums, int32_t *mean_uV, uint32_t *sigma_uV);
+static uint32_t CELLSTAT_Sqrt(uint64_t x);
+
+/*================== Function Implementations =============================*/
+
+void CELLSTAT_Trigger(void) {
+    DB_ReadBlock(&cellstat_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+
+    if (cellstat_cellvoltage.timestamp != cellstat_voltage_stats.timestamp) {
+        CELLSTAT_UpdateVoltages();
+    }
+
+    DB_ReadBlock(&cellstat_celltemperature, DATA_BLOCK_ID_CELLTEMPERATURE);
+
+    if (cellstat_celltemperature.timestamp != cellstat_temperature_stats.timestamp) {
+        CELLSTAT_UpdateGradients();
+    }
+}
+
+
+void CELLSTAT_GetVoltageStatistics(CELLSTAT_VOLTAGE_STATS_s *stats) {
+    OS_TaskEnter_Critical();
+    *stats = cellstat_voltage_stats;
+    OS_TaskExit_Critical();
+}
+
+
+uint16_t CELLSTAT_GetVoltageOutliers(uint32_t *mask) {
+    uint16_t retval = 0;
+    uint16_t i = 0;
+
+    OS_TaskEnter_Critical();
+    for (i = 0; i < CELLSTAT_MASK_WORDS; i++) {
+        mask[i] = cellstat_outlier_mask[i];
+    }
+    retval = cellstat_voltage_stats.nr_of_outliers;
+    OS_TaskExit_Critical();
+    return retval;
+}
+
+
+void CELLSTAT_GetTemperatureStatistics(CELLSTAT_TEMPERATURE_STATS_s *stats) {
+    OS_TaskEnter_Critical();
+    *stats = cellstat_temperature_stats;
+    OS_TaskExit_Critical();
+}
+
+
+int32_t CELLSTAT_GetTemperatureGradient(uint16_t sensor) {
+    int32_t retval = 0;
+
+    if (sensor < BS_NR_OF_TEMP_SENSORS) {
+        retval = cellstat_temperature_gradient[sensor];
+    }
+    return retval;
+}
+
+
+/**
+ * @brief   robust statistics and outlier detection over the cell voltages in cellstat_cellvoltage
+ *
+ * @details Passes over the cells, each O(cells) with integer arithmetic only:
+ *          1. mean and standard deviation of all valid cells
+ *          2. CELLSTAT_OUTLIER_CLIP_ITERATIONS times the same over the cells within
+ *             max(CELLSTAT_OUTLIER_CLIP_SIGMA * sigma, CELLSTAT_OUTLIER_MIN_DEVIATION_MV)
+ *             of the previous mean, so a few failing cells do not pull the mean and
+ *             widen the spread
+ *          3. per cell comparison with the robust mean and update of the persistence counter
+ *          Cells with a PEC error keep their counter.
+ */
+static void CELLSTAT_UpdateVoltages(void) {
+    CELLSTAT_SUMS_s all = {0, 0, 0};
+    CELLSTAT_SUMS_s inliers = {0, 0, 0};
+    const uint16_t *voltage = cellstat_cellvoltage.voltage;
+    int32_t mean_uV = 0;
+    uint32_t sigma_uV = 0;
+    int32_t limit_uV = 0;
+    int32_t deviation = 0;
+    uint32_t mask[CELLSTAT_MASK_WORDS] = {0};
+    uint16_t nr_of_outliers = 0;
+    uint16_t i = 0;
+    uint8_t iteration = 0;
+
+    for (i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+        if (CELLSTAT_CellValid(i) == TRUE) {
+            all.n++;
+            all.sum += voltage[i];
+            all.sumsq += (uint32_t)voltage[i] * voltage[i];
+        }
+    }
+
+    if (all.n > 0) {
+        CELLSTAT_Moments(&all, &mean_uV, &sigma_uV);
+        inliers = all;
+
+        for (iteration = 0; iteration < CELLSTAT_OUTLIER_CLIP_ITERATIONS; iteration++) {
+            limit_uV = (int32_t)(CELLSTAT_OUTLIER_CLIP_SIGMA * sigma_uV);
+            if (limit_uV < (CELLSTAT_OUTLIER_MIN_DEVIATION_MV * 1000)) {
+                limit_uV = CELLSTAT_OUTLIER_MIN_DEVIATION_MV * 1000;
+            }
+
+            inliers.n = 0;
+            inliers.sum = 0;
+            inliers.sumsq = 0;
+            for (i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+                deviation = (int32_t)voltage[i] * 1000 - mean_uV;
+                if ((CELLSTAT_CellValid(i) == TRUE) && (deviation <= limit_uV) && (deviation >= -limit_uV)) {
+                    inliers.n++;
+                    inliers.sum += voltage[i];
+                    inliers.sumsq += (uint32_t)voltage[i] * voltage[i];
+                }
+            }
+
+            /* n is 0 only if the spread is dominated by far outliers on both sides */
+            if (inliers.n > 0) {
+                CELLSTAT_Moments(&inliers, &mean_uV, &sigma_uV);
+            }
+        }
+        limit_uV = (int32_t)(CELLSTAT_OUTLIER_THRESHOLD_SIGMA * sigma_uV);
+        if (limit_uV < (CELLSTAT_OUTLIER_MIN_DEVIATION_MV * 1000)) {
+            limit_uV = CELLSTAT_OUTLIER_MIN_DEVIATION_MV * 1000;
+        }
+
+        for (i = 0; i < BS_NR_OF_BAT_CELLS; i++) {
+            if (CELLSTAT_CellValid(i) == TRUE) {
+                deviation = (int32_t)voltage[i] * 1000 - mean_uV;
+                if ((deviation > limit_uV) || (deviation < -limit_uV)) {
+                    if (cellstat_outlier_cnt[i] < CELLSTAT_OUTLIER_SET_COUNT) {
+                        cellstat_outlier_cnt[i]++;
+                    }
+                } else if (cellstat_outlier_cnt[i] > 0) {
+                    cellstat_outlier_cnt[i]--;
+                }
+            }
+
+            /* hysteresis: flagged at CELLSTAT_OUTLIER_SET_COUNT, released at 0 */
+            if ((cellstat_outlier_cnt[i] == CELLSTAT_OUTLIER_SET_COUNT) ||
+                ((cellstat_outlier_cnt[i] > 0) && ((cellstat_outlier_mask[i / 32] & (1U << (i % 32))) != 0))) {
+                mask[i / 32] |= (1U << (i % 32));
+                nr_of_outliers++;
+            }
+        }
+    }
+
+    OS_TaskEnter_Critical();
+    for (i = 0; i < CELLSTAT_MASK_WORDS; i++) {
+        cellstat_outlier_mask[i] = mask[i];
+    }
+    cellstat_voltage_stats.mean_mV = (mean_uV + 500) / 1000;
+    cellstat_voltage_stats.sigma_uV = sigma_uV;
+    cellstat_voltage_stats.nr_of_cells = all.n;
+    cellstat_voltage_stats.nr_of_inliers = inliers.n;
+    cellstat_voltage_stats.nr_of_outliers = nr_of_outliers;
+    cellstat_voltage_stats.timestamp = cellstat_cellvoltage.timestamp;
+    OS_TaskExit_Critical();
+
+    if (nr_of_outliers == 0) {
+        DIAG_Handler(DIAG_CH_CELLVOLTAGE_OUTLIER, DIAG_EVENT_OK, 0, NULL_PTR);
+    } else {
+        DIAG_Handler(DIAG_CH_CELLVOLTAGE_OUTLIER, DIAG_EVENT_NOK, 0, NULL_PTR);
+    }
+}
+
+
+/**
+ * @brief   updates the gradient estimate of each sensor with the temperatures in cellstat_celltemperature
+ *
+ * @details Per sensor and measurement:
+ *          level    += (T - level) * dt / (CELLSTAT_GRADIENT_LEVEL_TAU_MS + dt)
+ *          gradient += (change of level / dt - gradient) * dt / (CELLSTAT_GRADIENT_TREND_TAU_MS + dt)
+ *          The gains and the scaling to mK/min depend only on dt, so they are computed once per
+ *          measurement in Q16 and the per sensor update needs no division. Sensors with a PEC
+ *          error keep their state. The first measurement initializes the filtered temperatures.
+ */
+static void CELLSTAT_UpdateGradients(void) {
+    const int16_t *temperature = cellstat_celltemperature.temperature;
+    uint32_t dt = cellstat_celltemperature.timestamp - cellstat_temperature_stats.timestamp;
+    uint32_t level_gain = 0;
+    uint32_t trend_gain = 0;
+    uint32_t scale = 0;
+    int64_t change = 0;
+    int64_t raw = 0;
+    int32_t max_gradient = 0;
+    uint16_t max_sensor = 0;
+    uint16_t nr_of_warnings = 0;
+    uint8_t alarm = FALSE;
+    uint16_t i = 0;
+
+    if (cellstat_gradient_started == FALSE) {
+        for (i = 0; i < BS_NR_OF_TEMP_SENSORS; i++) {
+            cellstat_temperature_level[i] = (int32_t)temperature[i] * 1000;
+            cellstat_temperature_gradient[i] = 0;
+        }
+        cellstat_gradient_started = TRUE;
+    } else {
+        level_gain = (uint32_t)(((uint64_t)dt << 16) / (CELLSTAT_GRADIENT_LEVEL_TAU_MS + (uint64_t)dt));
+        trend_gain = (uint32_t)(((uint64_t)dt << 16) / (CELLSTAT_GRADIENT_TREND_TAU_MS + (uint64_t)dt));
+        scale = (uint32_t)((60000ULL << 16) / dt);    // mK per dt -> mK/min
+
+        for (i = 0; i < BS_NR_OF_TEMP_SENSORS; i++) {
+            if (((cellstat_celltemperature.valid_temperaturePECs[i / BS_NR_OF_TEMP_SENSORS_PER_MODULE] >>
+                    (i % BS_NR_OF_TEMP_SENSORS_PER_MODULE)) & 1U) == 0) {
+                change = (((int64_t)temperature[i] * 1000 - cellstat_temperature_level[i]) * level_gain) >> 16;
+                cellstat_temperature_level[i] += (int32_t)change;
+                raw = (change * scale) >> 16;
+                cellstat_temperature_gradient[i] += (int32_t)(((raw - cellstat_temperature_gradient[i]) * trend_gain) >> 16);
+            }
+
+            if ((i == 0) || (cellstat_temperature_gradient[i] > max_gradient)) {
+                max_gradient = cellstat_temperature_gradient[i];
+                max_sensor = i;
+            }
+            if (cellstat_temperature_gradient[i] > CELLSTAT_GRADIENT_WARNING_MK_MIN) {
+                nr_of_warnings++;
+            }
+            if (cellstat_temperature_gradient[i] > CELLSTAT_GRADIENT_ALARM_MK_MIN) {
+                alarm = TRUE;
+            }
+        }
+
+        if (nr_of_warnings == 0) {
+            DIAG_Handler(DIAG_CH_TEMP_GRADIENT_WARNING, DIAG_EVENT_OK, 0, NULL_PTR);
+        } else {
+            DIAG_Handler(DIAG_CH_TEMP_GRADIENT_WARNING, DIAG_EVENT_NOK, 0, NULL_PTR);
+        }
+        if (alarm == FALSE) {
+            DIAG_Handler(DIAG_CH_TEMP_GRADIENT_ALARM, DIAG_EVENT_OK, 0, NULL_PTR);
+        } else {
+            LAT_MarkSample(DIAG_CH_TEMP_GRADIENT_ALARM, cellstat_celltemperature.timestamp);
+            DIAG_Handler(DIAG_CH_TEMP_GRADIENT_ALARM, DIAG_EVENT_NOK, 0, NULL_PTR);
+        }
+    }
+
+    OS_TaskEnter_Critical();
+    cellstat_temperature_stats.max_gradient = max_gradient;
+    cellstat_temperature_stats.max_sensor = max_sensor;
+    cellstat_temperature_stats.nr_of_warnings = nr_of_warnings;
+    cellstat_temperature_stats.timestamp = cellstat_celltemperature.timestamp;
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   checks the PEC of a cell voltage
+ *
+ * @param   cell:   cell index
+ *
+ * @return  TRUE if the voltage was received without PEC error, FALSE otherwise
+ */
+static uint8_t CELLSTAT_CellValid(uint16_t cell) {
+    uint32_t pec = cellstat_cellvoltage.valid_voltPECs[cell / BS_NR_OF_BAT_CELLS_PER_MODULE];
+
+    return (((pec >> (cell % BS_NR_OF_BAT_CELLS_PER_MODULE)) & 1U) == 0) ? TRUE : FALSE;
+}
+
+
+/**
+ * @brief   mean and standard deviation from the sums over a set of cells
+ *
+ * @details The variance is computed as (n * sumsq - sum^2) / n^2 in 64bit integer arithmetic,
+ *          so there is no cancellation as with E[x^2] - E[x]^2 in floating point.
+ *
+ * @param   sums:       sums over at least one cell
+ * @param   mean_uV:    pointer where the mean in uV is written to
+ * @param   sigma_uV:   pointer where the standard deviation in uV is written to
+ */
+static void CELLSTAT_Moments(const CELLSTAT_SUMS_s *sums, int32_t *mean_uV, uint32_t *sigma_uV) {
+    uint64_t scatter = (uint64_t)sums->n * sums->sumsq - (uint64_t)sums->sum * sums->sum;   // n^2 * variance in mV2
+
+    *mean_uV = (int32_t)(((uint64_t)sums->sum * 1000 + sums->n / 2) / sums->n);
+    *sigma_uV = CELLSTAT_Sqrt(scatter / sums->n * 1000000 / sums->n);
+}
+
+
+/**
+ * @brief   integer square root, rounded down
+ *
+ * @param   x:  radicand
+ *
+ * @return  floor(sqrt(x))
+ */
+static uint32_t CELLSTAT_Sqrt(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
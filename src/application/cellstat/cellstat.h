@@ -0,0 +1,129 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    cellstat.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  CELLSTAT
+ *
+ * @brief   Streaming statistics of the cell measurements
+ *
+ * For every new set of cell voltages a robust mean and standard deviation over all
+ * cells is computed in a fixed number of O(cells) integer passes: mean and spread of
+ * all valid cells, the same without the cells beyond CELLSTAT_OUTLIER_CLIP_SIGMA
+ * (sigma clipping, CELLSTAT_OUTLIER_CLIP_ITERATIONS times), and finally the per-cell
+ * comparison with the robust values. Each cell has an 8bit up/down counter, cells that
+ * deviate persistently are flagged as outliers (DIAG_CH_CELLVOLTAGE_OUTLIER).
+ *
+ * For every new set of cell temperatures the temperature gradient of each sensor is
+ * estimated with two cascaded first order lags in fixed-point: the temperature is
+ * filtered, and the change of the filtered temperature per time is filtered again.
+ * The state is two 32bit values per sensor. A fast rise of a single sensor is reported
+ * on DIAG_CH_TEMP_GRADIENT_WARNING and DIAG_CH_TEMP_GRADIENT_ALARM.
+ */
+
+#ifndef CELLSTAT_H_
+#define CELLSTAT_H_
+
+/*================== Includes =============================================*/
+#include "cellstat_cfg.h"
+
+#include "batterysystem_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * number of 32bit words of the outlier mask
+ */
+#define CELLSTAT_MASK_WORDS         ((BS_NR_OF_BAT_CELLS + 31) / 32)
+
+/**
+ * robust statistics of the last cell voltage measurement
+ */
+typedef struct {
+    int32_t mean_mV;            /*!< robust mean cell voltage                                  */
+    uint32_t sigma_uV;          /*!< robust standard deviation                                 */
+    uint16_t nr_of_cells;       /*!< number of valid cells                                     */
+    uint16_t nr_of_inliers;     /*!< number of cells used for the robust mean and spread       */
+    uint16_t nr_of_outliers;    /*!< number of flagged cells                                   */
+    uint32_t timestamp;         /*!< timestamp of the cell voltages                            */
+} CELLSTAT_VOLTAGE_STATS_s;
+
+/**
+ * gradients of the last cell temperature measurement
+ */
+typedef struct {
+    int32_t max_gradient;       /*!< largest temperature gradient in mK/min                    */
+    uint16_t max_sensor;        /*!< sensor with the largest gradient                          */
+    uint16_t nr_of_warnings;    /*!< number of sensors above CELLSTAT_GRADIENT_WARNING_MK_MIN  */
+    uint32_t timestamp;         /*!< timestamp of the cell temperatures                        */
+} CELLSTAT_TEMPERATURE_STATS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   updates the cell statistics on new measurement data
+ *
+ * @details Called in the 10ms application task, runs once per cell voltage and once per
+ *          cell temperature measurement.
+ */
+extern void CELLSTAT_Trigger(void);
+
+/**
+ * @brief   returns the robust statistics of the last cell voltage measurement
+ *
+ * @param   stats:  pointer where the statistics are written to
+ */
+extern void CELLSTAT_GetVoltageStatistics(CELLSTAT_VOLTAGE_STATS_s *stats);
+
+/**
+ * @brief   returns the flagged cells
+ *
+ * @param   mask:   CELLSTAT_MASK_WORDS words, bit i of word i/32 is set for a flagged cell i
+ *
+ * @return  number of flagged cells
+ */
+extern uint16_t CELLSTAT_GetVoltageOutliers(uint32_t *mask);
+
+/**
+ * @brief   returns the gradients of the last cell temperature measurement
+ *
+ * @param   stats:  pointer where the statistics are written to
+ */
+extern void CELLSTAT_GetTemperatureStatistics(CELLSTAT_TEMPERATURE_STATS_s *stats);
+
+/**
+ * @brief   returns the estimated temperature gradient of a sensor
+ *
+ * @param   sensor: sensor index, less than BS_NR_OF_TEMP_SENSORS
+ *
+ * @return  temperature gradient in mK/min, positive for a rising temperature
+ */
+extern int32_t CELLSTAT_GetTemperatureGradient(uint16_t sensor);
+
+/*================== Function Implementations =============================*/
+
+#endif /* CELLSTAT_H_ */
@@ -43,14 +43,18 @@
 #include "appltask_cfg.h"
 
 #include "bms.h"
+#include "cellstat.h"
+#include "coulomb.h"
 #include "diag.h"
+#include "movmean.h"
+#include "soa.h"
 
 /*================== Macros and Definitions ===============================*/
 
 /*================== Constant and Variable Definitions ====================*/
-BMS_Task_Definition_s appl_tskdef_cyclic_1ms    = {     0,      1,  OS_PRIORITY_NORMAL,        1024/4};
-BMS_Task_Definition_s appl_tskdef_cyclic_10ms   = {     4,     10,  OS_PRIORITY_BELOW_NORMAL,  1024/4};
-BMS_Task_Definition_s appl_tskdef_cyclic_100ms  = {    58,    100,  OS_PRIORITY_LOW,            512/4};
+BMS_Task_Definition_s appl_tskdef_cyclic_1ms    = {     0,      1,  OS_PRIORITY_NORMAL,        APPL_TSK_CYCLIC_1MS_STACKSIZE};
+BMS_Task_Definition_s appl_tskdef_cyclic_10ms   = {     4,     10,  OS_PRIORITY_BELOW_NORMAL,  APPL_TSK_CYCLIC_10MS_STACKSIZE};
+BMS_Task_Definition_s appl_tskdef_cyclic_100ms  = {    58,    100,  OS_PRIORITY_LOW,           APPL_TSK_CYCLIC_100MS_STACKSIZE};
 
 /*================== Function Prototypes ==================================*/
 
@@ -61,12 +65,18 @@ void APPL_Cyclic_1ms(void) {
     /* User specific implementations:   */
     /*   ...                            */
     /*   ...                            */
+    MOVMEAN_Trigger();
+    COULOMB_Trigger();
     BMS_Trigger();
 }
 
 void APPL_Cyclic_10ms(void) {
     DIAG_SysMonNotify(DIAG_SYSMON_APPL_CYCLIC_10ms, 0);
 
+    SOA_UpdateMinMax();
+    SOA_CheckVoltageSums();
+    CELLSTAT_Trigger();
+
     /* User specific implementations:   */
     /*   ...                            */
     /*   ...                            */
@@ -75,6 +85,10 @@ void APPL_Cyclic_10ms(void) {
 void APPL_Cyclic_100ms(void) {
     DIAG_SysMonNotify(DIAG_SYSMON_APPL_CYCLIC_100ms, 0);
 
+#if SOA_BENCHMARK_ENABLE == TRUE
+    SOA_Benchmark();
+#endif
+
     /* User specific implementations:   */
     /*   ...                            */
     /*   ...                            */
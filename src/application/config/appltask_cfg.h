@@ -42,6 +42,14 @@
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * stack sizes of the application tasks in words, the stacks are allocated
+ * statically (MEM_OS_STATIC)
+ */
+#define APPL_TSK_CYCLIC_1MS_STACKSIZE       (1024/4)
+#define APPL_TSK_CYCLIC_10MS_STACKSIZE      (1024/4)
+#define APPL_TSK_CYCLIC_100MS_STACKSIZE     (512/4)
+
 /*================== Constant and Variable Definitions ====================*/
 
 /**
@@ -72,15 +72,69 @@
 
 /**
  * @ingroup CONFIG_BMS
- * checking if current is in SOF limits of cells. Set FALSE for test without checking against SOF derating.
+ * checking if current is in SOF limits of cells, i.e. the limits of the derating tables over
+ * temperature and SOC (soa_derating_discharge, soa_derating_charge).
+ * If FALSE (default) the derating is not evaluated and not enforced by the secondary: the
+ * overcurrent checks use BC_CURRENTMAX_xxx and the I2t curves, the SOF limits are left to
+ * the primary. Set TRUE to open the interlock on a violation of the derated limits.
  * \par Type:
  * select(2)
  * \par Default:
- * 1
+ * FALSE
 */
 //#define BMS_TEST_CELL_SOF_LIMITS  TRUE
 #define BMS_TEST_CELL_SOF_LIMITS FALSE
 
+/**
+ * @ingroup CONFIG_BMS
+ * event-driven BMS_Trigger(): a check runs when the database timestamp of its measurement
+ * data changes (at the latest after BMS_EVENT_CHECK_TIMEOUT_MS), the state machine runs
+ * when its timer expires, on a state request or on a changed error flag (BMS_NotifyEvent()).
+ * If FALSE, the checks and the state machine run on every call (every 1ms).
+ * Note: the DIAG sensitivities of the safe operating area channels count check
+ * executions, so the debounce times get longer in event-driven mode.
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * FALSE
+*/
+#define BMS_EVENT_DRIVEN_TRIGGER    FALSE
+
+/**
+ * @ingroup CONFIG_BMS
+ * longest time without execution of a check or of a waiting state machine in
+ * event-driven mode. Keeps the debounce of the DIAG channels running without new data.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 10
+*/
+#define BMS_EVENT_CHECK_TIMEOUT_MS  (10)
+
+/**
+ * @ingroup CONFIG_BMS
+ * measures the CPU cycles spent in BMS_Trigger() with the DWT cycle counter (see BMS_GetLoad())
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * TRUE
+*/
+#define BMS_LOAD_MEASUREMENT        TRUE
+
+/**
+ * @ingroup CONFIG_BMS
+ * measurement window of the CPU load of BMS_Trigger()
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 1000
+*/
+#define BMS_LOAD_WINDOW_MS          (1000)
+
 
 
 
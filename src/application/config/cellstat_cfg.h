@@ -0,0 +1,174 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    cellstat_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION_CONF
+ * @prefix  CELLSTAT
+ *
+ * @brief   Configuration of the streaming cell statistics
+ */
+
+#ifndef CELLSTAT_CFG_H_
+#define CELLSTAT_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * clipping limit of the robust estimate in multiples of the standard deviation of all cells.
+ * Cells further away from the mean of all cells are excluded from the robust mean and spread.
+ * \par Type:
+ * int
+ * \par Default:
+ * 3
+*/
+#define CELLSTAT_OUTLIER_CLIP_SIGMA         (3)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * number of sigma clipping passes of the robust estimate. Each pass costs one pass over
+ * all cells. A second pass removes moderate outliers that are hidden by a far outlier
+ * in the first pass.
+ * \par Type:
+ * int
+ * \par Range:
+ * 1 <= x <= 3
+ * \par Default:
+ * 2
+*/
+#define CELLSTAT_OUTLIER_CLIP_ITERATIONS    (2)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * deviation from the robust mean in multiples of the robust standard deviation above which
+ * a cell voltage counts as deviating
+ * \par Type:
+ * int
+ * \par Default:
+ * 4
+*/
+#define CELLSTAT_OUTLIER_THRESHOLD_SIGMA    (4)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * smallest deviation from the robust mean that counts as deviating. Keeps well balanced
+ * packs with a spread of a few mV from flagging cells. Also the smallest clipping limit.
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * 30
+*/
+#define CELLSTAT_OUTLIER_MIN_DEVIATION_MV   (30)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * persistence of the outlier detection. The counter of a cell is incremented for each
+ * deviating measurement and decremented for each other measurement. The cell is flagged
+ * when the counter reaches this value and released when it is back at 0.
+ * \par Type:
+ * int
+ * \par Range:
+ * 1 <= x <= 255
+ * \par Unit:
+ * cell voltage measurements
+ * \par Default:
+ * 20
+*/
+#define CELLSTAT_OUTLIER_SET_COUNT          (20)
+
+/*
+ * The time constants are sized for an alarm within 10s on a 60K/min ramp (about 9K above
+ * the start temperature) while
+ * the dithering of the 1 degree Celsius quantization stays below the warning threshold.
+ * tests/host/test_cellstat_gradient.c checks both at 200ms measurement period: with
+ * 4s/6s the 60K/min alarm comes after 8.6s, the dithering peaks at 1.8K/min and a 3K/min
+ * ramp with dithering at 4.6K/min (10s/20s: alarm after 24.8s).
+ */
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * time constant of the temperature filter of the gradient estimator. Smooths the
+ * 1 degree Celsius quantization of the cell temperatures before the derivative.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 4000
+*/
+#define CELLSTAT_GRADIENT_LEVEL_TAU_MS      (4000)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * time constant of the gradient filter of the gradient estimator. The estimate follows a
+ * temperature ramp after about the sum of both time constants.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 6000
+*/
+#define CELLSTAT_GRADIENT_TREND_TAU_MS      (6000)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * temperature rise of a sensor above which DIAG_CH_TEMP_GRADIENT_WARNING is reported.
+ * A single quantization step of the temperature causes a peak of about 4400mK/min with the
+ * default time constants (1K * (exp(-t/tau1) - exp(-t/tau2)) / (tau1 - tau2) at its maximum).
+ * \par Type:
+ * int
+ * \par Unit:
+ * mK/min
+ * \par Default:
+ * 6000
+*/
+#define CELLSTAT_GRADIENT_WARNING_MK_MIN    (6000)
+
+/**
+ * @ingroup CONFIG_CELLSTAT
+ * temperature rise of a sensor above which DIAG_CH_TEMP_GRADIENT_ALARM is reported
+ * and the contactors are opened
+ * \par Type:
+ * int
+ * \par Unit:
+ * mK/min
+ * \par Default:
+ * 30000
+*/
+#define CELLSTAT_GRADIENT_ALARM_MK_MIN      (30000)
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* CELLSTAT_CFG_H_ */
@@ -0,0 +1,106 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    coulomb_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION_CONF
+ * @prefix  COULOMB
+ *
+ * @brief   Configuration of the coulomb and energy counting of the secondary
+ */
+
+#ifndef COULOMB_CFG_H_
+#define COULOMB_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_COULOMB
+ * length of the plausibility window. The changes of the own counters and of the
+ * counters of the current sensor (current_counter, energy_counter) over this time
+ * are compared, then the next window starts.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 10000
+*/
+#define COULOMB_PLAUSIBILITY_WINDOW_MS      (10000)
+
+/**
+ * @ingroup CONFIG_COULOMB
+ * absolute tolerance of the charge comparison
+ * \par Type:
+ * int
+ * \par Unit:
+ * mAs
+ * \par Default:
+ * 1000
+*/
+#define COULOMB_CHARGE_TOLERANCE_MAS        (1000)
+
+/**
+ * @ingroup CONFIG_COULOMB
+ * absolute tolerance of the energy comparison
+ * \par Type:
+ * int
+ * \par Unit:
+ * mWh
+ * \par Default:
+ * 500
+*/
+#define COULOMB_ENERGY_TOLERANCE_MWH        (500)
+
+/**
+ * @ingroup CONFIG_COULOMB
+ * relative tolerance of both comparisons, in percent of the charge/energy throughput
+ * (integral of the absolute value) in the window
+ * \par Type:
+ * int
+ * \par Unit:
+ * %
+ * \par Default:
+ * 2
+*/
+#define COULOMB_TOLERANCE_PERCENT           (2)
+
+/**
+ * @ingroup CONFIG_COULOMB
+ * samples above this absolute value (mA or mW) are limited
+ * \par Type:
+ * int
+ * \par Default:
+ * 2000000000
+*/
+#define COULOMB_INPUT_LIMIT                 (2000000000)
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* COULOMB_CFG_H_ */
@@ -0,0 +1,122 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    movmean_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION_CONF
+ * @prefix  MOVMEAN
+ *
+ * @brief   Configuration header of the moving mean of current and power
+ */
+
+#ifndef MOVMEAN_CFG_H_
+#define MOVMEAN_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_MOVMEAN
+ * call period of MOVMEAN_Trigger() (1ms application task)
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 1
+*/
+#define MOVMEAN_SAMPLE_PERIOD_MS        (1)
+
+/**
+ * @ingroup CONFIG_MOVMEAN
+ * length of the sub-blocks the samples are summed up in. The 1s mean is
+ * updated with this resolution, the longer windows every second.
+ * Must divide 1000ms and be a multiple of MOVMEAN_SAMPLE_PERIOD_MS.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 100
+*/
+#define MOVMEAN_SUBBLOCK_MS             (100)
+
+/**
+ * @ingroup CONFIG_MOVMEAN
+ * length of the configurable window (movMean_current_config, movMean_power_config)
+ * \par Type:
+ * int
+ * \par Unit:
+ * s
+ * \par Default:
+ * 20
+ * \par Range:
+ * [1,MOVMEAN_MAX_WINDOW_S]
+*/
+#define MOVMEAN_CONFIG_WINDOW_S         (20)
+
+/**
+ * @ingroup CONFIG_MOVMEAN
+ * period for writing DATA_BLOCK_ID_MOV_MEAN
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 100
+*/
+#define MOVMEAN_PUBLISH_PERIOD_MS       (100)
+
+/**
+ * longest window, sizes the ring buffer of the 1s sums
+ */
+#define MOVMEAN_MAX_WINDOW_S            (60)
+
+/**
+ * @ingroup CONFIG_MOVMEAN
+ * samples are limited to +/- this value (mA, W), so that a 1s sum fits into 32bit
+ * \par Type:
+ * int
+ * \par Default:
+ * 1000000
+*/
+#define MOVMEAN_INPUT_LIMIT             (1000000)
+
+#if (MOVMEAN_CONFIG_WINDOW_S < 1) || (MOVMEAN_CONFIG_WINDOW_S > MOVMEAN_MAX_WINDOW_S)
+#error "MOVMEAN_CONFIG_WINDOW_S out of range"
+#endif
+
+#if ((1000 % MOVMEAN_SUBBLOCK_MS) != 0) || ((MOVMEAN_SUBBLOCK_MS % MOVMEAN_SAMPLE_PERIOD_MS) != 0)
+#error "MOVMEAN_SUBBLOCK_MS must divide 1000ms and be a multiple of MOVMEAN_SAMPLE_PERIOD_MS"
+#endif
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* MOVMEAN_CFG_H_ */
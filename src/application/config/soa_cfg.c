@@ -0,0 +1,87 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    soa_cfg.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION_CONF
+ * @prefix  SOA
+ *
+ * @brief   Configuration of the per-cell safe operating area checks
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "soa_cfg.h"
+
+#include "batterycell_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+/**
+ * I2t limit curves: the full current is allowed for a few seconds, sustained
+ * currents have to stay below 70% (10s) and 50% (60s) of the maximum current.
+ * Peaks above BC_CURRENTMAX_xxx are caught by the flat limit in BMS_CheckCurrent().
+ */
+const SOA_I2T_CURVE_s soa_i2t_curves[SOA_I2T_NR_OF_CURVES] = {
+    {  1000, SOA_I2T_ALPHA(1000),  BC_CURRENTMAX_DISCHARGE,               BC_CURRENTMAX_CHARGE              },
+    { 10000, SOA_I2T_ALPHA(10000), (BC_CURRENTMAX_DISCHARGE / 10) * 7,    (BC_CURRENTMAX_CHARGE / 10) * 7   },
+    { 60000, SOA_I2T_ALPHA(60000), BC_CURRENTMAX_DISCHARGE / 2,           BC_CURRENTMAX_CHARGE / 2          },
+};
+
+/**
+ * discharge derating: reduced at low temperatures, above BC_TEMPMAX_DISCHARGE and at low SOC
+ */
+const uint16_t soa_derating_discharge[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS] = {
+    /*   0%                         20%                         40%                         60%                         80%                         100%        */
+    {SOA_DERATING_PERCENT(10),  SOA_DERATING_PERCENT(20),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30)},      /* -20 degC */
+    {SOA_DERATING_PERCENT(20),  SOA_DERATING_PERCENT(35),   SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(50)},      /* -10 degC */
+    {SOA_DERATING_PERCENT(20),  SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70)},      /*   0 degC */
+    {SOA_DERATING_PERCENT(20),  SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100)},     /*  10 degC */
+    {SOA_DERATING_PERCENT(20),  SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100)},     /*  20 degC */
+    {SOA_DERATING_PERCENT(20),  SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100)},     /*  30 degC */
+    {SOA_DERATING_PERCENT(20),  SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70)},      /*  40 degC */
+    {SOA_DERATING_PERCENT(0),   SOA_DERATING_PERCENT(20),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30)},      /*  50 degC */
+};
+
+/**
+ * charge derating: reduced at low temperatures, above BC_TEMPMAX_CHARGE and at high SOC
+ */
+const uint16_t soa_derating_charge[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS] = {
+    /*   0%                         20%                         40%                         60%                         80%                         100%        */
+    {SOA_DERATING_PERCENT(0),   SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0)},       /* -20 degC */
+    {SOA_DERATING_PERCENT(10),  SOA_DERATING_PERCENT(10),   SOA_DERATING_PERCENT(10),   SOA_DERATING_PERCENT(10),   SOA_DERATING_PERCENT(5),    SOA_DERATING_PERCENT(0)},       /* -10 degC */
+    {SOA_DERATING_PERCENT(30),  SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(30),   SOA_DERATING_PERCENT(15),   SOA_DERATING_PERCENT(5)},       /*   0 degC */
+    {SOA_DERATING_PERCENT(70),  SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(35),   SOA_DERATING_PERCENT(10)},      /*  10 degC */
+    {SOA_DERATING_PERCENT(100), SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(10)},      /*  20 degC */
+    {SOA_DERATING_PERCENT(100), SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(100),  SOA_DERATING_PERCENT(50),   SOA_DERATING_PERCENT(10)},      /*  30 degC */
+    {SOA_DERATING_PERCENT(70),  SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(70),   SOA_DERATING_PERCENT(35),   SOA_DERATING_PERCENT(10)},      /*  40 degC */
+    {SOA_DERATING_PERCENT(0),   SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0),    SOA_DERATING_PERCENT(0)},       /*  50 degC */
+};
+
+const uint16_t soa_benchmark_sizes[SOA_BENCHMARK_NR_OF_SIZES] = {12, 180, SOA_BENCHMARK_MAX_CELLS};
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
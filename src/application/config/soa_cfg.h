@@ -0,0 +1,305 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    soa_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION_CONF
+ * @prefix  SOA
+ *
+ * @brief   Configuration header of the per-cell safe operating area checks
+ *
+ * The module also computes minimum, maximum and mean of the cell data on the
+ * secondary and checks them against the received MINMAX values, cross-checks the
+ * cell, module and pack voltage sums, and integrates the thermal equivalent (I2t)
+ * of the battery current.
+ */
+
+#ifndef SOA_CFG_H_
+#define SOA_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_SOA
+ * use the Cortex-M4 DSP instructions (packed 16bit compare and select) for the per-cell checks.
+ * If FALSE or if the target has no DSP extension, the portable reference implementation is used.
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * TRUE
+*/
+#define SOA_USE_DSP_INSTRUCTIONS    TRUE
+
+/**
+ * @ingroup CONFIG_SOA
+ * enables the cycle benchmark of the per-cell checks (SOA_Benchmark()).
+ * The benchmark runs once, compares DSP and reference implementation and stores
+ * the results in soa_benchmark[].
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * FALSE
+*/
+#define SOA_BENCHMARK_ENABLE        FALSE
+
+/**
+ * @ingroup CONFIG_SOA
+ * maximum allowed difference between received and computed minimum/maximum cell voltage
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * 10
+*/
+#define SOA_MINMAX_VOLTAGE_TOLERANCE_MV     (10)
+
+/**
+ * @ingroup CONFIG_SOA
+ * maximum allowed difference between received and computed minimum/maximum cell temperature
+ * \par Type:
+ * int
+ * \par Unit:
+ * degree Celsius
+ * \par Default:
+ * 1
+*/
+#define SOA_MINMAX_TEMPERATURE_TOLERANCE    (1)
+
+/**
+ * @ingroup CONFIG_SOA
+ * maximum time between the cell voltages and the received minimum/maximum values for which
+ * both are taken from the same measurement cycle, otherwise the received values are not compared
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 50
+*/
+#define SOA_MINMAX_MAX_SKEW_MS              (50)
+
+/**
+ * @ingroup CONFIG_SOA
+ * period of the voltage sum cross-check (SOA_CheckVoltageSums()), multiple of the 10ms task.
+ * The check runs only on new cell voltages, so it is never faster than the measurement cycle.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 100
+*/
+#define SOA_VOLTAGE_SUM_PERIOD_MS           (100)
+
+/**
+ * @ingroup CONFIG_SOA
+ * maximum allowed difference between the sums of the cell voltages of a module and the module
+ * voltage measured by the monitoring IC (sum of cells conversion of the cell voltage block
+ * and of the device parameter block), plus SOA_VOLTAGE_SUM_TOLERANCE_PERCENT
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * 100
+*/
+#define SOA_VOLTAGE_SUM_MODULE_TOLERANCE_MV (100)
+
+/**
+ * @ingroup CONFIG_SOA
+ * maximum allowed difference between the computed pack sum and the battery voltage
+ * measured by the current sensor, plus SOA_VOLTAGE_SUM_TOLERANCE_PERCENT
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * 500
+*/
+#define SOA_VOLTAGE_SUM_PACK_TOLERANCE_MV   (500)
+
+/**
+ * @ingroup CONFIG_SOA
+ * maximum time between the cell voltages and the current sensor data for which the pack
+ * sum is compared with the current sensor voltage. The current block has one timestamp
+ * for all its values, so the skew is taken from it.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 100
+*/
+#define SOA_VOLTAGE_SUM_MAX_SKEW_MS         (100)
+
+/**
+ * @ingroup CONFIG_SOA
+ * relative part of the module and pack voltage tolerances, referred to the computed sum
+ * \par Type:
+ * int
+ * \par Unit:
+ * %
+ * \par Default:
+ * 1
+*/
+#define SOA_VOLTAGE_SUM_TOLERANCE_PERCENT   (1)
+
+/**
+ * @ingroup CONFIG_SOA
+ * index of the current sensor voltage (DATA_BLOCK_CURRENT_s.voltage[]) that measures the
+ * pack voltage directly at the battery, i.e. on the battery side of the contactors. Set to -1 if no such voltage is measured,
+ * the pack check is then skipped.
+ * \par Type:
+ * int
+ * \par Range:
+ * -1 <= x < BS_NR_OF_VOLTAGES_FROM_CURRENT_SENSOR
+ * \par Default:
+ * 0
+*/
+#define SOA_VOLTAGE_SUM_PACK_INDEX          (0)
+
+/**
+ * number of I2t limit curves in soa_i2t_curves[]
+ */
+#define SOA_I2T_NR_OF_CURVES        (3)
+
+/**
+ * fixed-point shift of the I2t filter coefficients
+ */
+#define SOA_I2T_ALPHA_SHIFT         (24)
+
+/**
+ * filter coefficient of a curve with time constant tau_ms, (1ms/tau) in Q24
+ */
+#define SOA_I2T_ALPHA(tau_ms)       ((uint32_t)((1ULL << SOA_I2T_ALPHA_SHIFT) / (tau_ms)))
+
+/**
+ * number of temperature points of the derating tables
+ */
+#define SOA_DERATING_NR_OF_TEMPERATURES (8)
+
+/**
+ * @ingroup CONFIG_SOA
+ * first temperature point of the derating tables
+ * \par Type:
+ * int
+ * \par Unit:
+ * degree Celsius
+ * \par Default:
+ * -20
+*/
+#define SOA_DERATING_TEMPERATURE_MIN    (-20)
+
+/**
+ * @ingroup CONFIG_SOA
+ * distance of the temperature points of the derating tables
+ * \par Type:
+ * int
+ * \par Unit:
+ * degree Celsius
+ * \par Default:
+ * 10
+*/
+#define SOA_DERATING_TEMPERATURE_STEP   (10)
+
+/**
+ * number of SOC points of the derating tables
+ */
+#define SOA_DERATING_NR_OF_SOCS         (6)
+
+/**
+ * @ingroup CONFIG_SOA
+ * distance of the SOC points of the derating tables, the first point is 0%
+ * \par Type:
+ * int
+ * \par Unit:
+ * 0.01%
+ * \par Default:
+ * 2000
+*/
+#define SOA_DERATING_SOC_STEP           (2000)
+
+/**
+ * derating factor 1.0 in Q15
+ */
+#define SOA_DERATING_ONE                (1U << 15)
+
+/**
+ * derating factor in Q15 from a percentage
+ */
+#define SOA_DERATING_PERCENT(p)         ((uint16_t)(((p) * SOA_DERATING_ONE) / 100))
+
+/**
+ * number of cell counts measured by the benchmark
+ */
+#define SOA_BENCHMARK_NR_OF_SIZES   (3)
+
+/**
+ * largest cell count measured by the benchmark, sizes the benchmark buffers
+ */
+#define SOA_BENCHMARK_MAX_CELLS     (600)
+
+/**
+ * I2t limit curve
+ *
+ * The squared current is filtered with a first order lag of time constant tau.
+ * The curve is violated if the filtered value exceeds the squared limit, i.e. if
+ * the thermal equivalent RMS current over about tau is above the limit. Short
+ * peaks (compared to tau) above the limit are allowed.
+ */
+typedef struct {
+    uint32_t tau_ms;                /*!< thermal time constant in ms                     */
+    uint32_t alpha;                 /*!< filter coefficient, SOA_I2T_ALPHA(tau_ms)       */
+    uint32_t limit_discharge_mA;    /*!< equivalent RMS current limit for discharge      */
+    uint32_t limit_charge_mA;       /*!< equivalent RMS current limit for charge         */
+} SOA_I2T_CURVE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * I2t limit curves
+ */
+extern const SOA_I2T_CURVE_s soa_i2t_curves[SOA_I2T_NR_OF_CURVES];
+
+/**
+ * derating factors of the maximum discharge and charge current (BC_CURRENTMAX_xxx) in Q15,
+ * rows: temperature points, columns: SOC points
+ */
+extern const uint16_t soa_derating_discharge[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS];
+extern const uint16_t soa_derating_charge[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS];
+
+/**
+ * cell counts measured by the benchmark
+ */
+extern const uint16_t soa_benchmark_sizes[SOA_BENCHMARK_NR_OF_SIZES];
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOA_CFG_H_ */
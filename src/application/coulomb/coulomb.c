@@ -0,0 +1,172 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    coulomb.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  COULOMB
+ *
+ * @brief   Coulomb and energy counting of the secondary
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "coulomb.h"
+
+#include "database.h"
+#include "diag.h"
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+static COULOMB_STATE_s coulomb_state;
+
+/*================== Function Prototypes ==================================*/
+
+static int32_t COULOMB_Limit(float value);
+static void COULOMB_CheckPlausibility(const DATA_BLOCK_CURRENT_s *curr_tab);
+
+/*================== Function Implementations =============================*/
+
+void COULOMB_Trigger(void) {
+    DATA_BLOCK_CURRENT_s curr_tab;
+    int32_t current = 0;
+    int32_t power = 0;
+    int64_t dt = 0;
+    int64_t charge = 0;
+    int64_t energy = 0;
+
+    DB_ReadBlock(&curr_tab, DATA_BLOCK_ID_CURRENT);
+
+    if (curr_tab.timestamp != coulomb_state.last_timestamp) {
+        current = COULOMB_Limit(curr_tab.current);
+        power = COULOMB_Limit(curr_tab.power * 1000.0f);    // W -> mW
+
+        if (coulomb_state.sampling == TRUE) {
+            /* trapezoid, twice the area: (i0 + i1) * dt */
+            dt = (int64_t)(uint32_t)(curr_tab.timestamp - coulomb_state.last_timestamp);
+            charge = ((int64_t)coulomb_state.last_current + current) * dt;
+            energy = ((int64_t)coulomb_state.last_power + power) * dt;
+
+            OS_TaskEnter_Critical();
+            coulomb_state.charge += charge;
+            coulomb_state.energy += energy;
+            OS_TaskExit_Critical();
+            coulomb_state.throughput_charge += (uint64_t)((charge >= 0) ? charge : -charge);
+            coulomb_state.throughput_energy += (uint64_t)((energy >= 0) ? energy : -energy);
+        }
+        coulomb_state.last_current = current;
+        coulomb_state.last_power = power;
+        coulomb_state.last_timestamp = curr_tab.timestamp;
+        coulomb_state.sampling = TRUE;
+    }
+
+    if (curr_tab.timestamp_cc != coulomb_state.last_timestamp_cc) {
+        coulomb_state.last_timestamp_cc = curr_tab.timestamp_cc;
+        COULOMB_CheckPlausibility(&curr_tab);
+    }
+}
+
+
+void COULOMB_GetCounters(COULOMB_COUNTERS_s *counters) {
+    OS_TaskEnter_Critical();
+    counters->charge_uAs = coulomb_state.charge / 2;
+    counters->energy_uJ = coulomb_state.energy / 2;
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   limits and rounds a sample to an integer
+ *
+ * @param   value:  sample in mA or mW
+ *
+ * @return  rounded sample, limited to +/- COULOMB_INPUT_LIMIT
+ */
+static int32_t COULOMB_Limit(float value) {
+    if (value > COULOMB_INPUT_LIMIT) {
+        return COULOMB_INPUT_LIMIT;
+    } else if (value < -COULOMB_INPUT_LIMIT) {
+        return -COULOMB_INPUT_LIMIT;
+    } else if (value >= 0.0f) {
+        return (int32_t)(value + 0.5f);
+    } else if (value < 0.0f) {
+        return (int32_t)(value - 0.5f);
+    }
+    return 0;   // NaN
+}
+
+
+/**
+ * @brief   compares the own counters with the counters of the current sensor
+ *
+ * @details Called for every new value of the sensor counters. The first value starts a window,
+ *          after COULOMB_PLAUSIBILITY_WINDOW_MS the changes of both counters are compared and the
+ *          next window starts. The tolerance is the absolute tolerance plus
+ *          COULOMB_TOLERANCE_PERCENT of the throughput in the window, so charge and discharge
+ *          that cancel out do not shrink it.
+ *
+ * @param   curr_tab:   current data with the new sensor counters
+ */
+static void COULOMB_CheckPlausibility(const DATA_BLOCK_CURRENT_s *curr_tab) {
+    float diff_charge = 0.0f;    // mAs
+    float diff_energy = 0.0f;    // mWh
+    float tolerance_charge = 0.0f;
+    float tolerance_energy = 0.0f;
+
+    if (coulomb_state.window_running == TRUE) {
+        if ((uint32_t)(curr_tab->timestamp_cc - coulomb_state.window_start) < COULOMB_PLAUSIBILITY_WINDOW_MS) {
+            return;
+        }
+
+        /* own counters in 0.5uAs and 0.5uJ, sensor counters in As and Wh */
+        diff_charge = (float)(coulomb_state.charge - coulomb_state.window_charge) / 2000.0f -
+                      (curr_tab->current_counter - coulomb_state.window_current_counter) * 1000.0f;
+        diff_energy = (float)(coulomb_state.energy - coulomb_state.window_energy) / 7200000.0f -
+                      (curr_tab->energy_counter - coulomb_state.window_energy_counter) * 1000.0f;
+        tolerance_charge = COULOMB_CHARGE_TOLERANCE_MAS +
+                           (float)coulomb_state.throughput_charge / 2000.0f * (COULOMB_TOLERANCE_PERCENT / 100.0f);
+        tolerance_energy = COULOMB_ENERGY_TOLERANCE_MWH +
+                           (float)coulomb_state.throughput_energy / 7200000.0f * (COULOMB_TOLERANCE_PERCENT / 100.0f);
+
+        if ((diff_charge > tolerance_charge) || (diff_charge < -tolerance_charge) ||
+                (diff_energy > tolerance_energy) || (diff_energy < -tolerance_energy) ||
+                (diff_charge != diff_charge) || (diff_energy != diff_energy)) {
+            DIAG_Handler(DIAG_CH_COULOMB_PLAUSIBILITY, DIAG_EVENT_NOK, 0, NULL_PTR);
+        } else {
+            DIAG_Handler(DIAG_CH_COULOMB_PLAUSIBILITY, DIAG_EVENT_OK, 0, NULL_PTR);
+        }
+    }
+
+    coulomb_state.window_charge = coulomb_state.charge;
+    coulomb_state.window_energy = coulomb_state.energy;
+    coulomb_state.window_current_counter = curr_tab->current_counter;
+    coulomb_state.window_energy_counter = curr_tab->energy_counter;
+    coulomb_state.window_start = curr_tab->timestamp_cc;
+    coulomb_state.throughput_charge = 0;
+    coulomb_state.throughput_energy = 0;
+    coulomb_state.window_running = TRUE;
+}
@@ -0,0 +1,97 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    coulomb.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  COULOMB
+ *
+ * @brief   Coulomb and energy counting of the secondary
+ *
+ * Integrates current and power of DATA_BLOCK_CURRENT_s over the sample timestamps
+ * (trapezoidal rule) in 64bit integer accumulators, so no rounding error accumulates.
+ * The changes of the own counters are compared window by window with the changes of
+ * current_counter and energy_counter of the current sensor (DIAG_CH_COULOMB_PLAUSIBILITY).
+ */
+
+#ifndef COULOMB_H_
+#define COULOMB_H_
+
+/*================== Includes =============================================*/
+#include "coulomb_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * charge and energy counted by the secondary since startup
+ */
+typedef struct {
+    int64_t charge_uAs;     /*!< charge in uAs (= mA*ms), positive for discharge    */
+    int64_t energy_uJ;      /*!< energy in uJ (= mW*ms)                             */
+} COULOMB_COUNTERS_s;
+
+/**
+ * state of the coulomb counting
+ */
+typedef struct {
+    int64_t charge;                 /*!< own charge counter in 0.5uAs (trapezoids are not divided by 2)    */
+    int64_t energy;                 /*!< own energy counter in 0.5uJ                                        */
+    uint64_t throughput_charge;     /*!< integral of the absolute current in the window, 0.5uAs             */
+    uint64_t throughput_energy;     /*!< integral of the absolute power in the window, 0.5uJ                */
+    int32_t last_current;           /*!< previous current sample in mA                                      */
+    int32_t last_power;             /*!< previous power sample in mW                                        */
+    uint32_t last_timestamp;        /*!< timestamp of the previous current sample                           */
+    uint32_t last_timestamp_cc;     /*!< timestamp of the previous counter values of the current sensor    */
+    int64_t window_charge;          /*!< own charge counter at the start of the window                      */
+    int64_t window_energy;          /*!< own energy counter at the start of the window                      */
+    float window_current_counter;   /*!< current_counter of the current sensor at the start of the window  */
+    float window_energy_counter;    /*!< energy_counter of the current sensor at the start of the window   */
+    uint32_t window_start;          /*!< timestamp_cc at the start of the window                            */
+    uint8_t sampling;               /*!< TRUE after the first current sample                                */
+    uint8_t window_running;         /*!< TRUE if a plausibility window has been started                     */
+} COULOMB_STATE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   integrates new current and power samples and checks the counters of the current sensor
+ *
+ * @details Called in the 1ms application task. Samples are detected by their timestamp, so the
+ *          call period does not enter the integration. Each call costs a database read and a
+ *          few integer operations.
+ */
+extern void COULOMB_Trigger(void);
+
+/**
+ * @brief   returns the charge and energy counted by the secondary
+ *
+ * @param   counters:   pointer where the counters are written to
+ */
+extern void COULOMB_GetCounters(COULOMB_COUNTERS_s *counters);
+
+/*================== Function Implementations =============================*/
+
+#endif /* COULOMB_H_ */
@@ -0,0 +1,191 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    movmean.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  MOVMEAN
+ *
+ * @brief   Moving mean of current and power over sliding windows
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "movmean.h"
+
+#include "database.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * length of the windows in s
+ */
+static const uint8_t movmean_window_s[MOVMEAN_NR_OF_WINDOWS] = {
+    1, 5, 10, 30, 60, MOVMEAN_CONFIG_WINDOW_S,
+};
+
+static MOVMEAN_STATE_s movmean_state;
+
+/*================== Function Prototypes ==================================*/
+
+static int32_t MOVMEAN_Limit(float value);
+static void MOVMEAN_CloseSubblock(MOVMEAN_SIGNAL_s *signal, uint8_t second_complete);
+static int32_t MOVMEAN_GetMean(const MOVMEAN_SIGNAL_s *signal, MOVMEAN_WINDOW_e window);
+
+/*================== Function Implementations =============================*/
+
+void MOVMEAN_Trigger(void) {
+    DATA_BLOCK_CURRENT_s curr_tab;
+    DATA_BLOCK_MOVING_MEAN_s movmean_tab;
+    uint8_t second_complete = FALSE;
+
+    DB_ReadBlock(&curr_tab, DATA_BLOCK_ID_CURRENT);
+
+    movmean_state.current.subblock_sum += MOVMEAN_Limit(curr_tab.current);
+    movmean_state.power.subblock_sum += MOVMEAN_Limit(curr_tab.power);
+    movmean_state.sample_cnt++;
+
+    if (movmean_state.sample_cnt >= MOVMEAN_SAMPLES_PER_SUBBLOCK) {
+        movmean_state.sample_cnt = 0;
+        second_complete = (movmean_state.subblock_idx == (MOVMEAN_SUBBLOCKS_PER_S - 1)) ? TRUE : FALSE;
+
+        MOVMEAN_CloseSubblock(&movmean_state.current, second_complete);
+        MOVMEAN_CloseSubblock(&movmean_state.power, second_complete);
+
+        if (movmean_state.subblocks_filled < MOVMEAN_SUBBLOCKS_PER_S) {
+            movmean_state.subblocks_filled++;
+        }
+        movmean_state.subblock_idx = (movmean_state.subblock_idx + 1) % MOVMEAN_SUBBLOCKS_PER_S;
+
+        if (second_complete == TRUE) {
+            if (movmean_state.seconds_filled < MOVMEAN_MAX_WINDOW_S) {
+                movmean_state.seconds_filled++;
+            }
+            movmean_state.second_idx = (movmean_state.second_idx + 1) % MOVMEAN_MAX_WINDOW_S;
+        }
+    }
+
+    movmean_state.publish_timer += MOVMEAN_SAMPLE_PERIOD_MS;
+    if (movmean_state.publish_timer >= MOVMEAN_PUBLISH_PERIOD_MS) {
+        movmean_state.publish_timer = 0;
+
+        DB_ReadBlock(&movmean_tab, DATA_BLOCK_ID_MOV_MEAN);
+        movmean_tab.movMean_current_1s = MOVMEAN_GetMean(&movmean_state.current, MOVMEAN_WINDOW_1S);
+        movmean_tab.movMean_current_5s = MOVMEAN_GetMean(&movmean_state.current, MOVMEAN_WINDOW_5S);
+        movmean_tab.movMean_current_10s = MOVMEAN_GetMean(&movmean_state.current, MOVMEAN_WINDOW_10S);
+        movmean_tab.movMean_current_30s = MOVMEAN_GetMean(&movmean_state.current, MOVMEAN_WINDOW_30S);
+        movmean_tab.movMean_current_60s = MOVMEAN_GetMean(&movmean_state.current, MOVMEAN_WINDOW_60S);
+        movmean_tab.movMean_current_config = MOVMEAN_GetMean(&movmean_state.current, MOVMEAN_WINDOW_CONFIG);
+        movmean_tab.movMean_power_1s = MOVMEAN_GetMean(&movmean_state.power, MOVMEAN_WINDOW_1S);
+        movmean_tab.movMean_power_5s = MOVMEAN_GetMean(&movmean_state.power, MOVMEAN_WINDOW_5S);
+        movmean_tab.movMean_power_10s = MOVMEAN_GetMean(&movmean_state.power, MOVMEAN_WINDOW_10S);
+        movmean_tab.movMean_power_30s = MOVMEAN_GetMean(&movmean_state.power, MOVMEAN_WINDOW_30S);
+        movmean_tab.movMean_power_60s = MOVMEAN_GetMean(&movmean_state.power, MOVMEAN_WINDOW_60S);
+        movmean_tab.movMean_power_config = MOVMEAN_GetMean(&movmean_state.power, MOVMEAN_WINDOW_CONFIG);
+
+        DB_WriteBlock(&movmean_tab, DATA_BLOCK_ID_MOV_MEAN);
+    }
+}
+
+
+/**
+ * @brief   limits and rounds a sample to an integer
+ *
+ * @param   value:  sample in mA or W
+ *
+ * @return  rounded sample, limited to +/- MOVMEAN_INPUT_LIMIT, 0 for NaN
+ */
+static int32_t MOVMEAN_Limit(float value) {
+    if (value != value) {
+        return 0;   // NaN, the conversion to int32_t would be undefined
+    } else if (value > MOVMEAN_INPUT_LIMIT) {
+        return MOVMEAN_INPUT_LIMIT;
+    } else if (value < -MOVMEAN_INPUT_LIMIT) {
+        return -MOVMEAN_INPUT_LIMIT;
+    } else if (value >= 0.0) {
+        return (int32_t)(value + 0.5);
+    } else {
+        return (int32_t)(value - 0.5);
+    }
+}
+
+
+/**
+ * @brief   stores the sum of the completed sub-block and updates the window sums
+ *
+ * @details The sub-blocks are aligned to the seconds, so at the end of a second the
+ *          running 1s sum is the sum of that second. It enters all windows, the second
+ *          that falls out of each window is read from the ring buffer before it is
+ *          overwritten. Not yet filled entries of the ring buffer are 0.
+ *
+ * @param   signal:             state of the signal
+ * @param   second_complete:    TRUE if the sub-block is the last of a second
+ */
+static void MOVMEAN_CloseSubblock(MOVMEAN_SIGNAL_s *signal, uint8_t second_complete) {
+    uint8_t idx = movmean_state.subblock_idx;
+    uint8_t sec = movmean_state.second_idx;
+    uint8_t w = 0;
+
+    signal->subwindow_sum += signal->subblock_sum - signal->subblocks[idx];
+    signal->subblocks[idx] = signal->subblock_sum;
+    signal->subblock_sum = 0;
+
+    if (second_complete == TRUE) {
+        /* the 1s window uses the sub-blocks, the other windows are moved in steps of 1s */
+        for (w = MOVMEAN_WINDOW_5S; w < MOVMEAN_NR_OF_WINDOWS; w++) {
+            signal->window_sum[w] += signal->subwindow_sum -
+                    signal->seconds[(sec + MOVMEAN_MAX_WINDOW_S - movmean_window_s[w]) % MOVMEAN_MAX_WINDOW_S];
+        }
+        signal->seconds[sec] = signal->subwindow_sum;
+    }
+}
+
+
+/**
+ * @brief   computes the mean of a window
+ *
+ * @param   signal: state of the signal
+ * @param   window: window
+ *
+ * @return  mean over the window, or over the available data if the window is not yet filled
+ */
+static int32_t MOVMEAN_GetMean(const MOVMEAN_SIGNAL_s *signal, MOVMEAN_WINDOW_e window) {
+    uint32_t nr_of_seconds = 0;
+
+    if ((window == MOVMEAN_WINDOW_1S) || (movmean_state.seconds_filled == 0)) {
+        if (movmean_state.subblocks_filled == 0) {
+            return 0;
+        }
+        return signal->subwindow_sum / (int32_t)(movmean_state.subblocks_filled * MOVMEAN_SAMPLES_PER_SUBBLOCK);
+    }
+
+    nr_of_seconds = movmean_window_s[window];
+    if (movmean_state.seconds_filled < nr_of_seconds) {
+        nr_of_seconds = movmean_state.seconds_filled;
+    }
+    return (int32_t)(signal->window_sum[window] /
+            (int64_t)(nr_of_seconds * MOVMEAN_SUBBLOCKS_PER_S * MOVMEAN_SAMPLES_PER_SUBBLOCK));
+}
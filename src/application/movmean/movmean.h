@@ -0,0 +1,110 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    movmean.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  MOVMEAN
+ *
+ * @brief   Moving mean of current and power over sliding windows
+ *
+ * Fills DATA_BLOCK_MOVING_MEAN_s with the means over 1s, 5s, 10s, 30s, 60s and
+ * MOVMEAN_CONFIG_WINDOW_S. The samples are summed up in sub-blocks, the sub-block
+ * sums in 1s sums, the 1s sums are kept in a ring buffer. Every window keeps a
+ * running sum that is corrected by the entering and the leaving 1s sum, so each
+ * sample costs O(1) and the memory does not depend on the sample rate.
+ */
+
+#ifndef MOVMEAN_H_
+#define MOVMEAN_H_
+
+/*================== Includes =============================================*/
+#include "movmean_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * number of sub-blocks per second
+ */
+#define MOVMEAN_SUBBLOCKS_PER_S         (1000 / MOVMEAN_SUBBLOCK_MS)
+
+/**
+ * number of samples per sub-block
+ */
+#define MOVMEAN_SAMPLES_PER_SUBBLOCK    (MOVMEAN_SUBBLOCK_MS / MOVMEAN_SAMPLE_PERIOD_MS)
+
+/**
+ * windows of DATA_BLOCK_MOVING_MEAN_s
+ */
+typedef enum {
+    MOVMEAN_WINDOW_1S       = 0,
+    MOVMEAN_WINDOW_5S       = 1,
+    MOVMEAN_WINDOW_10S      = 2,
+    MOVMEAN_WINDOW_30S      = 3,
+    MOVMEAN_WINDOW_60S      = 4,
+    MOVMEAN_WINDOW_CONFIG   = 5,
+    MOVMEAN_NR_OF_WINDOWS   = 6,
+} MOVMEAN_WINDOW_e;
+
+/**
+ * state of the moving means of one signal
+ */
+typedef struct {
+    int32_t subblock_sum;                           /*!< sum of the running sub-block                        */
+    int32_t subblocks[MOVMEAN_SUBBLOCKS_PER_S];     /*!< sums of the last sub-blocks                         */
+    int32_t subwindow_sum;                          /*!< running sum over subblocks[] (1s window)            */
+    int32_t seconds[MOVMEAN_MAX_WINDOW_S];          /*!< ring buffer of the 1s sums                          */
+    int64_t window_sum[MOVMEAN_NR_OF_WINDOWS];      /*!< running sums of the windows (not used for 1s)       */
+} MOVMEAN_SIGNAL_s;
+
+/**
+ * state of the moving mean module
+ */
+typedef struct {
+    MOVMEAN_SIGNAL_s current;       /*!< current in mA          */
+    MOVMEAN_SIGNAL_s power;         /*!< power in W             */
+    uint16_t sample_cnt;            /*!< samples in the running sub-block                           */
+    uint8_t subblock_idx;           /*!< next entry of subblocks[]                                  */
+    uint8_t subblocks_filled;       /*!< number of valid entries in subblocks[]                     */
+    uint8_t second_idx;             /*!< next entry of seconds[]                                    */
+    uint8_t seconds_filled;         /*!< number of valid entries in seconds[]                       */
+    uint16_t publish_timer;         /*!< time since the last write of the database block in ms      */
+} MOVMEAN_STATE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   adds the present current and power to the moving means
+ *
+ * @details Must be called every MOVMEAN_SAMPLE_PERIOD_MS. Writes DATA_BLOCK_ID_MOV_MEAN
+ *          every MOVMEAN_PUBLISH_PERIOD_MS. As long as a window is not completely
+ *          filled, the mean over the available data is published.
+ */
+extern void MOVMEAN_Trigger(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* MOVMEAN_H_ */
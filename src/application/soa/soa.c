@@ -0,0 +1,141 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    soa.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Per-cell safe operating area checks
+ *
+ * Thermal equivalent of the battery current (I2t) as first order lag of the
+ * squared current, in 64bit fixed-point.
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "soa.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * current samples are limited to this value to keep the I2t arithmetic within 64bit
+ */
+#define SOA_I2T_MAX_CURRENT_MA  (1000000U)
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * state of the I2t curves
+ */
+static SOA_I2T_STATE_s soa_i2t_state[SOA_I2T_NR_OF_CURVES];
+
+/*================== Function Prototypes ==================================*/
+
+static void SOA_I2tFilter(uint64_t *state, uint64_t square, uint32_t alpha);
+
+/*================== Function Implementations =============================*/
+
+uint8_t SOA_I2tUpdate(float current_mA, uint32_t elapsed_ms) {
+    uint64_t discharge = 0;
+    uint64_t charge = 0;
+    uint64_t limit = 0;
+    uint32_t current = 0;
+    uint32_t alpha = 0;
+    float abs_current = (current_mA >= 0.0) ? current_mA : -current_mA;
+    uint8_t retval = 0;
+    uint8_t i = 0;
+
+    current = (abs_current < (float)SOA_I2T_MAX_CURRENT_MA) ? (uint32_t)abs_current : SOA_I2T_MAX_CURRENT_MA;
+    if (current_mA >= 0.0) {
+        discharge = (uint64_t)current * current;
+    } else {
+        charge = (uint64_t)current * current;
+    }
+
+    for (i = 0; i < SOA_I2T_NR_OF_CURVES; i++) {
+        /* alpha * dt, at most 1 (the filter output follows the input completely) */
+        if (elapsed_ms >= ((1UL << SOA_I2T_ALPHA_SHIFT) / soa_i2t_curves[i].alpha)) {
+            alpha = 1UL << SOA_I2T_ALPHA_SHIFT;
+        } else {
+            alpha = soa_i2t_curves[i].alpha * elapsed_ms;
+        }
+        SOA_I2tFilter(&soa_i2t_state[i].discharge, discharge, alpha);
+        SOA_I2tFilter(&soa_i2t_state[i].charge, charge, alpha);
+
+        limit = (uint64_t)soa_i2t_curves[i].limit_discharge_mA * soa_i2t_curves[i].limit_discharge_mA;
+        if (soa_i2t_state[i].discharge > limit) {
+            retval |= SOA_I2T_DISCHARGE;
+        }
+        limit = (uint64_t)soa_i2t_curves[i].limit_charge_mA * soa_i2t_curves[i].limit_charge_mA;
+        if (soa_i2t_state[i].charge > limit) {
+            retval |= SOA_I2T_CHARGE;
+        }
+    }
+
+    return retval;
+}
+
+
+uint16_t SOA_I2tGetLoad(uint8_t curve, uint8_t charge) {
+    uint64_t state = 0;
+    uint64_t limit = 0;
+
+    if (curve >= SOA_I2T_NR_OF_CURVES) {
+        return 0;
+    }
+
+    if (charge == TRUE) {
+        state = soa_i2t_state[curve].charge;
+        limit = (uint64_t)soa_i2t_curves[curve].limit_charge_mA * soa_i2t_curves[curve].limit_charge_mA;
+    } else {
+        state = soa_i2t_state[curve].discharge;
+        limit = (uint64_t)soa_i2t_curves[curve].limit_discharge_mA * soa_i2t_curves[curve].limit_discharge_mA;
+    }
+
+    if (limit == 0) {
+        return 0;
+    }
+    state = (state / (limit / 100 + 1));
+    return (state > UINT16_MAX) ? UINT16_MAX : (uint16_t)state;
+}
+
+
+/**
+ * @brief   first order lag of the squared current in fixed-point
+ *
+ * @details The difference is below 2^40 (current limited to SOA_I2T_MAX_CURRENT_MA),
+ *          alpha at most 2^24, so the product fits into 64bit.
+ *
+ * @param   state:  filtered value in mA^2
+ * @param   square: squared current sample in mA^2
+ * @param   alpha:  filter coefficient in Q24
+ */
+static void SOA_I2tFilter(uint64_t *state, uint64_t square, uint32_t alpha) {
+    if (square >= *state) {
+        *state += ((square - *state) * alpha) >> SOA_I2T_ALPHA_SHIFT;
+    } else {
+        *state -= ((*state - square) * alpha) >> SOA_I2T_ALPHA_SHIFT;
+    }
+}
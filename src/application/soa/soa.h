@@ -0,0 +1,98 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    soa.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Per-cell safe operating area checks
+ *
+ * Integrates the thermal equivalent of the battery current (I2t). The per-cell
+ * checks (soa_dsp.c), the plausibility checks (soa_plausibility.c) and the
+ * current derating (soa_derating.c) are declared in their own headers, which
+ * are included here.
+ */
+
+#ifndef SOA_H_
+#define SOA_H_
+
+/*================== Includes =============================================*/
+#include "soa_cfg.h"
+
+#include "database.h"
+#include "soa_derating.h"
+#include "soa_dsp.h"
+#include "soa_plausibility.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * return value bits of SOA_I2tUpdate()
+ */
+#define SOA_I2T_DISCHARGE       (0x01)  /*!< at least one discharge I2t curve violated */
+#define SOA_I2T_CHARGE          (0x02)  /*!< at least one charge I2t curve violated    */
+
+/**
+ * state of one I2t curve
+ */
+typedef struct {
+    uint64_t discharge;     /*!< filtered squared discharge current in mA^2 */
+    uint64_t charge;        /*!< filtered squared charge current in mA^2    */
+} SOA_I2T_STATE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   integrates one current sample into all I2t curves
+ *
+ * @details Constant time and memory per curve:
+ *          x += ((I^2 - x) * alpha * dt) >> SOA_I2T_ALPHA_SHIFT, in 64bit fixed-point.
+ *          The sample is held for the elapsed time dt, which should be small compared
+ *          to the shortest time constant (1ms in the cyclic BMS_Trigger()).
+ *          Discharge and charge are filtered separately, each with the squared current
+ *          of its direction (0 for the other direction).
+ *
+ * @param   current_mA: battery current in mA, positive for discharge
+ * @param   elapsed_ms: time since the previous call in ms
+ *
+ * @return  SOA_I2T_DISCHARGE and/or SOA_I2T_CHARGE if a curve is violated, otherwise 0
+ */
+extern uint8_t SOA_I2tUpdate(float current_mA, uint32_t elapsed_ms);
+
+/**
+ * @brief   returns the thermal equivalent load of a curve
+ *
+ * @param   curve:  index in soa_i2t_curves[]
+ * @param   charge: TRUE for the charge, FALSE for the discharge direction
+ *
+ * @return  filtered squared current in percent of the squared limit (100 = limit)
+ */
+extern uint16_t SOA_I2tGetLoad(uint8_t curve, uint8_t charge);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOA_H_ */
@@ -0,0 +1,161 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    soa_derating.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Dynamic current limits from the derating tables
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "soa_derating.h"
+
+#include "batterycell_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+static uint16_t SOA_SocToFixed(float soc, uint16_t invalid);
+
+/*================== Function Implementations =============================*/
+
+uint16_t SOA_DeratingLookup(const uint16_t table[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS],
+                            int16_t temperature, uint16_t soc) {
+    int32_t t = (int32_t)temperature - SOA_DERATING_TEMPERATURE_MIN;
+    uint32_t s = soc;
+    uint32_t it = 0;
+    uint32_t is = 0;
+    int32_t ft = 0;
+    int32_t fs = 0;
+    int32_t v0 = 0;
+    int32_t v1 = 0;
+    const uint16_t *row0 = NULL_PTR;
+    const uint16_t *row1 = NULL_PTR;
+
+    /* index of the lower axis point and Q15 fraction towards the upper one */
+    if (t <= 0) {
+        it = 0;
+        ft = 0;
+    } else if (t >= (SOA_DERATING_NR_OF_TEMPERATURES - 1) * SOA_DERATING_TEMPERATURE_STEP) {
+        it = SOA_DERATING_NR_OF_TEMPERATURES - 2;
+        ft = SOA_DERATING_ONE;
+    } else {
+        it = (uint32_t)t / SOA_DERATING_TEMPERATURE_STEP;
+        ft = (int32_t)((((uint32_t)t - it * SOA_DERATING_TEMPERATURE_STEP) << 15) / SOA_DERATING_TEMPERATURE_STEP);
+    }
+    if (s >= (SOA_DERATING_NR_OF_SOCS - 1) * SOA_DERATING_SOC_STEP) {
+        is = SOA_DERATING_NR_OF_SOCS - 2;
+        fs = SOA_DERATING_ONE;
+    } else {
+        is = s / SOA_DERATING_SOC_STEP;
+        fs = (int32_t)(((s - is * SOA_DERATING_SOC_STEP) << 15) / SOA_DERATING_SOC_STEP);
+    }
+
+    /* differences are at most 2^15, fractions at most 2^15: products fit into 32bit */
+    row0 = &table[it][is];
+    row1 = &table[it + 1][is];
+    v0 = row0[0] + (((row0[1] - row0[0]) * fs) >> 15);
+    v1 = row1[0] + (((row1[1] - row1[0]) * fs) >> 15);
+    return (uint16_t)(v0 + (((v1 - v0) * ft) >> 15));
+}
+
+
+float SOA_DeratingLookup_Ref(const uint16_t table[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS],
+                             float temperature, float soc) {
+    float t = (temperature - SOA_DERATING_TEMPERATURE_MIN) / SOA_DERATING_TEMPERATURE_STEP;
+    float s = soc / SOA_DERATING_SOC_STEP;
+    uint32_t it = 0;
+    uint32_t is = 0;
+    float v0 = 0.0;
+    float v1 = 0.0;
+
+    if (t < 0.0) {
+        t = 0.0;
+    } else if (t > (SOA_DERATING_NR_OF_TEMPERATURES - 1)) {
+        t = SOA_DERATING_NR_OF_TEMPERATURES - 1;
+    }
+    if (s < 0.0) {
+        s = 0.0;
+    } else if (s > (SOA_DERATING_NR_OF_SOCS - 1)) {
+        s = SOA_DERATING_NR_OF_SOCS - 1;
+    }
+    it = (t >= (SOA_DERATING_NR_OF_TEMPERATURES - 1)) ? (SOA_DERATING_NR_OF_TEMPERATURES - 2) : (uint32_t)t;
+    is = (s >= (SOA_DERATING_NR_OF_SOCS - 1)) ? (SOA_DERATING_NR_OF_SOCS - 2) : (uint32_t)s;
+    t -= it;
+    s -= is;
+
+    v0 = table[it][is] + (table[it][is + 1] - (float)table[it][is]) * s;
+    v1 = table[it + 1][is] + (table[it + 1][is + 1] - (float)table[it + 1][is]) * s;
+    return v0 + (v1 - v0) * t;
+}
+
+
+void SOA_CalcCurrentLimits(const DATA_BLOCK_MINMAX_s *minmax, const DATA_BLOCK_SOX_s *sox,
+                           SOA_CURRENT_LIMITS_s *limits) {
+    uint16_t soc_min = SOA_SocToFixed(sox->soc_min, 0);        // most restrictive for discharge
+    uint16_t soc_max = SOA_SocToFixed(sox->soc_max, 10000);    // most restrictive for charge
+    uint16_t factor = 0;
+    uint16_t factor_hot = 0;
+
+    factor = SOA_DeratingLookup(soa_derating_discharge, minmax->temperature_min, soc_min);
+    factor_hot = SOA_DeratingLookup(soa_derating_discharge, minmax->temperature_max, soc_min);
+    if (factor_hot < factor) {
+        factor = factor_hot;
+    }
+    limits->discharge_mA = (uint32_t)(((uint64_t)BC_CURRENTMAX_DISCHARGE * factor) >> 15);
+
+    factor = SOA_DeratingLookup(soa_derating_charge, minmax->temperature_min, soc_max);
+    factor_hot = SOA_DeratingLookup(soa_derating_charge, minmax->temperature_max, soc_max);
+    if (factor_hot < factor) {
+        factor = factor_hot;
+    }
+    limits->charge_mA = (uint32_t)(((uint64_t)BC_CURRENTMAX_CHARGE * factor) >> 15);
+}
+
+
+/**
+ * @brief   converts a SOC of the database to the fixed-point input of SOA_DeratingLookup()
+ *
+ * @param   soc:        SOC in %
+ * @param   invalid:    value returned if soc is not a number
+ *
+ * @return  SOC in 0.01%, limited to 0..100%
+ */
+static uint16_t SOA_SocToFixed(float soc, uint16_t invalid) {
+    if (soc != soc) {
+        return invalid;
+    } else if (soc <= 0.0) {
+        return 0;
+    } else if (soc >= 100.0) {
+        return 10000;
+    }
+    return (uint16_t)(soc * 100.0);
+}
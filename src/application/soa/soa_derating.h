@@ -0,0 +1,100 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    soa_derating.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Dynamic current limits from the derating tables
+ *
+ * Bilinear interpolation of the derating factors over temperature and SOC,
+ * scaling the maximum discharge and charge currents of the battery cell.
+ * The limits are only enforced with BMS_TEST_CELL_SOF_LIMITS (default FALSE),
+ * otherwise they are not evaluated. The fixed-point lookup is compared with
+ * SOA_DeratingLookup_Ref() in tests/host/test_soa_derating.c.
+ */
+
+#ifndef SOA_DERATING_H_
+#define SOA_DERATING_H_
+
+/*================== Includes =============================================*/
+#include "soa_cfg.h"
+
+#include "database.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * dynamic current limits from the derating tables
+ */
+typedef struct {
+    uint32_t discharge_mA;  /*!< maximum discharge current in mA */
+    uint32_t charge_mA;     /*!< maximum charge current in mA    */
+} SOA_CURRENT_LIMITS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   bilinear interpolation in a derating table, fixed-point
+ *
+ * @details Both axes are equidistant, so the indices and the Q15 fractions are computed
+ *          without search (the divisions by the constant steps become multiplications).
+ *          Inputs outside the table are clamped to the border.
+ *
+ * @param   table:          derating factors in Q15, e.g. soa_derating_discharge
+ * @param   temperature:    temperature in degree Celsius
+ * @param   soc:            SOC in 0.01%
+ *
+ * @return  derating factor in Q15 (SOA_DERATING_ONE = 1.0)
+ */
+extern uint16_t SOA_DeratingLookup(const uint16_t table[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS],
+                                   int16_t temperature, uint16_t soc);
+
+/**
+ * @brief   floating point reference of SOA_DeratingLookup(), used to verify the fixed-point version
+ */
+extern float SOA_DeratingLookup_Ref(const uint16_t table[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS],
+                                    float temperature, float soc);
+
+/**
+ * @brief   computes the dynamic discharge and charge current limits
+ *
+ * @details The tables are evaluated at the minimum and at the maximum cell temperature, the
+ *          lower factor is taken. Discharge uses the minimum SOC, charge the maximum SOC. The
+ *          factors scale BC_CURRENTMAX_DISCHARGE and BC_CURRENTMAX_CHARGE.
+ *
+ * @param   minmax: minimum and maximum cell temperatures
+ * @param   sox:    minimum and maximum SOC
+ * @param   limits: pointer where the limits are written to
+ */
+extern void SOA_CalcCurrentLimits(const DATA_BLOCK_MINMAX_s *minmax, const DATA_BLOCK_SOX_s *sox,
+                                  SOA_CURRENT_LIMITS_s *limits);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOA_DERATING_H_ */
@@ -0,0 +1,674 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    soa_dsp.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Per-cell limit checks, min/max and module sums of the raw cell data
+ *
+ * The DSP implementation compares two 16bit values per instruction: USUB16/SSUB16
+ * set the GE flags of both halfwords, SEL turns the flags into one bit per cell
+ * without branches. The same instruction pair gives a packed minimum/maximum for
+ * the min/max calculation. The reference implementations produce identical results
+ * (tests/host/test_soa_dsp.c).
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "soa_dsp.h"
+
+#include <string.h>
+#include "batterysystem_cfg.h"
+#include "stm32f4xx_hal.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * TRUE if the packed 16bit instructions are available and enabled
+ */
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1) && (SOA_USE_DSP_INSTRUCTIONS == TRUE)
+#define SOA_DSP_AVAILABLE       TRUE
+#else
+#define SOA_DSP_AVAILABLE       FALSE
+#endif
+
+/**
+ * value selected by SEL for a halfword with violated limit: bit 0 in the low and
+ * bit 1 in the high halfword, folded by SOA_FOLD_PAIR() into two adjacent mask bits
+ */
+#define SOA_PAIR_BITS           (0x00020001U)
+
+#define SOA_FOLD_PAIR(r)        (((r) | ((r) >> 16)) & 0x3U)
+
+/**
+ * number of 16bit pairs per block of the min/max calculation (16 cells)
+ */
+#define SOA_MINMAX_BLOCK_PAIRS  (8)
+
+/*================== Constant and Variable Definitions ====================*/
+
+#if SOA_BENCHMARK_ENABLE == TRUE
+SOA_BENCHMARK_s soa_benchmark[SOA_BENCHMARK_NR_OF_SIZES];
+
+static uint8_t soa_benchmark_done = FALSE;
+static uint16_t soa_bench_voltage[SOA_BENCHMARK_MAX_CELLS];
+static int16_t soa_bench_temperature[SOA_BENCHMARK_MAX_CELLS];
+static uint32_t soa_bench_under[2][SOA_MASK_WORDS(SOA_BENCHMARK_MAX_CELLS)];
+static uint32_t soa_bench_over[2][SOA_MASK_WORDS(SOA_BENCHMARK_MAX_CELLS)];
+static DATA_BLOCK_MINMAX_s soa_bench_minmax[2];
+#endif
+
+/*================== Function Prototypes ==================================*/
+
+#if SOA_DSP_AVAILABLE == TRUE
+static inline uint32_t SOA_LoadPair(const void *src);
+#endif
+static void SOA_SetVoltageIndices(DATA_BLOCK_MINMAX_s *minmax, uint16_t min_idx, uint16_t max_idx, uint16_t cells_per_module);
+static void SOA_SetTemperatureIndices(DATA_BLOCK_MINMAX_s *minmax, uint16_t min_idx, uint16_t max_idx, uint16_t sensors_per_module);
+#if SOA_BENCHMARK_ENABLE == TRUE
+static uint8_t SOA_MasksEqual(uint16_t nr);
+static uint8_t SOA_MinMaxEqual(void);
+#endif
+
+/*================== Function Implementations =============================*/
+
+uint8_t SOA_CheckVoltages(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t min, uint16_t max,
+                          uint32_t *undermask, uint32_t *overmask) {
+#if SOA_DSP_AVAILABLE == TRUE
+    uint32_t minpair = ((uint32_t)min << 16) | min;
+    uint32_t maxpair = ((uint32_t)max << 16) | max;
+    uint32_t under = 0;
+    uint32_t over = 0;
+    uint32_t anyunder = 0;
+    uint32_t anyover = 0;
+    uint32_t w = 0;
+    uint32_t r = 0;
+    uint16_t nr_of_pairs = nr_of_cells / 2;
+    uint16_t i = 0;
+
+    for (i = 0; i < nr_of_pairs; i++) {
+        w = SOA_LoadPair(&voltage[2 * i]);
+        /* GE set for v >= min, SEL marks the cells below min */
+        (void)__USUB16(w, minpair);
+        r = __SEL(0U, SOA_PAIR_BITS);
+        under |= SOA_FOLD_PAIR(r) << ((i % 16) * 2);
+
+        /* GE set for max >= v, SEL marks the cells above max */
+        (void)__USUB16(maxpair, w);
+        r = __SEL(0U, SOA_PAIR_BITS);
+        over |= SOA_FOLD_PAIR(r) << ((i % 16) * 2);
+
+        if ((i % 16) == 15) {
+            undermask[i / 16] = under;
+            overmask[i / 16] = over;
+            anyunder |= under;
+            anyover |= over;
+            under = 0;
+            over = 0;
+        }
+    }
+
+    if ((nr_of_cells % 2) != 0) {
+        if (voltage[nr_of_cells - 1] < min) {
+            under |= 1U << ((nr_of_cells - 1) % 32);
+        }
+        if (voltage[nr_of_cells - 1] > max) {
+            over |= 1U << ((nr_of_cells - 1) % 32);
+        }
+    }
+
+    if ((nr_of_cells % 32) != 0) {
+        undermask[nr_of_cells / 32] = under;
+        overmask[nr_of_cells / 32] = over;
+        anyunder |= under;
+        anyover |= over;
+    }
+
+    return ((anyunder != 0) ? SOA_VIOLATION_UNDER : 0) | ((anyover != 0) ? SOA_VIOLATION_OVER : 0);
+#else
+    return SOA_CheckVoltages_Ref(voltage, nr_of_cells, min, max, undermask, overmask);
+#endif
+}
+
+
+uint8_t SOA_CheckTemperatures(const int16_t *temperature, uint16_t nr_of_sensors, int16_t min, int16_t max,
+                              uint32_t *undermask, uint32_t *overmask) {
+#if SOA_DSP_AVAILABLE == TRUE
+    uint32_t minpair = ((uint32_t)(uint16_t)min << 16) | (uint16_t)min;
+    uint32_t maxpair = ((uint32_t)(uint16_t)max << 16) | (uint16_t)max;
+    uint32_t under = 0;
+    uint32_t over = 0;
+    uint32_t anyunder = 0;
+    uint32_t anyover = 0;
+    uint32_t w = 0;
+    uint32_t r = 0;
+    uint16_t nr_of_pairs = nr_of_sensors / 2;
+    uint16_t i = 0;
+
+    for (i = 0; i < nr_of_pairs; i++) {
+        w = SOA_LoadPair(&temperature[2 * i]);
+        /* signed: GE set for t >= min, SEL marks the sensors below min */
+        (void)__SSUB16(w, minpair);
+        r = __SEL(0U, SOA_PAIR_BITS);
+        under |= SOA_FOLD_PAIR(r) << ((i % 16) * 2);
+
+        /* signed: GE set for max >= t, SEL marks the sensors above max */
+        (void)__SSUB16(maxpair, w);
+        r = __SEL(0U, SOA_PAIR_BITS);
+        over |= SOA_FOLD_PAIR(r) << ((i % 16) * 2);
+
+        if ((i % 16) == 15) {
+            undermask[i / 16] = under;
+            overmask[i / 16] = over;
+            anyunder |= under;
+            anyover |= over;
+            under = 0;
+            over = 0;
+        }
+    }
+
+    if ((nr_of_sensors % 2) != 0) {
+        if (temperature[nr_of_sensors - 1] < min) {
+            under |= 1U << ((nr_of_sensors - 1) % 32);
+        }
+        if (temperature[nr_of_sensors - 1] > max) {
+            over |= 1U << ((nr_of_sensors - 1) % 32);
+        }
+    }
+
+    if ((nr_of_sensors % 32) != 0) {
+        undermask[nr_of_sensors / 32] = under;
+        overmask[nr_of_sensors / 32] = over;
+        anyunder |= under;
+        anyover |= over;
+    }
+
+    return ((anyunder != 0) ? SOA_VIOLATION_UNDER : 0) | ((anyover != 0) ? SOA_VIOLATION_OVER : 0);
+#else
+    return SOA_CheckTemperatures_Ref(temperature, nr_of_sensors, min, max, undermask, overmask);
+#endif
+}
+
+
+uint8_t SOA_CheckVoltages_Ref(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t min, uint16_t max,
+                              uint32_t *undermask, uint32_t *overmask) {
+    uint8_t retval = 0;
+    uint16_t i = 0;
+
+    for (i = 0; i < SOA_MASK_WORDS(nr_of_cells); i++) {
+        undermask[i] = 0;
+        overmask[i] = 0;
+    }
+
+    for (i = 0; i < nr_of_cells; i++) {
+        if (voltage[i] < min) {
+            undermask[i / 32] |= 1U << (i % 32);
+            retval |= SOA_VIOLATION_UNDER;
+        }
+        if (voltage[i] > max) {
+            overmask[i / 32] |= 1U << (i % 32);
+            retval |= SOA_VIOLATION_OVER;
+        }
+    }
+
+    return retval;
+}
+
+
+uint8_t SOA_CheckTemperatures_Ref(const int16_t *temperature, uint16_t nr_of_sensors, int16_t min, int16_t max,
+                                  uint32_t *undermask, uint32_t *overmask) {
+    uint8_t retval = 0;
+    uint16_t i = 0;
+
+    for (i = 0; i < SOA_MASK_WORDS(nr_of_sensors); i++) {
+        undermask[i] = 0;
+        overmask[i] = 0;
+    }
+
+    for (i = 0; i < nr_of_sensors; i++) {
+        if (temperature[i] < min) {
+            undermask[i / 32] |= 1U << (i % 32);
+            retval |= SOA_VIOLATION_UNDER;
+        }
+        if (temperature[i] > max) {
+            overmask[i / 32] |= 1U << (i % 32);
+            retval |= SOA_VIOLATION_OVER;
+        }
+    }
+
+    return retval;
+}
+
+void SOA_CalcVoltageMinMax(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t cells_per_module,
+                           DATA_BLOCK_MINMAX_s *minmax) {
+#if SOA_DSP_AVAILABLE == TRUE
+    uint32_t vmin = 0;
+    uint32_t vmax = 0;
+    uint32_t w = 0;
+    uint32_t sum = 0;
+    uint16_t min = 0xFFFF;
+    uint16_t max = 0;
+    uint16_t lo = 0;
+    uint16_t hi = 0;
+    uint16_t min_idx = 0;
+    uint16_t max_idx = 0;
+    uint16_t nr_of_blocks = nr_of_cells / (2 * SOA_MINMAX_BLOCK_PAIRS);
+    uint16_t b = 0;
+    uint16_t k = 0;
+    uint16_t i = 0;
+
+    for (b = 0; b < nr_of_blocks; b++) {
+        vmin = SOA_LoadPair(&voltage[b * 2 * SOA_MINMAX_BLOCK_PAIRS]);
+        vmax = vmin;
+        sum += (vmin & 0xFFFFU) + (vmin >> 16);
+        for (k = 1; k < SOA_MINMAX_BLOCK_PAIRS; k++) {
+            w = SOA_LoadPair(&voltage[(b * SOA_MINMAX_BLOCK_PAIRS + k) * 2]);
+            sum += (w & 0xFFFFU) + (w >> 16);
+            /* GE set for w >= vmin: keep vmin, otherwise take w */
+            (void)__USUB16(w, vmin);
+            vmin = __SEL(vmin, w);
+            /* GE set for w >= vmax: take w, otherwise keep vmax */
+            (void)__USUB16(w, vmax);
+            vmax = __SEL(w, vmax);
+        }
+
+        /* only remember the first block that contains a new extremum */
+        lo = (uint16_t)vmin;
+        hi = (uint16_t)(vmin >> 16);
+        lo = (hi < lo) ? hi : lo;
+        if (lo < min) {
+            min = lo;
+            min_idx = b * 2 * SOA_MINMAX_BLOCK_PAIRS;
+        }
+        lo = (uint16_t)vmax;
+        hi = (uint16_t)(vmax >> 16);
+        lo = (hi > lo) ? hi : lo;
+        if (lo > max) {
+            max = lo;
+            max_idx = b * 2 * SOA_MINMAX_BLOCK_PAIRS;
+        }
+    }
+
+    for (i = nr_of_blocks * 2 * SOA_MINMAX_BLOCK_PAIRS; i < nr_of_cells; i++) {
+        sum += voltage[i];
+        if (voltage[i] < min) {
+            min = voltage[i];
+            min_idx = i;
+        }
+        if (voltage[i] > max) {
+            max = voltage[i];
+            max_idx = i;
+        }
+    }
+
+    /* search the extremum inside its block, at most 15 steps */
+    while (voltage[min_idx] != min) {
+        min_idx++;
+    }
+    while (voltage[max_idx] != max) {
+        max_idx++;
+    }
+
+    minmax->voltage_min = min;
+    minmax->voltage_max = max;
+    minmax->voltage_mean = sum / nr_of_cells;
+    SOA_SetVoltageIndices(minmax, min_idx, max_idx, cells_per_module);
+#else
+    SOA_CalcVoltageMinMax_Ref(voltage, nr_of_cells, cells_per_module, minmax);
+#endif
+}
+
+
+void SOA_CalcTemperatureMinMax(const int16_t *temperature, uint16_t nr_of_sensors, uint16_t sensors_per_module,
+                               DATA_BLOCK_MINMAX_s *minmax) {
+#if SOA_DSP_AVAILABLE == TRUE
+    uint32_t vmin = 0;
+    uint32_t vmax = 0;
+    uint32_t w = 0;
+    int32_t sum = 0;
+    int16_t min = INT16_MAX;
+    int16_t max = INT16_MIN;
+    int16_t lo = 0;
+    int16_t hi = 0;
+    uint16_t min_idx = 0;
+    uint16_t max_idx = 0;
+    uint16_t nr_of_blocks = nr_of_sensors / (2 * SOA_MINMAX_BLOCK_PAIRS);
+    uint16_t b = 0;
+    uint16_t k = 0;
+    uint16_t i = 0;
+
+    for (b = 0; b < nr_of_blocks; b++) {
+        vmin = SOA_LoadPair(&temperature[b * 2 * SOA_MINMAX_BLOCK_PAIRS]);
+        vmax = vmin;
+        /* signed sum of both halfwords */
+        sum = (int32_t)__SMLAD(vmin, 0x00010001U, (uint32_t)sum);
+        for (k = 1; k < SOA_MINMAX_BLOCK_PAIRS; k++) {
+            w = SOA_LoadPair(&temperature[(b * SOA_MINMAX_BLOCK_PAIRS + k) * 2]);
+            sum = (int32_t)__SMLAD(w, 0x00010001U, (uint32_t)sum);
+            /* signed: GE set for w >= vmin: keep vmin, otherwise take w */
+            (void)__SSUB16(w, vmin);
+            vmin = __SEL(vmin, w);
+            /* signed: GE set for w >= vmax: take w, otherwise keep vmax */
+            (void)__SSUB16(w, vmax);
+            vmax = __SEL(w, vmax);
+        }
+
+        lo = (int16_t)vmin;
+        hi = (int16_t)(vmin >> 16);
+        lo = (hi < lo) ? hi : lo;
+        if (lo < min) {
+            min = lo;
+            min_idx = b * 2 * SOA_MINMAX_BLOCK_PAIRS;
+        }
+        lo = (int16_t)vmax;
+        hi = (int16_t)(vmax >> 16);
+        lo = (hi > lo) ? hi : lo;
+        if (lo > max) {
+            max = lo;
+            max_idx = b * 2 * SOA_MINMAX_BLOCK_PAIRS;
+        }
+    }
+
+    for (i = nr_of_blocks * 2 * SOA_MINMAX_BLOCK_PAIRS; i < nr_of_sensors; i++) {
+        sum += temperature[i];
+        if (temperature[i] < min) {
+            min = temperature[i];
+            min_idx = i;
+        }
+        if (temperature[i] > max) {
+            max = temperature[i];
+            max_idx = i;
+        }
+    }
+
+    while (temperature[min_idx] != min) {
+        min_idx++;
+    }
+    while (temperature[max_idx] != max) {
+        max_idx++;
+    }
+
+    minmax->temperature_min = min;
+    minmax->temperature_max = max;
+    minmax->temperature_mean = sum / nr_of_sensors;
+    SOA_SetTemperatureIndices(minmax, min_idx, max_idx, sensors_per_module);
+#else
+    SOA_CalcTemperatureMinMax_Ref(temperature, nr_of_sensors, sensors_per_module, minmax);
+#endif
+}
+
+
+void SOA_CalcVoltageMinMax_Ref(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t cells_per_module,
+                               DATA_BLOCK_MINMAX_s *minmax) {
+    uint32_t sum = 0;
+    uint16_t min_idx = 0;
+    uint16_t max_idx = 0;
+    uint16_t i = 0;
+
+    for (i = 0; i < nr_of_cells; i++) {
+        sum += voltage[i];
+        if (voltage[i] < voltage[min_idx]) {
+            min_idx = i;
+        }
+        if (voltage[i] > voltage[max_idx]) {
+            max_idx = i;
+        }
+    }
+
+    minmax->voltage_min = voltage[min_idx];
+    minmax->voltage_max = voltage[max_idx];
+    minmax->voltage_mean = sum / nr_of_cells;
+    SOA_SetVoltageIndices(minmax, min_idx, max_idx, cells_per_module);
+}
+
+
+void SOA_CalcTemperatureMinMax_Ref(const int16_t *temperature, uint16_t nr_of_sensors, uint16_t sensors_per_module,
+                                   DATA_BLOCK_MINMAX_s *minmax) {
+    int32_t sum = 0;
+    uint16_t min_idx = 0;
+    uint16_t max_idx = 0;
+    uint16_t i = 0;
+
+    for (i = 0; i < nr_of_sensors; i++) {
+        sum += temperature[i];
+        if (temperature[i] < temperature[min_idx]) {
+            min_idx = i;
+        }
+        if (temperature[i] > temperature[max_idx]) {
+            max_idx = i;
+        }
+    }
+
+    minmax->temperature_min = temperature[min_idx];
+    minmax->temperature_max = temperature[max_idx];
+    minmax->temperature_mean = sum / nr_of_sensors;
+    SOA_SetTemperatureIndices(minmax, min_idx, max_idx, sensors_per_module);
+}
+
+
+void SOA_CalcModuleSums(const uint16_t *voltage, uint16_t nr_of_modules, uint16_t cells_per_module,
+                        uint32_t *sums) {
+#if SOA_DSP_AVAILABLE == TRUE
+    uint32_t sum = 0;
+    uint32_t w = 0;
+    uint16_t pairs = cells_per_module / 2;
+    uint16_t m = 0;
+    uint16_t i = 0;
+
+    if ((cells_per_module & 1U) != 0) {
+        /* odd number of cells: modules do not start on a pair boundary */
+        SOA_CalcModuleSums_Ref(voltage, nr_of_modules, cells_per_module, sums);
+    } else {
+        for (m = 0; m < nr_of_modules; m++) {
+            sum = 0;
+            for (i = 0; i < pairs; i++) {
+                /* unsigned halfwords, both additions compile to UXTAH */
+                w = SOA_LoadPair(&voltage[2 * i]);
+                sum += (w & 0xFFFFU) + (w >> 16);
+            }
+            sums[m] = sum;
+            voltage += cells_per_module;
+        }
+    }
+#else
+    SOA_CalcModuleSums_Ref(voltage, nr_of_modules, cells_per_module, sums);
+#endif
+}
+
+
+void SOA_CalcModuleSums_Ref(const uint16_t *voltage, uint16_t nr_of_modules, uint16_t cells_per_module,
+                            uint32_t *sums) {
+    uint32_t sum = 0;
+    uint16_t m = 0;
+    uint16_t i = 0;
+
+    for (m = 0; m < nr_of_modules; m++) {
+        sum = 0;
+        for (i = 0; i < cells_per_module; i++) {
+            sum += *voltage++;
+        }
+        sums[m] = sum;
+    }
+}
+
+
+#if SOA_DSP_AVAILABLE == TRUE
+/**
+ * @brief   loads two adjacent 16bit values as one 32bit word for the packed instructions
+ *
+ * @details memcpy instead of a pointer cast keeps the access valid under the strict
+ *          aliasing rules, the compiler emits a single LDR for it.
+ *
+ * @param   src:    address of the first (low) halfword
+ *
+ * @return  first value in bits 0..15, second value in bits 16..31
+ */
+static inline uint32_t SOA_LoadPair(const void *src) {
+    uint32_t pair = 0;
+
+    memcpy(&pair, src, sizeof(pair));
+    return pair;
+}
+#endif
+
+
+/**
+ * @brief   converts the cell indices of minimum and maximum voltage into module and cell numbers
+ */
+static void SOA_SetVoltageIndices(DATA_BLOCK_MINMAX_s *minmax, uint16_t min_idx, uint16_t max_idx, uint16_t cells_per_module) {
+    minmax->voltage_module_number_min = min_idx / cells_per_module;
+    minmax->voltage_cell_number_min = min_idx % cells_per_module;
+    minmax->voltage_module_number_max = max_idx / cells_per_module;
+    minmax->voltage_cell_number_max = max_idx % cells_per_module;
+}
+
+
+/**
+ * @brief   converts the sensor indices of minimum and maximum temperature into module and sensor numbers
+ */
+static void SOA_SetTemperatureIndices(DATA_BLOCK_MINMAX_s *minmax, uint16_t min_idx, uint16_t max_idx, uint16_t sensors_per_module) {
+    minmax->temperature_module_number_min = min_idx / sensors_per_module;
+    minmax->temperature_sensor_number_min = min_idx % sensors_per_module;
+    minmax->temperature_module_number_max = max_idx / sensors_per_module;
+    minmax->temperature_sensor_number_max = max_idx % sensors_per_module;
+}
+
+
+#if SOA_BENCHMARK_ENABLE == TRUE
+void SOA_Benchmark(void) {
+    uint32_t start = 0;
+    uint16_t nr = 0;
+    uint16_t i = 0;
+    uint8_t s = 0;
+
+    if (soa_benchmark_done == TRUE) {
+        return;
+    }
+
+    /* every 7th cell below, every 11th cell above the limits, the rest inside */
+    for (i = 0; i < SOA_BENCHMARK_MAX_CELLS; i++) {
+        soa_bench_voltage[i] = (i % 7 == 3) ? 1500 : ((i % 11 == 5) ? 3000 : (2200 + (i % 13)));
+        soa_bench_temperature[i] = (i % 7 == 3) ? -30 : ((i % 11 == 5) ? 60 : (25 - (i % 5)));
+    }
+
+    /* the cycle counter is shared (latency, load measurement), only differences are used */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (s = 0; s < SOA_BENCHMARK_NR_OF_SIZES; s++) {
+        nr = soa_benchmark_sizes[s];
+        soa_benchmark[s].nr_of_cells = nr;
+        soa_benchmark[s].equal = TRUE;
+
+        start = DWT->CYCCNT;
+        (void)SOA_CheckVoltages(soa_bench_voltage, nr, 1700, 2800, soa_bench_under[0], soa_bench_over[0]);
+        soa_benchmark[s].cycles_volt = DWT->CYCCNT - start;
+
+        start = DWT->CYCCNT;
+        (void)SOA_CheckVoltages_Ref(soa_bench_voltage, nr, 1700, 2800, soa_bench_under[1], soa_bench_over[1]);
+        soa_benchmark[s].cycles_volt_ref = DWT->CYCCNT - start;
+
+        if (SOA_MasksEqual(nr) == FALSE) {
+            soa_benchmark[s].equal = FALSE;
+        }
+
+        start = DWT->CYCCNT;
+        (void)SOA_CheckTemperatures(soa_bench_temperature, nr, -20, 55, soa_bench_under[0], soa_bench_over[0]);
+        soa_benchmark[s].cycles_temp = DWT->CYCCNT - start;
+
+        start = DWT->CYCCNT;
+        (void)SOA_CheckTemperatures_Ref(soa_bench_temperature, nr, -20, 55, soa_bench_under[1], soa_bench_over[1]);
+        soa_benchmark[s].cycles_temp_ref = DWT->CYCCNT - start;
+
+        if (SOA_MasksEqual(nr) == FALSE) {
+            soa_benchmark[s].equal = FALSE;
+        }
+
+        start = DWT->CYCCNT;
+        SOA_CalcVoltageMinMax(soa_bench_voltage, nr, BS_NR_OF_BAT_CELLS_PER_MODULE, &soa_bench_minmax[0]);
+        SOA_CalcTemperatureMinMax(soa_bench_temperature, nr, BS_NR_OF_TEMP_SENSORS_PER_MODULE, &soa_bench_minmax[0]);
+        soa_benchmark[s].cycles_minmax = DWT->CYCCNT - start;
+
+        start = DWT->CYCCNT;
+        SOA_CalcVoltageMinMax_Ref(soa_bench_voltage, nr, BS_NR_OF_BAT_CELLS_PER_MODULE, &soa_bench_minmax[1]);
+        SOA_CalcTemperatureMinMax_Ref(soa_bench_temperature, nr, BS_NR_OF_TEMP_SENSORS_PER_MODULE, &soa_bench_minmax[1]);
+        soa_benchmark[s].cycles_minmax_ref = DWT->CYCCNT - start;
+
+        if (SOA_MinMaxEqual() == FALSE) {
+            soa_benchmark[s].equal = FALSE;
+        }
+    }
+
+    soa_benchmark_done = TRUE;
+}
+
+
+/**
+ * @brief   compares the bitmasks of the DSP and the reference implementation
+ *
+ * @param   nr: number of checked cells
+ *
+ * @return  TRUE if under- and overmasks are identical, otherwise FALSE
+ */
+static uint8_t SOA_MasksEqual(uint16_t nr) {
+    uint16_t i = 0;
+
+    for (i = 0; i < SOA_MASK_WORDS(nr); i++) {
+        if ((soa_bench_under[0][i] != soa_bench_under[1][i]) || (soa_bench_over[0][i] != soa_bench_over[1][i])) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/**
+ * @brief   compares the min/max results of the DSP and the reference implementation
+ *
+ * @return  TRUE if all values and indices are identical, otherwise FALSE
+ */
+static uint8_t SOA_MinMaxEqual(void) {
+    DATA_BLOCK_MINMAX_s *a = &soa_bench_minmax[0];
+    DATA_BLOCK_MINMAX_s *b = &soa_bench_minmax[1];
+
+    if ((a->voltage_min != b->voltage_min) || (a->voltage_max != b->voltage_max) ||
+        (a->voltage_mean != b->voltage_mean) ||
+        (a->voltage_module_number_min != b->voltage_module_number_min) ||
+        (a->voltage_cell_number_min != b->voltage_cell_number_min) ||
+        (a->voltage_module_number_max != b->voltage_module_number_max) ||
+        (a->voltage_cell_number_max != b->voltage_cell_number_max) ||
+        (a->temperature_min != b->temperature_min) || (a->temperature_max != b->temperature_max) ||
+        (a->temperature_mean != b->temperature_mean) ||
+        (a->temperature_module_number_min != b->temperature_module_number_min) ||
+        (a->temperature_sensor_number_min != b->temperature_sensor_number_min) ||
+        (a->temperature_module_number_max != b->temperature_module_number_max) ||
+        (a->temperature_sensor_number_max != b->temperature_sensor_number_max)) {
+        return FALSE;
+    }
+    return TRUE;
+}
+#endif
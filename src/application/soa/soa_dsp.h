@@ -0,0 +1,210 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    soa_dsp.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Per-cell limit checks, min/max and module sums of the raw cell data
+ *
+ * Checks every cell voltage and temperature against its limits and returns
+ * bitmasks of the violating cells (bit n of word n/32 = cell n). Computes
+ * minimum, maximum and mean of the raw cell data and the module sums. Each
+ * function has a portable reference implementation with identical results.
+ */
+
+#ifndef SOA_DSP_H_
+#define SOA_DSP_H_
+
+/*================== Includes =============================================*/
+#include "soa_cfg.h"
+
+#include "database.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * number of 32bit words of a cell bitmask for nr cells
+ */
+#define SOA_MASK_WORDS(nr)      (((nr)+31)/32)
+
+/**
+ * return value bits of the per-cell checks
+ */
+#define SOA_VIOLATION_UNDER     (0x01)  /*!< at least one value below the lower limit */
+#define SOA_VIOLATION_OVER      (0x02)  /*!< at least one value above the upper limit */
+
+/**
+ * result of the benchmark for one cell count
+ */
+typedef struct {
+    uint16_t nr_of_cells;       /*!< number of checked cells                                       */
+    uint32_t cycles_volt;       /*!< CPU cycles of SOA_CheckVoltages()                             */
+    uint32_t cycles_volt_ref;   /*!< CPU cycles of SOA_CheckVoltages_Ref()                         */
+    uint32_t cycles_temp;       /*!< CPU cycles of SOA_CheckTemperatures()                         */
+    uint32_t cycles_temp_ref;   /*!< CPU cycles of SOA_CheckTemperatures_Ref()                     */
+    uint32_t cycles_minmax;     /*!< CPU cycles of SOA_CalcVoltageMinMax() and SOA_CalcTemperatureMinMax()         */
+    uint32_t cycles_minmax_ref; /*!< CPU cycles of the reference implementations of the min/max calculation        */
+    uint8_t equal;              /*!< TRUE if the results of both implementations are identical     */
+} SOA_BENCHMARK_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+#if SOA_BENCHMARK_ENABLE == TRUE
+/**
+ * benchmark results, filled by SOA_Benchmark()
+ */
+extern SOA_BENCHMARK_s soa_benchmark[SOA_BENCHMARK_NR_OF_SIZES];
+#endif
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   checks all cell voltages against the limits
+ *
+ * @details Uses packed 16bit compares and selects (two cells per instruction) if
+ *          SOA_USE_DSP_INSTRUCTIONS is enabled, otherwise SOA_CheckVoltages_Ref().
+ *
+ * @param   voltage:        cell voltages in mV
+ * @param   nr_of_cells:    number of cells
+ * @param   min:            lower limit in mV, cells below are marked in undermask
+ * @param   max:            upper limit in mV, cells above are marked in overmask
+ * @param   undermask:      bitmask of cells below min, SOA_MASK_WORDS(nr_of_cells) words
+ * @param   overmask:       bitmask of cells above max, SOA_MASK_WORDS(nr_of_cells) words
+ *
+ * @return  SOA_VIOLATION_UNDER and/or SOA_VIOLATION_OVER if a limit is violated, otherwise 0
+ */
+extern uint8_t SOA_CheckVoltages(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t min, uint16_t max,
+                                 uint32_t *undermask, uint32_t *overmask);
+
+/**
+ * @brief   checks all cell temperatures against the limits
+ *
+ * @details Uses packed signed 16bit compares and selects if SOA_USE_DSP_INSTRUCTIONS is
+ *          enabled, otherwise SOA_CheckTemperatures_Ref().
+ *
+ * @param   temperature:    cell temperatures in degree Celsius
+ * @param   nr_of_sensors:  number of temperature sensors
+ * @param   min:            lower limit, sensors below are marked in undermask
+ * @param   max:            upper limit, sensors above are marked in overmask
+ * @param   undermask:      bitmask of sensors below min, SOA_MASK_WORDS(nr_of_sensors) words
+ * @param   overmask:       bitmask of sensors above max, SOA_MASK_WORDS(nr_of_sensors) words
+ *
+ * @return  SOA_VIOLATION_UNDER and/or SOA_VIOLATION_OVER if a limit is violated, otherwise 0
+ */
+extern uint8_t SOA_CheckTemperatures(const int16_t *temperature, uint16_t nr_of_sensors, int16_t min, int16_t max,
+                                     uint32_t *undermask, uint32_t *overmask);
+
+/**
+ * @brief   portable reference implementation of SOA_CheckVoltages()
+ *
+ * @details Plain C, one cell per iteration. Produces identical bitmasks and return
+ *          value, used as fallback and for equivalence checks.
+ */
+extern uint8_t SOA_CheckVoltages_Ref(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t min, uint16_t max,
+                                     uint32_t *undermask, uint32_t *overmask);
+
+/**
+ * @brief   portable reference implementation of SOA_CheckTemperatures()
+ */
+extern uint8_t SOA_CheckTemperatures_Ref(const int16_t *temperature, uint16_t nr_of_sensors, int16_t min, int16_t max,
+                                         uint32_t *undermask, uint32_t *overmask);
+
+/**
+ * @brief   computes minimum, maximum and mean cell voltage in a single pass
+ *
+ * @details Fills the voltage members of minmax. Uses packed 16bit min/max (USUB16 and SEL)
+ *          over blocks of 16 cells if SOA_USE_DSP_INSTRUCTIONS is enabled; the position of
+ *          the extremum is searched afterwards only in the block that contains it. For equal
+ *          values the lowest cell index is reported, as by SOA_CalcVoltageMinMax_Ref().
+ *
+ * @param   voltage:            cell voltages in mV
+ * @param   nr_of_cells:        number of cells, must be greater than 0
+ * @param   cells_per_module:   number of cells per module, used for module and cell numbers
+ * @param   minmax:             result
+ */
+extern void SOA_CalcVoltageMinMax(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t cells_per_module,
+                                  DATA_BLOCK_MINMAX_s *minmax);
+
+/**
+ * @brief   computes minimum, maximum and mean cell temperature in a single pass
+ *
+ * @details Fills the temperature members of minmax, see SOA_CalcVoltageMinMax().
+ *
+ * @param   temperature:        cell temperatures in degree Celsius
+ * @param   nr_of_sensors:      number of sensors, must be greater than 0
+ * @param   sensors_per_module: number of sensors per module, used for module and sensor numbers
+ * @param   minmax:             result
+ */
+extern void SOA_CalcTemperatureMinMax(const int16_t *temperature, uint16_t nr_of_sensors, uint16_t sensors_per_module,
+                                      DATA_BLOCK_MINMAX_s *minmax);
+
+/**
+ * @brief   portable reference implementation of SOA_CalcVoltageMinMax()
+ */
+extern void SOA_CalcVoltageMinMax_Ref(const uint16_t *voltage, uint16_t nr_of_cells, uint16_t cells_per_module,
+                                      DATA_BLOCK_MINMAX_s *minmax);
+
+/**
+ * @brief   portable reference implementation of SOA_CalcTemperatureMinMax()
+ */
+extern void SOA_CalcTemperatureMinMax_Ref(const int16_t *temperature, uint16_t nr_of_sensors, uint16_t sensors_per_module,
+                                          DATA_BLOCK_MINMAX_s *minmax);
+
+/**
+ * @brief   computes the sum of the cell voltages of each module
+ *
+ * @details Loads pairs of cells with one 32bit access and adds both unsigned halfwords
+ *          (UXTAH) if SOA_USE_DSP_INSTRUCTIONS is enabled and cells_per_module is even (each
+ *          module then starts with a complete pair); falls back to SOA_CalcModuleSums_Ref()
+ *          otherwise. The full range 0..65535mV of the raw values is supported.
+ *
+ * @param   voltage:            cell voltages in mV
+ * @param   nr_of_modules:      number of modules
+ * @param   cells_per_module:   number of cells per module
+ * @param   sums:               module sums in mV, nr_of_modules entries
+ */
+extern void SOA_CalcModuleSums(const uint16_t *voltage, uint16_t nr_of_modules, uint16_t cells_per_module,
+                               uint32_t *sums);
+
+/**
+ * @brief   portable reference implementation of SOA_CalcModuleSums()
+ */
+extern void SOA_CalcModuleSums_Ref(const uint16_t *voltage, uint16_t nr_of_modules, uint16_t cells_per_module,
+                                   uint32_t *sums);
+
+#if SOA_BENCHMARK_ENABLE == TRUE
+/**
+ * @brief   measures the CPU cycles of the per-cell checks for the cell counts in soa_benchmark_sizes[]
+ *
+ * @details Runs only once, subsequent calls return immediately. Uses the DWT cycle counter.
+ */
+extern void SOA_Benchmark(void);
+#endif
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOA_DSP_H_ */
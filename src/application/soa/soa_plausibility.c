@@ -0,0 +1,244 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    soa_plausibility.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Plausibility checks of the received values against the raw cell data
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "soa_plausibility.h"
+
+#include "batterysystem_cfg.h"
+#include "database.h"
+#include "diag.h"
+#include "latency.h"
+#include "soa_dsp.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * absolute difference of two values
+ */
+#define SOA_ABSDIFF(a, b)       (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * local copies of the database blocks, static because of their size at large pack sizes
+ */
+static DATA_BLOCK_CELLVOLTAGE_s soa_cellvoltage;
+static DATA_BLOCK_CELLTEMPERATURE_s soa_celltemperature;
+static DATA_BLOCK_MINMAX_s soa_minmax;
+static DATA_BLOCK_MINMAX_s soa_minmax_received;
+static DATA_BLOCK_LTC_DEVICE_PARAMETER_s soa_ltc_parameter;
+
+/**
+ * module sums of the cell voltages and state of the voltage sum cross-check
+ */
+static uint32_t soa_module_sums[BS_NR_OF_MODULES];
+static uint32_t soa_voltage_sum_timestamp = 0;
+static uint8_t soa_voltage_sum_ticks = 0;
+
+/**
+ * timestamps of the cell data the secondary min/max values are computed from and of the last compared received values
+ */
+static uint32_t soa_minmax_voltage_timestamp = 0;
+static uint32_t soa_minmax_temperature_timestamp = 0;
+static uint32_t soa_minmax_received_timestamp = 0;
+
+/*================== Function Prototypes ==================================*/
+
+static uint8_t SOA_VoltageSumPlausible(uint32_t sum, uint32_t measured, uint32_t tolerance);
+static uint8_t SOA_MinMaxSameCycle(uint32_t received, uint32_t voltage, uint32_t temperature);
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   compares a voltage sum against a measured voltage
+ *
+ * @param   sum:        sum of cell voltages in mV
+ * @param   measured:   measured voltage in mV
+ * @param   tolerance:  absolute tolerance in mV, SOA_VOLTAGE_SUM_TOLERANCE_PERCENT of sum is added
+ *
+ * @return  TRUE if the difference is within the tolerance, FALSE otherwise
+ */
+static uint8_t SOA_VoltageSumPlausible(uint32_t sum, uint32_t measured, uint32_t tolerance) {
+    uint8_t retval = TRUE;
+
+    tolerance += (sum / 100) * SOA_VOLTAGE_SUM_TOLERANCE_PERCENT;
+    if (SOA_ABSDIFF(sum, measured) > tolerance) {
+        retval = FALSE;
+    }
+    return retval;
+}
+
+
+void SOA_CheckVoltageSums(void) {
+#if SOA_VOLTAGE_SUM_PACK_INDEX >= 0
+    DATA_BLOCK_CURRENT_s current;
+#endif
+    uint32_t pack_sum = 0;
+    uint8_t pack_complete = TRUE;
+    uint8_t evaluated = FALSE;
+    uint8_t plausible = TRUE;
+    uint16_t m = 0;
+
+    if (soa_voltage_sum_ticks < ((SOA_VOLTAGE_SUM_PERIOD_MS / 10) - 1)) {
+        soa_voltage_sum_ticks++;
+    } else {
+        DB_ReadBlock(&soa_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+
+        /* no new cell voltages: retry in the next cycle */
+        if (soa_cellvoltage.timestamp != soa_voltage_sum_timestamp) {
+            soa_voltage_sum_timestamp = soa_cellvoltage.timestamp;
+            soa_voltage_sum_ticks = 0;
+
+            DB_ReadBlock(&soa_ltc_parameter, DATA_BLOCK_ID_LTC_DEVICE_PARAMETER);
+            SOA_CalcModuleSums(soa_cellvoltage.voltage, BS_NR_OF_MODULES, BS_NR_OF_BAT_CELLS_PER_MODULE, soa_module_sums);
+
+            for (m = 0; m < BS_NR_OF_MODULES; m++) {
+                if (soa_cellvoltage.valid_voltPECs[m] != 0) {
+                    /* cell voltages with PEC error: neither this module nor the pack can be evaluated */
+                    pack_complete = FALSE;
+                } else {
+                    pack_sum += soa_module_sums[m];
+                    if (soa_cellvoltage.valid_socPECs[m] == 0) {
+                        evaluated = TRUE;
+                        if (SOA_VoltageSumPlausible(soa_module_sums[m], soa_cellvoltage.sumOfCells[m],
+                                                    SOA_VOLTAGE_SUM_MODULE_TOLERANCE_MV) == FALSE) {
+                            plausible = FALSE;
+                        }
+                    }
+                    if ((soa_ltc_parameter.timestamp != 0) && (soa_ltc_parameter.valid_sumOfCells[m] == 0)) {
+                        evaluated = TRUE;
+                        if (SOA_VoltageSumPlausible(soa_module_sums[m], soa_ltc_parameter.sumOfCells[m],
+                                                    SOA_VOLTAGE_SUM_MODULE_TOLERANCE_MV) == FALSE) {
+                            plausible = FALSE;
+                        }
+                    }
+                }
+            }
+
+#if SOA_VOLTAGE_SUM_PACK_INDEX >= 0
+            DB_ReadBlock(&current, DATA_BLOCK_ID_CURRENT);
+            /* a voltage <= 0 is no measurement; compare only values of about the same time */
+            if ((pack_complete == TRUE) && (current.timestamp != 0) &&
+                (current.voltage[SOA_VOLTAGE_SUM_PACK_INDEX] > 0.0f) &&
+                (SOA_ABSDIFF(current.timestamp, soa_cellvoltage.timestamp) <= SOA_VOLTAGE_SUM_MAX_SKEW_MS)) {
+                evaluated = TRUE;
+                if (SOA_VoltageSumPlausible(pack_sum, (uint32_t)current.voltage[SOA_VOLTAGE_SUM_PACK_INDEX],
+                                            SOA_VOLTAGE_SUM_PACK_TOLERANCE_MV) == FALSE) {
+                    plausible = FALSE;
+                }
+            }
+#else
+            (void)pack_complete;
+#endif
+
+            /* nothing evaluable in this cycle: no report, the channel keeps its state */
+            if (evaluated == TRUE) {
+                if (plausible == TRUE) {
+                    DIAG_Handler(DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY, DIAG_EVENT_OK, 0, NULL_PTR);
+                } else {
+                    LAT_MarkSample(DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY, soa_cellvoltage.timestamp);
+                    DIAG_Handler(DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY, DIAG_EVENT_NOK, 0, NULL_PTR);
+                }
+            }
+        }
+    }
+}
+
+void SOA_UpdateMinMax(void) {
+    uint8_t plausible = TRUE;
+
+    DB_ReadBlock(&soa_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
+    DB_ReadBlock(&soa_celltemperature, DATA_BLOCK_ID_CELLTEMPERATURE);
+
+    if ((soa_cellvoltage.timestamp != soa_minmax_voltage_timestamp) ||
+        (soa_celltemperature.timestamp != soa_minmax_temperature_timestamp)) {
+        soa_minmax_voltage_timestamp = soa_cellvoltage.timestamp;
+        soa_minmax_temperature_timestamp = soa_celltemperature.timestamp;
+
+        soa_minmax.previous_voltage_min = soa_minmax.voltage_min;
+        soa_minmax.previous_voltage_max = soa_minmax.voltage_max;
+        SOA_CalcVoltageMinMax(soa_cellvoltage.voltage, BS_NR_OF_BAT_CELLS, BS_NR_OF_BAT_CELLS_PER_MODULE, &soa_minmax);
+        SOA_CalcTemperatureMinMax(soa_celltemperature.temperature, BS_NR_OF_TEMP_SENSORS, BS_NR_OF_TEMP_SENSORS_PER_MODULE, &soa_minmax);
+        DB_WriteBlock(&soa_minmax, DATA_BLOCK_ID_MINMAX_SECONDARY);
+    }
+
+    /* each received block is compared once, and only against the cell data it was computed from */
+    DB_ReadBlock(&soa_minmax_received, DATA_BLOCK_ID_MINMAX);
+    if ((soa_minmax_received.timestamp == soa_minmax_received_timestamp) ||
+        (SOA_MinMaxSameCycle(soa_minmax_received.timestamp, soa_cellvoltage.timestamp,
+                             soa_celltemperature.timestamp) == FALSE)) {
+        return;
+    }
+    soa_minmax_received_timestamp = soa_minmax_received.timestamp;
+
+    if ((SOA_ABSDIFF(soa_minmax_received.voltage_min, soa_minmax.voltage_min) > SOA_MINMAX_VOLTAGE_TOLERANCE_MV) ||
+        (SOA_ABSDIFF(soa_minmax_received.voltage_max, soa_minmax.voltage_max) > SOA_MINMAX_VOLTAGE_TOLERANCE_MV) ||
+        (SOA_ABSDIFF(soa_minmax_received.temperature_min, soa_minmax.temperature_min) > SOA_MINMAX_TEMPERATURE_TOLERANCE) ||
+        (SOA_ABSDIFF(soa_minmax_received.temperature_max, soa_minmax.temperature_max) > SOA_MINMAX_TEMPERATURE_TOLERANCE)) {
+        plausible = FALSE;
+    }
+
+    if (plausible == TRUE) {
+        DIAG_Handler(DIAG_CH_MINMAX_PLAUSIBILITY, DIAG_EVENT_OK, 0, NULL_PTR);
+    } else {
+        DIAG_Handler(DIAG_CH_MINMAX_PLAUSIBILITY, DIAG_EVENT_NOK, 0, NULL_PTR);
+    }
+}
+
+
+/**
+ * @brief   checks that received min/max values belong to the current cell data
+ *
+ * @details The received values must be written after the cell voltages and temperatures
+ *          and at most SOA_MINMAX_MAX_SKEW_MS after the cell voltages. Otherwise the cell
+ *          data has been updated in between (or the received values are stale) and a
+ *          comparison would report measurement timing instead of a deviation.
+ *
+ * @param   received:       timestamp of DATA_BLOCK_ID_MINMAX
+ * @param   voltage:        timestamp of DATA_BLOCK_ID_CELLVOLTAGE
+ * @param   temperature:    timestamp of DATA_BLOCK_ID_CELLTEMPERATURE
+ *
+ * @return  TRUE if both are from the same measurement cycle, otherwise FALSE
+ */
+static uint8_t SOA_MinMaxSameCycle(uint32_t received, uint32_t voltage, uint32_t temperature) {
+    uint8_t retval = TRUE;
+
+    /* unsigned differences: valid across the wrap-around of the timestamps */
+    if ((received == 0) || (voltage == 0) || (temperature == 0) ||
+        ((uint32_t)(received - voltage) > SOA_MINMAX_MAX_SKEW_MS) ||
+        ((uint32_t)(received - temperature) >= 0x80000000U)) {
+        retval = FALSE;
+    }
+    return retval;
+}
@@ -0,0 +1,78 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    soa_plausibility.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup APPLICATION
+ * @prefix  SOA
+ *
+ * @brief   Plausibility checks of the received values against the raw cell data
+ *
+ * Recomputes the minimum and maximum values and the module and pack voltage
+ * sums from the cell voltages and temperatures in the database and compares
+ * them with the values received from the primary and the measured voltages.
+ */
+
+#ifndef SOA_PLAUSIBILITY_H_
+#define SOA_PLAUSIBILITY_H_
+
+/*================== Includes =============================================*/
+#include "soa_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   computes the minimum and maximum values of the secondary from the raw cell data
+ *
+ * @details To be called every 10ms. Computes and writes DATA_BLOCK_ID_MINMAX_SECONDARY only
+ *          if new cell voltages or temperatures are in the database. Each new received
+ *          DATA_BLOCK_ID_MINMAX is checked against it (DIAG_CH_MINMAX_PLAUSIBILITY) once, and only
+ *          if it was written within SOA_MINMAX_MAX_SKEW_MS after the cell data, i.e. belongs to the
+ *          same measurement cycle. Other received values are not evaluated.
+ */
+extern void SOA_UpdateMinMax(void);
+
+/**
+ * @brief   cross-checks the sums of the cell voltages against the measured module and pack voltages
+ *
+ * @details To be called every 10ms, runs every SOA_VOLTAGE_SUM_PERIOD_MS if new cell voltages are
+ *          in the database. Compares the module sums of the cell voltages with the module voltages
+ *          of the cell voltage block and of the device parameter block (each only if its sum of
+ *          cells measurement is valid) and the pack sum with the current sensor voltage
+ *          SOA_VOLTAGE_SUM_PACK_INDEX. Modules with a PEC error on the cell voltages are skipped,
+ *          the pack sum is then not compared either. The pack sum is compared only if the sensor
+ *          voltage is > 0 (measured) and within SOA_VOLTAGE_SUM_MAX_SKEW_MS of the cell voltages.
+ *          Any deviation above the tolerance is reported on DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY;
+ *          if nothing could be compared, nothing is reported.
+ */
+extern void SOA_CheckVoltageSums(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SOA_PLAUSIBILITY_H_ */
@@ -47,6 +47,7 @@
 
 /*================== Constant and Variable Definitions ====================*/
 
+#if OS_TIME_TRIGGERED_EXECUTIVE == FALSE
 /**
  *  Definition of task handle 1 milliseconds task
  */
@@ -62,26 +63,34 @@ static xTaskHandle appl_handle_tsk_10ms;
  */
 static xTaskHandle appl_handle_tsk_100ms;
 
+/**
+ * Statically allocated stacks of the application tasks
+ */
+static StackType_t MEM_OS_STATIC appl_stack_cyclic_1ms[APPL_TSK_CYCLIC_1MS_STACKSIZE];
+static StackType_t MEM_OS_STATIC appl_stack_cyclic_10ms[APPL_TSK_CYCLIC_10MS_STACKSIZE];
+static StackType_t MEM_OS_STATIC appl_stack_cyclic_100ms[APPL_TSK_CYCLIC_100MS_STACKSIZE];
+#endif
+
 /*================== Function Prototypes ==================================*/
 
 
 /*================== Function Implementations =============================*/
 
 void APPL_CreateTask(void) {
+#if OS_TIME_TRIGGERED_EXECUTIVE == FALSE
     // Cyclic Task 1ms
-    osThreadDef(APPL_TSK_Cyclic_1ms, (os_pthread) APPL_TSK_Cyclic_1ms,
-            appl_tskdef_cyclic_1ms.Priority, 0, appl_tskdef_cyclic_1ms.Stacksize);
-    appl_handle_tsk_1ms = osThreadCreate(osThread(APPL_TSK_Cyclic_1ms), NULL);
+    appl_handle_tsk_1ms = OS_CreateTask("APPL_TSK_Cyclic_1ms", (os_pthread) APPL_TSK_Cyclic_1ms,
+            &appl_tskdef_cyclic_1ms, appl_stack_cyclic_1ms);
 
     // Cyclic Task 10ms
-    osThreadDef(APPL_TSK_Cyclic_10ms, (os_pthread) APPL_TSK_Cyclic_10ms,
-            appl_tskdef_cyclic_10ms.Priority, 0, appl_tskdef_cyclic_10ms.Stacksize);
-    appl_handle_tsk_10ms = osThreadCreate(osThread(APPL_TSK_Cyclic_10ms), NULL);
+    appl_handle_tsk_10ms = OS_CreateTask("APPL_TSK_Cyclic_10ms", (os_pthread) APPL_TSK_Cyclic_10ms,
+            &appl_tskdef_cyclic_10ms, appl_stack_cyclic_10ms);
 
     // Cyclic Task 100ms
-    osThreadDef(APPL_TSK_Cyclic_100ms, (os_pthread) APPL_TSK_Cyclic_100ms,
-            appl_tskdef_cyclic_100ms.Priority, 0, appl_tskdef_cyclic_100ms.Stacksize);
-    appl_handle_tsk_100ms = osThreadCreate(osThread(APPL_TSK_Cyclic_100ms), NULL);
+    appl_handle_tsk_100ms = OS_CreateTask("APPL_TSK_Cyclic_100ms", (os_pthread) APPL_TSK_Cyclic_100ms,
+            &appl_tskdef_cyclic_100ms, appl_stack_cyclic_100ms);
+#endif
+    /* else: the cyclic functions run in the time-triggered executive (ENG_TSK_Executive()) */
 }
 
 void APPL_CreateMutex(void) {
@@ -94,43 +103,43 @@ void APPL_CreateQueues(void) {
 }
 
 void APPL_TSK_Cyclic_1ms(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_APPL_CYCLIC_1MS);
 
     osDelayUntil(&os_schedulerstarttime, appl_tskdef_cyclic_1ms.Phase);
+    OS_MarkFirstCycle(OS_START_APPL_CYCLIC_1MS);
 
     while (1) {
         uint32_t currentTime = osKernelSysTick();
         APPL_Cyclic_1ms();
+        OS_MarkActivation();
         osDelayUntil(&currentTime, appl_tskdef_cyclic_1ms.CycleTime);
     }
 }
 
 void APPL_TSK_Cyclic_10ms(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_APPL_CYCLIC_10MS);
 
     osDelayUntil(&os_schedulerstarttime, appl_tskdef_cyclic_10ms.Phase);
+    OS_MarkFirstCycle(OS_START_APPL_CYCLIC_10MS);
 
     while (1) {
         uint32_t currentTime = osKernelSysTick();
         APPL_Cyclic_10ms();
+        OS_MarkActivation();
         osDelayUntil(&currentTime, appl_tskdef_cyclic_10ms.CycleTime);
     }
 }
 
 void APPL_TSK_Cyclic_100ms(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_APPL_CYCLIC_100MS);
 
     osDelayUntil(&os_schedulerstarttime, appl_tskdef_cyclic_100ms.Phase);
+    OS_MarkFirstCycle(OS_START_APPL_CYCLIC_100MS);
 
     while (1) {
         uint32_t currentTime = osKernelSysTick();
         APPL_Cyclic_100ms();
+        OS_MarkActivation();
         osDelayUntil(&currentTime, appl_tskdef_cyclic_100ms.CycleTime);
     }
 }
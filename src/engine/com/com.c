@@ -0,0 +1,178 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    com.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  COM
+ *
+ * @brief   UART link of the external diagnosis tool (readout of the diagnosis memory)
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "com.h"
+
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * request frame, written by the interrupt until com_rx_ready is set, then read by COM_Trigger()
+ */
+static uint8_t com_rx_frame[COM_REQUEST_FRAME_LENGTH];
+static volatile uint8_t com_rx_pos = 0;
+static volatile uint8_t com_rx_ready = FALSE;
+
+/**
+ * receive position at the last COM_Trigger() and number of calls without progress
+ */
+static uint8_t com_rx_pos_last = 0;
+static uint8_t com_rx_idle_cycles = 0;
+
+/**
+ * response frame, written by COM_Trigger() while no transmission is running, then sent by the interrupt
+ */
+static uint8_t com_tx_frame[COM_RESPONSE_FRAME_LENGTH];
+static volatile uint8_t com_tx_length = 0;
+static volatile uint8_t com_tx_pos = 0;
+
+static uint8_t com_initialized = FALSE;
+
+/*================== Function Prototypes ==================================*/
+static void COM_ReceiveByte(uint8_t byte);
+
+/*================== Function Implementations =============================*/
+
+STD_RETURN_TYPE_e COM_Init(void) {
+    if (HAL_UART_Init(COM_UART_HANDLE) != HAL_OK) {
+        return E_NOT_OK;
+    }
+    __HAL_UART_ENABLE_IT(COM_UART_HANDLE, UART_IT_RXNE);
+    com_initialized = TRUE;
+
+    return E_OK;
+}
+
+
+void COM_IRQHandler(void) {
+    USART_TypeDef *uart = COM_UART_HANDLE->Instance;
+    uint32_t status = uart->SR;
+
+    if ((status & (USART_SR_RXNE | USART_SR_ORE)) != 0) {
+        /* reading DR also clears the overrun flag */
+        COM_ReceiveByte((uint8_t)uart->DR);
+    }
+
+    if (((uart->CR1 & USART_CR1_TXEIE) != 0) && ((status & USART_SR_TXE) != 0)) {
+        if (com_tx_pos < com_tx_length) {
+            uart->DR = com_tx_frame[com_tx_pos++];
+        } else {
+            uart->CR1 &= ~USART_CR1_TXEIE;
+        }
+    }
+}
+
+
+/**
+ * @brief   adds a received byte to the request frame
+ *
+ * @param   byte:   received byte
+ *
+ * @return  void
+ */
+static void COM_ReceiveByte(uint8_t byte) {
+    uint8_t checksum = 0;
+    uint8_t i = 0;
+
+    if (com_rx_ready == TRUE) {
+        return;     // last request not processed yet, the tool waits for the response
+    }
+    if ((com_rx_pos == 0) && (byte != COM_SYNC_BYTE)) {
+        return;     // search the start of a frame
+    }
+
+    com_rx_frame[com_rx_pos++] = byte;
+    if (com_rx_pos < COM_REQUEST_FRAME_LENGTH) {
+        return;
+    }
+
+    com_rx_pos = 0;
+    for (i = 1; i < (COM_REQUEST_FRAME_LENGTH - 1); i++) {
+        checksum ^= com_rx_frame[i];
+    }
+    if (checksum == com_rx_frame[COM_REQUEST_FRAME_LENGTH - 1]) {
+        com_rx_ready = TRUE;
+    }
+}
+
+
+void COM_Trigger(void) {
+    uint8_t checksum = 0;
+    uint16_t length = 0;
+    uint16_t i = 0;
+
+    if (com_initialized == FALSE) {
+        return;
+    }
+
+    /* drop a partly received frame after a pause, the next frame starts with a sync byte */
+    if ((com_rx_pos != 0) && (com_rx_pos == com_rx_pos_last)) {
+        if (++com_rx_idle_cycles >= COM_RX_TIMEOUT_CYCLES) {
+            OS_TaskEnter_Critical();
+            if (com_rx_pos == com_rx_pos_last) {
+                com_rx_pos = 0;
+            }
+            OS_TaskExit_Critical();
+            com_rx_idle_cycles = 0;
+        }
+    } else {
+        com_rx_idle_cycles = 0;
+    }
+    com_rx_pos_last = com_rx_pos;
+
+    if ((com_rx_ready == FALSE) || (com_tx_pos < com_tx_length)) {
+        return;     // no request or last response still being sent
+    }
+
+    length = DIAG_ReadoutCommand(&com_rx_frame[1], DIAG_READOUT_REQUEST_LENGTH,
+            &com_tx_frame[2], DIAG_READOUT_RESPONSE_MAXLENGTH);
+    com_rx_ready = FALSE;
+    if (length == 0) {
+        return;
+    }
+
+    com_tx_frame[0] = COM_SYNC_BYTE;
+    com_tx_frame[1] = (uint8_t)length;
+    for (i = 1; i < (length + 2); i++) {
+        checksum ^= com_tx_frame[i];
+    }
+    com_tx_frame[length + 2] = checksum;
+
+    com_tx_pos = 0;
+    com_tx_length = (uint8_t)(length + 3);
+    __HAL_UART_ENABLE_IT(COM_UART_HANDLE, UART_IT_TXE);
+}
@@ -0,0 +1,90 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    com.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  COM
+ *
+ * @brief   UART link of the external diagnosis tool (readout of the diagnosis memory)
+ *
+ * The tool sends request frames, the requests are processed by DIAG_ReadoutCommand().
+ * Request:  COM_SYNC_BYTE, request (DIAG_READOUT_REQUEST_LENGTH bytes), checksum
+ * Response: COM_SYNC_BYTE, length n, response (n bytes), checksum
+ * The checksum is the XOR of the request or of the length and the response bytes.
+ * Frames with a wrong checksum are ignored, the tool repeats the request after a timeout.
+ */
+
+#ifndef COM_H_
+#define COM_H_
+
+/*================== Includes =============================================*/
+#include "com_cfg.h"
+
+#include "diag.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * length of a request frame
+ */
+#define COM_REQUEST_FRAME_LENGTH    (DIAG_READOUT_REQUEST_LENGTH + 2)
+
+/**
+ * maximum length of a response frame
+ */
+#define COM_RESPONSE_FRAME_LENGTH   (DIAG_READOUT_RESPONSE_MAXLENGTH + 3)
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   initializes the UART and enables the receive interrupt
+ *
+ * @return  E_OK if the UART has been initialized
+ */
+extern STD_RETURN_TYPE_e COM_Init(void);
+
+/**
+ * @brief   receive and transmit interrupt of the UART, called by the USART interrupt handler
+ *
+ * @return  void
+ */
+extern void COM_IRQHandler(void);
+
+/**
+ * @brief   processes a received request and starts the transmission of the response,
+ *          called by the 10ms engine task
+ *
+ * @details This is the only caller of DIAG_ReadoutCommand(), so the read cursor of the
+ *          diagnosis memory has a single owner.
+ *
+ * @return  void
+ */
+extern void COM_Trigger(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* COM_H_ */
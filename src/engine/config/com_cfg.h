@@ -0,0 +1,75 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    com_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE_CONF
+ * @prefix  COM
+ *
+ * @brief   Configuration of the UART link to the external diagnosis tool
+ */
+
+#ifndef COM_CFG_H_
+#define COM_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "uart_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_COM
+ * UART of the external tool (FTDI USB-UART bridge), handle of uart_cfg[]
+ */
+#define COM_UART_HANDLE             (&uart_cfg[0])
+
+/**
+ * @ingroup CONFIG_COM
+ * first byte of every request and response frame
+ * \par Type:
+ * int
+ * \par Default:
+ * 0xA5
+*/
+#define COM_SYNC_BYTE               (0xA5)
+
+/**
+ * @ingroup CONFIG_COM
+ * a partly received request is dropped if no further byte arrives within this number of
+ * COM_Trigger() calls (10ms task)
+ * \par Type:
+ * int
+ * \par Default:
+ * 2
+*/
+#define COM_RX_TIMEOUT_CYCLES       (2)
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* COM_CFG_H_ */
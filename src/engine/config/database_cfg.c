@@ -137,6 +137,11 @@ DATA_BLOCK_ILCKFEEDBACK_s data_block_ilckfeedback[SINGLE_BUFFERING];
  */
 DATA_BLOCK_SYSTEMSTATE_s data_block_systemstate[SINGLE_BUFFERING];
 
+/**
+ * data block: minimum and maximum values computed by the secondary
+ */
+DATA_BLOCK_MINMAX_s data_block_minmax_secondary[DOUBLE_BUFFERING];
+
 
 /**
  * @brief channel configuration of database (data blocks)
@@ -239,7 +244,12 @@ DATA_BASE_HEADER_s  data_base_header[] = {
             (void*)(&data_block_systemstate[0]),
             sizeof(DATA_BLOCK_SYSTEMSTATE_s),
             SINGLE_BUFFERING,
-    }
+    },
+    {
+            (void*)(&data_block_minmax_secondary[0]),
+            sizeof(DATA_BLOCK_MINMAX_s),
+            DOUBLE_BUFFERING,
+    },
 };
 
 /**
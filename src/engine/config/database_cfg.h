@@ -46,7 +46,7 @@
  *
  * this value is extendible but limitation is done due to RAM consumption and performance
  */
-#define DATA_MAX_BLOCK_NR                19        /* max 17 Blocks currently supported*/
+#define DATA_MAX_BLOCK_NR                20        /* 20 Blocks currently used (DATA_BLOCK_1 to DATA_BLOCK_20) */
 
 /**
  * @brief data block identification number
@@ -71,6 +71,7 @@ typedef enum {
     DATA_BLOCK_17       = 16,
     DATA_BLOCK_18       = 17,
     DATA_BLOCK_19       = 18,
+    DATA_BLOCK_20       = 19,
     DATA_BLOCK_MAX      = DATA_MAX_BLOCK_NR,
 } DATA_BLOCK_ID_TYPE_e;
 
@@ -137,6 +138,7 @@ typedef struct {
 #define     DATA_BLOCK_ID_CONTFEEDBACK                  DATA_BLOCK_17
 #define     DATA_BLOCK_ID_ILCKFEEDBACK                  DATA_BLOCK_18
 #define     DATA_BLOCK_ID_SYSTEMSTATE                   DATA_BLOCK_19
+#define     DATA_BLOCK_ID_MINMAX_SECONDARY              DATA_BLOCK_20
 
 /**
  * data block struct of cell voltage
@@ -292,6 +294,9 @@ typedef struct {
 
 /**
  * data block struct of LTC minimum and maximum values
+ *
+ * Used for the received values (DATA_BLOCK_ID_MINMAX) and for the values computed
+ * by the secondary from the raw cell data (DATA_BLOCK_ID_MINMAX_SECONDARY).
  */
 typedef struct {
     uint32_t voltage_mean;
@@ -385,6 +390,13 @@ typedef struct {
     uint8_t can_timing;                              /*!< 0 -> no error, 1 -> error         */
     uint8_t can_timing_cc;                           /*!< 0 -> no error, 1 -> error         */
     uint8_t can_cc_used;                             /*!< 0 -> not present, 1 -> present    */
+    uint8_t minmax_plausibility;                     /*!< 0 -> no error, 1 -> error         */
+    uint8_t coulomb_plausibility;                    /*!< 0 -> no error, 1 -> error, reported only     */
+    uint8_t voltage_sum_plausibility;                /*!< 0 -> no error, 1 -> error         */
+    uint8_t cellvoltage_outlier;                     /*!< 0 -> no error, 1 -> error, reported only     */
+    uint8_t temperature_gradient_warning;            /*!< 0 -> no error, 1 -> error, reported only     */
+    uint8_t temperature_gradient;                    /*!< 0 -> no error, 1 -> error         */
+    uint8_t fast_trip;                               /*!< 0 -> no error, 1 -> error         */
     uint32_t timestamp;                              /*!< timestamp of database entry       */
     uint32_t previous_timestamp;                     /*!< timestamp of last database entry  */
 } DATA_BLOCK_ERRORSTATE_s;
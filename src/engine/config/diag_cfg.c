@@ -47,7 +47,8 @@
  * Every entry of the diag_sysmon_ch_cfg[] consists of
  *  - enum of monitored object
  *  - type of monitored object (at the moment only DIAG_SYSMON_CYCLICTASK is supported)
- *  - maximum delay in [ms] in which the object needs to call the DIAG_SysMonNotify function defined in diag.c
+ *  - maximum delay in [ms] in which the object needs to call the DIAG_SysMonNotify function defined in diag.c,
+ *    converted into checks of DIAG_SysMon() by DIAG_SYSMON_TIMEOUT_CHECKS()
  *  - enabling of the recording for system monitoring
  *  - enabling of the system monitoring for the monitored object
  *  - callback function if system monitoring notices an error if wished, otherwise dummyfu2
@@ -337,6 +338,90 @@ void DIAG_error_interlock(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
     }
     DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
 }
+void DIAG_error_fasttrip(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.fast_trip = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.fast_trip = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
+void DIAG_error_minmaxplausibility(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.minmax_plausibility = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.minmax_plausibility = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
+void DIAG_error_coulombplausibility(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.coulomb_plausibility = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.coulomb_plausibility = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
+void DIAG_error_voltagesumplausibility(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.voltage_sum_plausibility = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.voltage_sum_plausibility = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
+void DIAG_error_cellvoltageoutlier(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.cellvoltage_outlier = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.cellvoltage_outlier = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
+void DIAG_error_tempgradientwarning(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.temperature_gradient_warning = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.temperature_gradient_warning = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
+void DIAG_error_tempgradientalarm(DIAG_CH_ID_e ch_id, DIAG_EVENT_e event)
+{
+    DATA_BLOCK_ERRORSTATE_s error_flags;
+    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    if(event==DIAG_EVENT_RESET){
+        error_flags.temperature_gradient = 0;
+    }
+    if(event==DIAG_EVENT_NOK){
+        error_flags.temperature_gradient = 1;
+    }
+    DB_WriteBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+}
 
 /**
  * Callback function of system monitoring error events
@@ -368,6 +453,9 @@ DIAG_CH_CFG_s  diag_ch_cfg[] = {
 
     {DIAG_CH_CONFIGASSERT,                         "CONFIGASSERT",                        DIAG_GENERAL_TYPE, DIAG_ERROR_SENSITIVITY_HIGH,              DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
     {DIAG_CH_SYSTEMMONITORING_TIMEOUT,             "SYSTEMMONITORING_TIMEOUT",            DIAG_GENERAL_TYPE, DIAG_ERROR_SENSITIVITY_HIGH,              DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
+    {DIAG_CH_CPU_LOAD,                             "CPU_LOAD",                            DIAG_GENERAL_TYPE, DIAG_ERROR_CPU_LOAD_SENSITIVITY,          DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
+    {DIAG_CH_STACK_OVERFLOW,                       "STACK_OVERFLOW",                      DIAG_GENERAL_TYPE, DIAG_ERROR_SENSITIVITY_HIGH,              DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
+    {DIAG_CH_STACK_HEADROOM,                       "STACK_HEADROOM",                      DIAG_GENERAL_TYPE, DIAG_ERROR_SENSITIVITY_HIGH,              DIAG_RECORDING_ENABLED, DIAG_ENABLED, dummyfu},
 
 
     /* Measurement events */
@@ -414,25 +502,40 @@ DIAG_CH_CFG_s  diag_ch_cfg[] = {
 
     /* Interlock Feedback Error*/
     {DIAG_CH_INTERLOCK_FEEDBACK,                   "INTERLOCK_FEEDBACK",                  DIAG_GENERAL_TYPE,    DIAG_ERROR_INTERLOCK_SENSITIVITY,         DIAG_RECORDING_DISABLED, DIAG_DISABLED, DIAG_error_interlock},
+    {DIAG_CH_INTERLOCK_FAST_TRIP,                  "INTERLOCK_FAST_TRIP",                 DIAG_GENERAL_TYPE,    DIAG_ERROR_FAST_TRIP_SENSITIVITY,         DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_fasttrip},
+
+    /* Plausibility */
+    {DIAG_CH_MINMAX_PLAUSIBILITY,                  "MINMAX_PLAUSIBILITY",                 DIAG_GENERAL_TYPE,    DIAG_ERROR_PLAUSIBILITY_SENSITIVITY,      DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_minmaxplausibility},
+    {DIAG_CH_COULOMB_PLAUSIBILITY,                 "COULOMB_PLAUSIBILITY",                DIAG_GENERAL_TYPE,    DIAG_ERROR_COULOMB_PLAUSIBILITY_SENSITIVITY, DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_coulombplausibility},
+    {DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY,             "VOLTAGE_SUM_PLAUSIBILITY",            DIAG_GENERAL_TYPE,    DIAG_ERROR_PLAUSIBILITY_SENSITIVITY,      DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_voltagesumplausibility},
+    {DIAG_CH_CELLVOLTAGE_OUTLIER,                  "CELLVOLTAGE_OUTLIER",                 DIAG_GENERAL_TYPE,    DIAG_ERROR_CELL_OUTLIER_SENSITIVITY,      DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_cellvoltageoutlier},
+    {DIAG_CH_TEMP_GRADIENT_WARNING,                "TEMP_GRADIENT_WARNING",               DIAG_GENERAL_TYPE,    DIAG_ERROR_TEMP_GRADIENT_SENSITIVITY,     DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_tempgradientwarning},
+    {DIAG_CH_TEMP_GRADIENT_ALARM,                  "TEMP_GRADIENT_ALARM",                 DIAG_GENERAL_TYPE,    DIAG_ERROR_TEMP_GRADIENT_SENSITIVITY,     DIAG_RECORDING_ENABLED, DIAG_ENABLED, DIAG_error_tempgradientalarm},
 
 };
 
 
 DIAG_SYSMON_CH_CFG_s diag_sysmon_ch_cfg[]=
 {
-    {DIAG_SYSMON_DATABASE_ID,       DIAG_SYSMON_CYCLICTASK,  10, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_SYS_ID,        DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_BMS_ID,        DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_ILCK_ID,        DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_LTC_ID,            DIAG_SYSMON_CYCLICTASK,   5, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_ISOGUARD_ID,       DIAG_SYSMON_CYCLICTASK, 400, DIAG_RECORDING_DISABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_DISABLED, dummyfu2},
-    {DIAG_SYSMON_CANS_ID,           DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_DISABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_DISABLED, dummyfu2},
-    {DIAG_SYSMON_APPL_CYCLIC_1ms,   DIAG_SYSMON_CYCLICTASK,   2, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_APPL_CYCLIC_10ms,  DIAG_SYSMON_CYCLICTASK,  20, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
-    {DIAG_SYSMON_APPL_CYCLIC_100ms, DIAG_SYSMON_CYCLICTASK, 200, DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_DATABASE_ID,       DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS( 10), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_SYS_ID,        DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS( 20), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_BMS_ID,        DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS( 20), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_ILCK_ID,        DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS( 20), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_LTC_ID,            DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS(  5), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_ISOGUARD_ID,       DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS(400), DIAG_RECORDING_DISABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_DISABLED, dummyfu2},
+    {DIAG_SYSMON_CANS_ID,           DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS( 20), DIAG_RECORDING_DISABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_DISABLED, dummyfu2},
+    {DIAG_SYSMON_APPL_CYCLIC_1ms,   DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS(  2), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_APPL_CYCLIC_10ms,  DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS( 20), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
+    {DIAG_SYSMON_APPL_CYCLIC_100ms, DIAG_SYSMON_CYCLICTASK, DIAG_SYSMON_TIMEOUT_CHECKS(200), DIAG_RECORDING_ENABLED, DIAG_SYSMON_HANDLING_SWITCHOFFCONTACTOR, DIAG_ENABLED, dummyfu2},
 };
 
 
+/**
+ * compile-time check: the array size is negative if diag_ch_cfg[] has more
+ * entries than the per channel data of the diag module (DIAG_CH_CFG_MAX)
+ */
+typedef char DIAG_CH_CFG_MAX_too_small[((sizeof(diag_ch_cfg)/sizeof(DIAG_CH_CFG_s)) <= DIAG_CH_CFG_MAX) ? 1 : -1];
+
 DIAG_DEV_s  diag_dev = {
     .nr_of_ch   = sizeof(diag_ch_cfg)/sizeof(DIAG_CH_CFG_s),
     .ch_cfg     = &diag_ch_cfg[0],
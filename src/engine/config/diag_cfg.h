@@ -71,6 +71,14 @@
 #define DIAG_ERROR_PRECHARGE_SENSITIVITY           (500)
 
 #define DIAG_ERROR_INTERLOCK_SENSITIVITY           (10)
+#define DIAG_ERROR_FAST_TRIP_SENSITIVITY           (1)   // the trip is latched in hardware
+
+#define DIAG_ERROR_CPU_LOAD_SENSITIVITY            (3)   // load report windows (OS_LOAD_WINDOW_MS)
+
+#define DIAG_ERROR_PLAUSIBILITY_SENSITIVITY        (5)
+#define DIAG_ERROR_COULOMB_PLAUSIBILITY_SENSITIVITY (1)  // one comparison per COULOMB_PLAUSIBILITY_WINDOW_MS
+#define DIAG_ERROR_CELL_OUTLIER_SENSITIVITY        (1)  // debounced per cell with CELLSTAT_OUTLIER_SET_COUNT
+#define DIAG_ERROR_TEMP_GRADIENT_SENSITIVITY       (2)  // gradient is already filtered, one event per temperature measurement
 
 /**
  * Number of errors that can be logged
@@ -87,6 +95,115 @@
  */
 #define DIAG_FAIL_ENTRY_CONTACTOR_LENGTH    (50)
 
+/**
+ * Maximum number of configured diagnosis channels in diag_ch_cfg[]
+ * The per channel counters and event states of the diag module are sized by
+ * this value instead of DIAG_ID_MAX, so it must be at least the number of
+ * entries in diag_ch_cfg[] (checked at compile time in diag_cfg.c).
+ * 55 channels are configured, the rest is headroom for new channels.
+ */
+#define DIAG_CH_CFG_MAX                     (64)
+
+/**
+ * @ingroup CONFIG_DIAG
+ * arcing time assumed for the I2t estimate of a contactor opening event
+ * (I2t estimate = opening current^2 * arcing time). The current during the arc is
+ * not sampled, so the recorded value is an estimate and not a measured I2t.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 5
+*/
+#define DIAG_CONTACTOR_ARCING_TIME_MS       (5)
+
+/**
+ * @ingroup CONFIG_DIAG
+ * contactor openings at an absolute current above this limit are counted as
+ * opened hard at current (cont_switch_opened_hard_at_current)
+ * \par Type:
+ * int
+ * \par Unit:
+ * mA
+ * \par Default:
+ * 10000
+*/
+#define DIAG_CONTACTOR_HARD_OPENING_CURRENT_MA  (10000)
+
+/**
+ * @ingroup CONFIG_DIAG
+ * number of 32bit words of the faulting stack (above the exception frame) saved in the crash dump
+ * \par Type:
+ * int
+ * \par Default:
+ * 16
+*/
+#define DIAG_CRASHDUMP_STACK_WORDS          (16)
+
+/**
+ * @ingroup CONFIG_DIAG
+ * reset the MCU after a fault has been captured (TRUE) or stay in the fault handler for debugging (FALSE)
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * TRUE
+*/
+#define DIAG_CRASHDUMP_RESET_ENABLE         TRUE
+
+/**
+ * @ingroup CONFIG_DIAG
+ * period of the system monitoring (DIAG_SysMon()), the engine task runs it at this
+ * period and serves the database requests in between.
+ * The thresholds of diag_sysmon_ch_cfg[] count checks, i.e. multiples of this period,
+ * see DIAG_SYSMON_TIMEOUT_CHECKS(). A longer period saves wake-ups of the engine task
+ * but delays the detection of the short timeouts, e.g. a stopped 1ms task (timeout
+ * 2ms) is reported after 3ms with 1ms and after 20ms with 10ms.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 1
+*/
+#define DIAG_SYSMON_PERIOD_MS               (1)
+
+/**
+ * converts a system monitoring timeout in ms into the number of checks of
+ * diag_sysmon_ch_cfg[], rounded up.
+ * A module that notifies at least every timeout_ms is never reported. A module that
+ * stopped is reported after at most (DIAG_SYSMON_TIMEOUT_CHECKS(timeout_ms) + 1) *
+ * DIAG_SYSMON_PERIOD_MS, e.g. 3ms for a timeout of 2ms with a period of 1ms.
+ */
+#define DIAG_SYSMON_TIMEOUT_CHECKS(timeout_ms)  \
+    (((timeout_ms) + DIAG_SYSMON_PERIOD_MS - 1) / DIAG_SYSMON_PERIOD_MS)
+
+/**
+ * @ingroup CONFIG_DIAG
+ * CPU time that must stay free (idle task share of the load report of OS_UpdateLoad()).
+ * DIAG_CH_CPU_LOAD is set if the utilization is above (100 - headroom) percent.
+ * \par Type:
+ * int
+ * \par Unit:
+ * %
+ * \par Default:
+ * 30
+*/
+#define DIAG_CPU_LOAD_HEADROOM_PERCENT      (30)
+
+/**
+ * @ingroup CONFIG_DIAG
+ * minimum free stack of every task (stack high-water mark of the report of OS_UpdateLoad()).
+ * DIAG_CH_STACK_HEADROOM is set if a task has used its stack up to less than this margin.
+ * \par Type:
+ * int
+ * \par Unit:
+ * words
+ * \par Default:
+ * 32
+*/
+#define DIAG_STACK_MIN_FREE_WORDS           (32)
+
 
 // FIXME simple doxygen comment for each define?
 /* Initialization and startup events: 0-15 */
@@ -109,6 +226,9 @@
 #define DIAG_CH_RUNTIME_ERROR_RESERVED_3                   DIAG_ID_23            // reserved for future needs
 #define DIAG_CH_CONFIGASSERT                               DIAG_ID_24            //
 #define DIAG_CH_SYSTEMMONITORING_TIMEOUT                   DIAG_ID_25            //
+#define DIAG_CH_CPU_LOAD                                   DIAG_ID_26            // utilization above the headroom limit
+#define DIAG_CH_STACK_OVERFLOW                             DIAG_ID_27            // stack overflow detected by the scheduler
+#define DIAG_CH_STACK_HEADROOM                             DIAG_ID_28            // free stack below DIAG_STACK_MIN_FREE_WORDS
 
 
 /* Measurement events: 32-47 */
@@ -208,6 +328,37 @@
  * @brief   Interlock feedback error
  */
 #define DIAG_CH_INTERLOCK_FEEDBACK                         DIAG_ID_73
+/**
+ * @brief   interlock opened by the hardware fast trip (analog watchdog), or its self test failed
+ */
+#define DIAG_CH_INTERLOCK_FAST_TRIP                        DIAG_ID_74
+
+
+/* Plausibility and cell statistics events: 80-95*/
+/**
+ * @brief   received minimum/maximum values differ from the values computed by the secondary
+ */
+#define DIAG_CH_MINMAX_PLAUSIBILITY                        DIAG_ID_80
+/**
+ * @brief   charge or energy counted by the secondary differs from the counters of the current sensor
+ */
+#define DIAG_CH_COULOMB_PLAUSIBILITY                       DIAG_ID_81
+/**
+ * @brief   sums of the cell voltages differ from the measured module or pack voltages
+ */
+#define DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY                   DIAG_ID_82
+/**
+ * @brief   cell voltage deviates persistently from the robust mean of all cells
+ */
+#define DIAG_CH_CELLVOLTAGE_OUTLIER                        DIAG_ID_83
+/**
+ * @brief   temperature of a sensor rises faster than CELLSTAT_GRADIENT_WARNING_MK_MIN
+ */
+#define DIAG_CH_TEMP_GRADIENT_WARNING                      DIAG_ID_84
+/**
+ * @brief   temperature of a sensor rises faster than CELLSTAT_GRADIENT_ALARM_MK_MIN
+ */
+#define DIAG_CH_TEMP_GRADIENT_ALARM                        DIAG_ID_85
 
 
 /**
@@ -349,7 +500,7 @@ typedef struct {
 typedef struct {
     DIAG_SYSMON_MODULE_ID_e id;                     /*!< the diag type by its symbolic name            */
     DIAG_SYSMON_TYPE_e type;                        /*!< system monitoring types: cyclic or special    */
-    uint16_t threshold;                             /*!< max. delay time in ms                         */
+    uint16_t threshold;                             /*!< checks without notification, DIAG_SYSMON_TIMEOUT_CHECKS() */
     DIAG_TYPE_RECORDING_e enablerecording;          /*!< enabled if set to DIAG_RECORDING_ENABLED      */
     DIAG_SYSMON_HANDLING_TYPE_e handlingtype;       /*!< type of handling of system monitoring errors  */
     DIAG_ENABLE_STATE_e state;                      /*!< enable or disable system monitoring           */
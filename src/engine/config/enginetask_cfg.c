@@ -51,27 +51,80 @@
 #include "wdg.h"
 #include "intermcu.h"
 #include "adc_ex.h"
+#include "fasttrip.h"
+#include "latency.h"
+#include "evt.h"
+#include "com.h"
 #include "led.h"
+#include "appltask_cfg.h"
 
 /*================== Macros and Definitions ===============================*/
 
 /*================== Constant and Variable Definitions ====================*/
-BMS_Task_Definition_s eng_tskdef_cyclic_1ms     = { 0,      1,  OS_PRIORITY_ABOVE_HIGH,        1024/4};
-BMS_Task_Definition_s eng_tskdef_cyclic_10ms    = { 2,     10,  OS_PRIORITY_HIGH,              1024/4};
-BMS_Task_Definition_s eng_tskdef_cyclic_100ms   = {56,    100,  OS_PRIORITY_ABOVE_NORMAL,      1024/4};
-BMS_Task_Definition_s eng_tskdef_eventhandler   = { 0,      1,  OS_PRIORITY_VERY_HIGH,         1024/4};
-BMS_Task_Definition_s eng_tskdef_diagnosis      = { 0,      1,  OS_PRIORITY_BELOW_REALTIME,    1024/4};
+BMS_Task_Definition_s eng_tskdef_cyclic_1ms     = { 0,      1,  OS_PRIORITY_ABOVE_HIGH,        ENG_TSK_CYCLIC_1MS_STACKSIZE};
+BMS_Task_Definition_s eng_tskdef_cyclic_10ms    = { 2,     10,  OS_PRIORITY_HIGH,              ENG_TSK_CYCLIC_10MS_STACKSIZE};
+BMS_Task_Definition_s eng_tskdef_cyclic_100ms   = {56,    100,  OS_PRIORITY_ABOVE_NORMAL,      ENG_TSK_CYCLIC_100MS_STACKSIZE};
+BMS_Task_Definition_s eng_tskdef_eventhandler   = { 0,      1,  OS_PRIORITY_VERY_HIGH,         ENG_TSK_EVENTHANDLER_STACKSIZE};
+BMS_Task_Definition_s eng_tskdef_diagnosis      = { 0,      1,  OS_PRIORITY_BELOW_REALTIME,    ENG_TSK_DIAGNOSIS_STACKSIZE};
+BMS_Task_Definition_s eng_tskdef_executive      = { 0,      1,  OS_PRIORITY_BELOW_REALTIME,    ENG_TSK_EXECUTIVE_STACKSIZE};
+
+/* order of the priorities of the tasks in the preemptive mode */
+const ENG_EXECUTIVE_SLOT_s eng_executive_table[ENG_EXECUTIVE_NR_OF_SLOTS] = {
+    {ENG_Diagnosis,         &eng_tskdef_diagnosis},
+    {ENG_EventHandler,      &eng_tskdef_eventhandler},
+    {ENG_Cyclic_1ms,        &eng_tskdef_cyclic_1ms},
+    {ENG_Cyclic_10ms,       &eng_tskdef_cyclic_10ms},
+    {ENG_Cyclic_100ms,      &eng_tskdef_cyclic_100ms},
+    {APPL_Cyclic_1ms,       &appl_tskdef_cyclic_1ms},
+    {APPL_Cyclic_10ms,      &appl_tskdef_cyclic_10ms},
+    {APPL_Cyclic_100ms,     &appl_tskdef_cyclic_100ms},
+};
 
 /*================== Function Prototypes ==================================*/
+static void ENG_InterlockSwitchingAccounting(void);
 
 /*================== Function Implementations =============================*/
 
+/**
+ * @brief   counts switching cycles of the interlock in the contactor accounting
+ *
+ * Detects transitions of the interlock set state and reports them with the current
+ * at switching time to the diag contactor accounting. The database is only read
+ * on a transition, so the costs in the 1ms task are a single compare otherwise.
+ *
+ * @return  void
+ */
+static void ENG_InterlockSwitchingAccounting(void) {
+    static ILCK_ELECTRICAL_STATE_TYPE_s ilck_laststate = ILCK_SWITCH_OFF;
+    ILCK_ELECTRICAL_STATE_TYPE_s ilck_state = ilck_interlock_state.set;
+    DATA_BLOCK_CURRENT_s current_tab;
+
+    if(ilck_state == ilck_laststate)
+        return;
+
+    DB_ReadBlock(&current_tab, DATA_BLOCK_ID_CURRENT);
+
+    if(ilck_state == ILCK_SWITCH_ON) {
+        DIAG_Handler(DIAG_CH_CONTACTOR_CLOSING, DIAG_EVENT_NOK, ILCK_ACCOUNTING_CONTACTOR_NR, &current_tab.current);
+    } else if(ilck_state == ILCK_SWITCH_OFF) {
+        /* set state seen after ILCK_Trigger(): up to 1ms after the pin write, see latency.h */
+        LAT_Mark(LAT_STAGE_ILCK_OFF);
+        DIAG_Handler(DIAG_CH_CONTACTOR_OPENING, DIAG_EVENT_NOK, ILCK_ACCOUNTING_CONTACTOR_NR, &current_tab.current);
+    }
+    (void)EVT_Post(EVT_INTERLOCK_SWITCHED, (uint32_t)ilck_state);
+
+    ilck_laststate = ilck_state;
+}
+
 
 void ENG_Init(void) {
     SYS_RETURN_TYPE_e sys_retVal = SYS_ILLEGAL_TASK_TYPE;
 
     DATA_BLOCK_ERRORSTATE_s error_flags;
 
+    LAT_Init();
+    (void)COM_Init();
+
     DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
 
     error_flags.general_error               = 0;
@@ -98,6 +151,13 @@ void ENG_Init(void) {
     error_flags.crc_error                   = 0;
     error_flags.mux_error                   = 0;
     error_flags.spi_error                   = 0;
+    error_flags.minmax_plausibility         = 0;
+    error_flags.coulomb_plausibility        = 0;
+    error_flags.voltage_sum_plausibility    = 0;
+    error_flags.cellvoltage_outlier         = 0;
+    error_flags.temperature_gradient_warning = 0;
+    error_flags.temperature_gradient        = 0;
+    error_flags.fast_trip                   = 0;
 
     error_flags.can_timing                  = 0;
     error_flags.can_timing_cc               = 0;
@@ -113,13 +173,17 @@ void ENG_Init(void) {
 
 void ENG_Cyclic_1ms(void) {
 
+    FTRIP_Trigger();
     SYS_Trigger();
     ILCK_Trigger();
+    ENG_InterlockSwitchingAccounting();
     LTC_Trigger();
 }
 
 void ENG_Cyclic_10ms(void) {
 
+    COM_Trigger();      // readout of the diagnosis memory by the external tool
+
 #if BUILD_MODULE_ENABLE_SAFETY_FEATURES == 0
     LED_Ctrl();
 #endif
@@ -165,10 +229,10 @@ void ENG_Cyclic_100ms(void) {
 }
 
 void ENG_EventHandler(void) {
-    ;
+    (void)EVT_Dispatch(EVT_CONSUMER_EVENTHANDLER);
 }
 
 void ENG_Diagnosis(void) {
-    ;
+    (void)EVT_Dispatch(EVT_CONSUMER_DIAGNOSIS);
 }
 
@@ -40,6 +40,34 @@
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * stack sizes of the engine tasks in words, the stacks are allocated statically
+ * (MEM_OS_STATIC). Compare with the recommended sizes of OS_GetStackReport().
+ */
+#define ENG_TSK_ENGINE_STACKSIZE            (1024/4)
+#define ENG_TSK_CYCLIC_1MS_STACKSIZE        (1024/4)
+#define ENG_TSK_CYCLIC_10MS_STACKSIZE       (1024/4)
+#define ENG_TSK_CYCLIC_100MS_STACKSIZE      (1024/4)
+#define ENG_TSK_EVENTHANDLER_STACKSIZE      (1024/4)
+#define ENG_TSK_DIAGNOSIS_STACKSIZE         (1024/4)
+#define ENG_TSK_EXECUTIVE_STACKSIZE         (2048/4)
+
+/**
+ * number of runnables in the schedule table of the time-triggered executive
+ */
+#define ENG_EXECUTIVE_NR_OF_SLOTS           (8)
+
+/**
+ * runnable of the time-triggered executive (OS_TIME_TRIGGERED_EXECUTIVE)
+ *
+ * The runnable is executed in the ticks t (in ms since the start of the scheduler)
+ * with t >= Phase and (t - Phase) a multiple of CycleTime of the task definition.
+ */
+typedef struct {
+    void (*runnable)(void);             /*!< cyclic function                            */
+    BMS_Task_Definition_s *taskdef;     /*!< task definition with phase and cycle time  */
+} ENG_EXECUTIVE_SLOT_s;
+
 /*================== Constant and Variable Definitions ====================*/
 
 /**
@@ -73,6 +101,18 @@ extern BMS_Task_Definition_s eng_tskdef_cyclic_100ms;
 extern BMS_Task_Definition_s eng_tskdef_eventhandler;
 extern BMS_Task_Definition_s eng_tskdef_diagnosis;
 
+/**
+ * @brief   Task configuration of the time-triggered executive
+ * @ingroup API_OS
+ */
+extern BMS_Task_Definition_s eng_tskdef_executive;
+
+/**
+ * @brief   schedule table of the time-triggered executive, the runnables of a tick are
+ *          executed in the order of the table
+ */
+extern const ENG_EXECUTIVE_SLOT_s eng_executive_table[ENG_EXECUTIVE_NR_OF_SLOTS];
+
 /*================== Function Prototypes ==================================*/
 /**
  * @brief   Initializes modules that were not initialized before scheduler
@@ -107,13 +147,13 @@ extern void ENG_Cyclic_10ms(void);
 extern void ENG_Cyclic_100ms(void);
 
 /**
- * @brief   Engine Task for handling of events
+ * @brief   Engine Task for handling of events, dispatches the events of EVT_CONSUMER_EVENTHANDLER
  *
  */
 extern void ENG_EventHandler(void);
 
 /**
- * @brief   Engine Task for diagnosis
+ * @brief   Engine Task for diagnosis, dispatches the events of EVT_CONSUMER_DIAGNOSIS
  *
  */
 extern void ENG_Diagnosis(void);
@@ -121,7 +161,9 @@ extern void ENG_Diagnosis(void);
 /**
  * @brief   Database-Task
  * @details The task manages the data exchange with the database and must have a
- *          higher task priority than any task using the database.
+ *          higher task priority than any task using the database. It blocks on the
+ *          database queue until a request arrives or the next system monitoring
+ *          (DIAG_SysMon()) is due, every eng_tskdef_engine.CycleTime.
  *
  */
 extern void ENG_TSK_Engine(void);
@@ -0,0 +1,88 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    evt_cfg.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE_CONF
+ * @prefix  EVT
+ *
+ * @brief   Configuration of the event bus of the event handler and diagnosis tasks
+ */
+
+/*================== Includes =============================================*/
+#include "evt_cfg.h"
+
+#include "bms.h"
+#include "interlock.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Function Prototypes ==================================*/
+static void EVT_HandleDiagError(const EVT_EVENT_s *event);
+static void EVT_HandleInterlock(const EVT_EVENT_s *event);
+
+/*================== Constant and Variable Definitions ====================*/
+
+const EVT_TYPE_CFG_s evt_type_cfg[EVT_NR_OF_TYPES] = {
+    {EVT_CONSUMER_DIAGNOSIS,        EVT_HandleDiagError},       /* EVT_DIAG_ERROR_SET       */
+    {EVT_CONSUMER_DIAGNOSIS,        EVT_HandleDiagError},       /* EVT_DIAG_ERROR_RESET     */
+    {EVT_CONSUMER_EVENTHANDLER,     EVT_HandleInterlock},       /* EVT_INTERLOCK_SWITCHED   */
+    {EVT_CONSUMER_EVENTHANDLER,     EVT_HandleInterlock},       /* EVT_FAST_TRIP            */
+};
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   handler of the DIAG error events, runs in the diagnosis task
+ *
+ * The error flags and the error memory are already updated by DIAG_Handler(). The
+ * BMS state machine is notified here, so the diagnosis does not depend on the
+ * application. If the event is dropped (full queue), the state machine still runs
+ * after BMS_EVENT_CHECK_TIMEOUT_MS.
+ *
+ * @param   event:  event
+ *
+ * @return  void
+ */
+static void EVT_HandleDiagError(const EVT_EVENT_s *event) {
+    BMS_NotifyEvent(BMS_EVENT_ERRORFLAG);
+}
+
+/**
+ * @brief   handler of the interlock events, runs in the event handler task
+ *
+ * An opened interlock (fast trip or switched off) is followed by the contactor and
+ * fast trip diagnosis. The BMS state machine is notified, so it evaluates the error
+ * flags in its next call instead of after BMS_EVENT_CHECK_TIMEOUT_MS. Closing the
+ * interlock needs no reaction.
+ *
+ * @param   event:  event
+ *
+ * @return  void
+ */
+static void EVT_HandleInterlock(const EVT_EVENT_s *event) {
+    if ((event->type == EVT_FAST_TRIP) || (event->data == (uint32_t)ILCK_SWITCH_OFF)) {
+        BMS_NotifyEvent(BMS_EVENT_ERRORFLAG);
+    }
+}
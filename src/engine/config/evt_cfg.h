@@ -0,0 +1,114 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    evt_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE_CONF
+ * @prefix  EVT
+ *
+ * @brief   Configuration of the event bus of the event handler and diagnosis tasks
+ */
+
+#ifndef EVT_CFG_H_
+#define EVT_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_EVT
+ * number of events a queue of a consumer can hold, must be a power of two.
+ * Events posted to a full queue are dropped and counted (EVT_STATISTICS_s.dropped).
+ * \par Type:
+ * int
+ * \par Default:
+ * 16
+*/
+#define EVT_QUEUE_LENGTH            (16)
+
+/**
+ * @ingroup CONFIG_EVT
+ * longest time a consumer task blocks without an event. Interrupts with a priority
+ * above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY may not call the FreeRTOS API,
+ * their events are dispatched at the latest after this time.
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 100
+*/
+#define EVT_WAIT_TIMEOUT_MS         (100)
+
+/**
+ * consumers of events, each consumer has its own queue
+ */
+typedef enum {
+    EVT_CONSUMER_EVENTHANDLER   = 0,    /*!< engine event handler task (ENG_TSK_EventHandler())  */
+    EVT_CONSUMER_DIAGNOSIS      = 1,    /*!< engine diagnosis task (ENG_TSK_Diagnosis())         */
+    EVT_NR_OF_CONSUMERS         = 2,
+} EVT_CONSUMER_e;
+
+/**
+ * event types, index of evt_type_cfg[]
+ */
+typedef enum {
+    EVT_DIAG_ERROR_SET          = 0,    /*!< DIAG error threshold reached, data: DIAG channel id    */
+    EVT_DIAG_ERROR_RESET        = 1,    /*!< DIAG error disappeared, data: DIAG channel id          */
+    EVT_INTERLOCK_SWITCHED      = 2,    /*!< interlock set state changed, data: new state           */
+    EVT_FAST_TRIP               = 3,    /*!< fast trip of the interlock, data: tripped channels     */
+    EVT_NR_OF_TYPES             = 4,
+} EVT_TYPE_e;
+
+/**
+ * event in the queue of a consumer
+ */
+typedef struct {
+    EVT_TYPE_e type;        /*!< event type                                         */
+    uint32_t data;          /*!< data of the event, see EVT_TYPE_e                  */
+    uint32_t timestamp;     /*!< DWT cycle counter at the time of EVT_Post()        */
+} EVT_EVENT_s;
+
+/**
+ * consumer and handler of an event type
+ */
+typedef struct {
+    EVT_CONSUMER_e consumer;                    /*!< task that handles the event                */
+    void (*handler)(const EVT_EVENT_s *event);  /*!< called by EVT_Dispatch() of the consumer   */
+} EVT_TYPE_CFG_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * consumers and handlers of the event types
+ */
+extern const EVT_TYPE_CFG_s evt_type_cfg[EVT_NR_OF_TYPES];
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* EVT_CFG_H_ */
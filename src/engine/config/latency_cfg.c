@@ -0,0 +1,64 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    latency_cfg.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE_CONF
+ * @prefix  LAT
+ *
+ * @brief   Configuration of the limit violation to interlock latency measurement
+ */
+
+/*================== Includes =============================================*/
+#include "latency_cfg.h"
+
+#include "soa_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * The sample periods are those of the measurement cycle (cell voltages and temperatures
+ * from the LTC, current from the current sensor) and have to be adapted to the used
+ * configuration. The checks of BMS_Trigger() run every 1ms (BMS_EVENT_DRIVEN_TRIGGER
+ * FALSE), the voltage sum and temperature gradient checks with their own period.
+ */
+const LAT_CHANNEL_CFG_s lat_channels[LAT_NR_OF_CHANNELS] = {
+    /* id                                       sample  check period (ms) */
+    {DIAG_CH_CELLVOLTAGE_OVERVOLTAGE,           100,    1},
+    {DIAG_CH_CELLVOLTAGE_UNDERVOLTAGE,          100,    1},
+    {DIAG_CH_TEMP_OVERTEMPERATURE_CHARGE,       100,    1},
+    {DIAG_CH_TEMP_OVERTEMPERATURE_DISCHARGE,    100,    1},
+    {DIAG_CH_TEMP_UNDERTEMPERATURE_CHARGE,      100,    1},
+    {DIAG_CH_TEMP_UNDERTEMPERATURE_DISCHARGE,   100,    1},
+    {DIAG_CH_OVERCURRENT_CHARGE,                10,     1},
+    {DIAG_CH_OVERCURRENT_DISCHARGE,             10,     1},
+    {DIAG_CH_VOLTAGE_SUM_PLAUSIBILITY,          100,    SOA_VOLTAGE_SUM_PERIOD_MS},
+    {DIAG_CH_TEMP_GRADIENT_ALARM,               100,    100},
+};
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
@@ -0,0 +1,110 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    latency_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE_CONF
+ * @prefix  LAT
+ *
+ * @brief   Configuration of the limit violation to interlock latency measurement
+ */
+
+#ifndef LATENCY_CFG_H_
+#define LATENCY_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "diag_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_LAT
+ * timestamps the path from a limit violation to the opening of the interlock
+ * for the channels of lat_channels[]
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * TRUE
+*/
+#define LAT_ENABLE                  TRUE
+
+/**
+ * @ingroup CONFIG_LAT
+ * an open measurement is dropped (counted as incomplete) if the interlock has not opened
+ * within this time, e.g. because it was already open. Must be below the overflow time of
+ * the DWT cycle counter (2^32 / core clock).
+ * \par Type:
+ * int
+ * \par Unit:
+ * ms
+ * \par Default:
+ * 5000
+*/
+#define LAT_EPISODE_TIMEOUT_MS      (5000)
+
+/**
+ * number of bins of the latency histogram
+ */
+#define LAT_HISTOGRAM_BINS          (14)
+
+/**
+ * @ingroup CONFIG_LAT
+ * upper limit of the first histogram bin, each further bin doubles the limit,
+ * the last bin counts all larger latencies
+ * \par Type:
+ * int
+ * \par Unit:
+ * us
+ * \par Default:
+ * 250
+*/
+#define LAT_HISTOGRAM_FIRST_US      (250)
+
+/**
+ * number of channels in lat_channels[]
+ */
+#define LAT_NR_OF_CHANNELS          (10)
+
+/**
+ * measured DIAG channel, the periods are only used by the simulation of tests/host/test_latency.c
+ */
+typedef struct {
+    DIAG_CH_ID_e id;            /*!< DIAG channel whose error flag opens the interlock              */
+    uint16_t sample_period_ms;  /*!< period of new samples in the database                          */
+    uint16_t check_period_ms;   /*!< period of the check that reports the channel to DIAG_Handler() */
+} LAT_CHANNEL_CFG_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * measured DIAG channels
+ */
+extern const LAT_CHANNEL_CFG_s lat_channels[LAT_NR_OF_CHANNELS];
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* LATENCY_CFG_H_ */
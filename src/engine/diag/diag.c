@@ -50,15 +50,22 @@
 #include "mcu.h"
 #include "bkpsram.h"
 #include "bms.h"
+#include "evt.h"
+#include "latency.h"
 #include "misc.h"
 #include "uart.h"
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * checks if an address is inside SRAM or CCM RAM (stack can only be located there)
+ */
+#define DIAG_ADDR_IN_RAM(addr)      ((((addr) >= 0x20000000) && ((addr) < 0x20030000)) || \
+                                     (((addr) >= 0x10000000) && ((addr) < 0x10010000)))
+
 /*================== Constant and Variable Definitions ====================*/
 static DIAG_s diag;
 static DIAG_DEV_s  *diag_devptr;
-static uint32_t diagsysmonTimestamp = 0;
 static uint8_t diag_locked = 0;
 
 // FIXME unused
@@ -78,19 +85,65 @@ DIAG_ERROR_ENTRY_s MEM_BKP_SRAM diag_memory[DIAG_FAIL_ENTRY_LENGTH];
 DIAG_ERROR_ENTRY_s MEM_BKP_SRAM *diag_entry_wrptr;
 DIAG_ERROR_ENTRY_s MEM_BKP_SRAM *diag_entry_rdptr;
 
+/**
+ * free running counters of written and acknowledged entries of diag_memory[].
+ * diag_entry_wrcnt is only modified by DIAG_EntryWrite(), diag_entry_rdcnt only
+ * by the readout functions, so the readout does not need to lock the recording.
+ */
+volatile uint32_t MEM_BKP_SRAM diag_entry_wrcnt;
+volatile uint32_t MEM_BKP_SRAM diag_entry_rdcnt;
+
+/**
+ * layout version of the diagnosis memory in backup SRAM, see DIAG_BKPSRAM_LAYOUT
+ */
+uint32_t MEM_BKP_SRAM diag_bkpsram_layout;
+
 DIAG_CONTACTOR_ERROR_ENTRY_s MEM_BKP_SRAM diagContactorErrorMemory[DIAG_FAIL_ENTRY_CONTACTOR_LENGTH];
 DIAG_CONTACTOR_ERROR_ENTRY_s MEM_BKP_SRAM *diagContactorError_entry_wrptr;
 DIAG_CONTACTOR_ERROR_ENTRY_s MEM_BKP_SRAM *diagContactorError_entry_rdptr;
 
 DIAG_FAILURECODE_s diag_fc;
 
+DIAG_CRASHDUMP_s MEM_BKP_SRAM diag_crashdump;
+
 /*================== Function Prototypes ==================================*/
 static void DIAG_Reset(void);
 static uint8_t DIAG_EntryWrite(uint8_t eventID, DIAG_EVENT_e event, uint8_t item_nr);
 static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint8_t item_nr);
+static DIAG_RETURNTYPE_e DIAG_ContHandler(DIAG_CH_ID_e diag_ch_id, uint8_t cont_nr, float *current);
+static DIAG_EVENT_e DIAG_GetEntryEvent(uint8_t ch);
+static void DIAG_UpdateReadCursor(void);
+static uint8_t *DIAG_PutU32(uint8_t *buf, uint32_t value);
+static uint32_t DIAG_RtcTimeToMs(RTC_Time_s *time);
+static void DIAG_SetEntryEvent(uint8_t ch, DIAG_EVENT_e event);
 
 /*================== Function Implementations =============================*/
 
+/**
+ * @brief   returns the last recorded event of a configured channel
+ *
+ * @param   ch: channel index in diag_ch_cfg[]
+ *
+ * @return  last recorded event (DIAG_EVENT_OK after reset)
+ */
+static DIAG_EVENT_e DIAG_GetEntryEvent(uint8_t ch) {
+    return (DIAG_EVENT_e)((diag.entry_event[ch/16] >> ((ch%16)*2)) & 0x3);
+}
+
+/**
+ * @brief   stores the last recorded event of a configured channel (2 bits per channel)
+ *
+ * @param   ch:     channel index in diag_ch_cfg[]
+ * @param   event:  event to store (OK, NOK or RESET)
+ *
+ * @return  void
+ */
+static void DIAG_SetEntryEvent(uint8_t ch, DIAG_EVENT_e event) {
+    uint32_t shift = (ch%16)*2;
+
+    diag.entry_event[ch/16] = (diag.entry_event[ch/16] & ~(0x3u << shift)) | (((uint32_t)event & 0x3) << shift);
+}
+
 /**
  * @brief   DIAG_Reset resets/initalizes all needed strcutures/buffers.
  *
@@ -117,7 +170,9 @@ static void DIAG_Reset(void)
 
     /* Set pointer to beginning of buffer */
     diag_entry_wrptr = diag_entry_rdptr = &diag_memory[0];
+    diag_entry_wrcnt = diag_entry_rdcnt = 0;
     diag.errcnttotal = 0;
+    diag.errcntreported = 0;
 
     /* Set pointer to beginning of buffer */
     u32ptr = (uint32_t*)(&diagContactorErrorMemory[0]);
@@ -149,9 +204,19 @@ void DIAG_Init(DIAG_DEV_s *diag_dev_pointer) {
     if( (diag_entry_wrptr<&diag_memory[0]) || (diag_entry_wrptr >= &diag_memory[DIAG_FAIL_ENTRY_LENGTH]))
         checkfail |= 2;
 
+    /* read/write counters must match the pointers and the read cursor must not be ahead of the write cursor */
+    if( (diag_entry_rdptr != &diag_memory[diag_entry_rdcnt % DIAG_FAIL_ENTRY_LENGTH]) ||
+            (diag_entry_wrptr != &diag_memory[diag_entry_wrcnt % DIAG_FAIL_ENTRY_LENGTH]) ||
+            ((diag_entry_wrcnt - diag_entry_rdcnt) > 0x7FFFFFFF) )
+        checkfail |= 32;
+
     if(DIAG_DATA_IS_VALID == 0)
         checkfail |= 4;
 
+    /* written by a firmware with another backup SRAM layout, the pointers and counters are not valid */
+    if(diag_bkpsram_layout != DIAG_BKPSRAM_LAYOUT)
+        checkfail |= 128;
+
     if( (diagContactorError_entry_rdptr < &diagContactorErrorMemory[0]) ||
             (diagContactorError_entry_rdptr >= &diagContactorErrorMemory[DIAG_FAIL_ENTRY_CONTACTOR_LENGTH]) )
         checkfail |= 8;
@@ -164,9 +229,19 @@ void DIAG_Init(DIAG_DEV_s *diag_dev_pointer) {
     if(checkfail) {
         DIAG_Reset();
         DIAG_DATA_IS_VALID = 1;
+        diag_bkpsram_layout = DIAG_BKPSRAM_LAYOUT;
     }
 
+    /* contactor switching counters are kept, only restored to defaults if corrupted */
+    if(BKPSRAM_Check_contactorcnt() != E_OK)
+        checkfail |= 64;
+
+    diag.nr_of_ch = diag_dev_pointer->nr_of_ch;
+
     /* Fill lookup table id2ch */
+    for(int i = 0; i < DIAG_ID_MAX; i++)
+        diag.id2ch[i] = DIAG_ID2CH_UNCONFIGURED;
+
     for(c = 0; c < diag_dev_pointer->nr_of_ch; c++) {
 
         id_nr = diag_dev_pointer->ch_cfg[c].id;
@@ -199,6 +274,11 @@ void DIAG_Init(DIAG_DEV_s *diag_dev_pointer) {
         /* make first entry after DIAG_Reset() */
         (void)(DIAG_Handler(DIAG_CH_BKPDIAG_FAILURE, DIAG_EVENT_NOK, checkfail, NULL));
     }
+
+    /* the stack overflow hook runs in the context switch and only writes the crash dump, record it now */
+    if((DIAG_CrashResetPending() == TRUE) && (diag_crashdump.source == DIAG_FAULT_STACKOVERFLOW)) {
+        (void)(DIAG_Handler(DIAG_CH_STACK_OVERFLOW, DIAG_EVENT_NOK, (uint8_t)diag_crashdump.task, NULL));
+    }
 }
 
 
@@ -220,6 +300,8 @@ static uint8_t DIAG_EntryWrite(uint8_t eventID, DIAG_EVENT_e event, uint8_t item
 
     uint8_t ret_val = 0;
     uint8_t c;
+    uint8_t ch = diag.id2ch[eventID];
+    DIAG_EVENT_e lastevent;
     RTC_Time_s currTime;
     RTC_Date_s currDate;
     uint8_t buf[25] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}; // max. description length = 24 + 1 to identify end of array
@@ -227,20 +309,19 @@ static uint8_t DIAG_EntryWrite(uint8_t eventID, DIAG_EVENT_e event, uint8_t item
     if(diag_locked)
         return ret_val;    // only locked when clearing the diagnosis memory
 
-    if(diag.entry_event[eventID] == event)
+    lastevent = DIAG_GetEntryEvent(ch);
+    if(lastevent == event)
         return ret_val;        // same event of same error type already recorded before -> ignore until event toggles
-    if((diag.entry_event[eventID] == DIAG_EVENT_OK) && (event ==  DIAG_EVENT_RESET))
+    if((lastevent == DIAG_EVENT_OK) && (event ==  DIAG_EVENT_RESET))
         return ret_val;     // do record DIAG_EVENT_RESET-event only if last event was an error (re-initialization)
                             // meaning: DIAG_EVENT_RESET-event at first time call or after DIAG_EVENT_OK-event will not be recorded
 
-    if(++diag.entry_cnt[eventID] > DIAG_MAX_ENTRIES_OF_ERROR){
-        diag.entry_cnt[eventID] = DIAG_MAX_ENTRIES_OF_ERROR;
+    if(++diag.entry_cnt[ch] > DIAG_MAX_ENTRIES_OF_ERROR){
+        diag.entry_cnt[ch] = DIAG_MAX_ENTRIES_OF_ERROR;
         return ret_val;        // this type of error has been recorded too many times -> ignore to avoid filling buffer with same failurecodes
     }
 
-    if( diag_entry_wrptr >= &diag_memory[DIAG_FAIL_ENTRY_LENGTH] ) {
-        diag_entry_wrptr = &diag_memory[0];
-    }
+    diag_entry_wrptr = &diag_memory[diag_entry_wrcnt % DIAG_FAIL_ENTRY_LENGTH];
 
     // now record failurecode
     ret_val=0xFF;
@@ -262,15 +343,17 @@ static uint8_t DIAG_EntryWrite(uint8_t eventID, DIAG_EVENT_e event, uint8_t item
     diag_entry_wrptr->Val1 = diag_fc.Val1;
     diag_entry_wrptr->Val2 = diag_fc.Val2;
     diag_entry_wrptr->Val3 = diag_fc.Val3;
-    ++diag_entry_wrptr;
 
-    ++diag.errcntreported;         // counts of (new) diagnosis entry records which is still not been read by external Tool
-                                   // which will reset this value to 0 after having read all new entries which means <acknowledged by user>
+    __DMB();                       // entry must be complete before it is published to the readout
+    ++diag_entry_wrcnt;
+    diag_entry_wrptr = &diag_memory[diag_entry_wrcnt % DIAG_FAIL_ENTRY_LENGTH];
+
     ++diag.errcnttotal;            // total counts of diagnosis entry records
+                                   // diag.errcntreported is updated by the readout, see DIAG_UpdateReadCursor()
 
-    diag.entry_event[eventID] = event;
+    DIAG_SetEntryEvent(ch, event);
     DEBUG_PRINTF((const uint8_t * )"New Error entry! (");
-    c = (uint8_t) diag.errcntreported;
+    c = (uint8_t)(diag_entry_wrcnt - diag_entry_rdcnt);
     DEBUG_PRINTF(U8ToDecascii(buf, &c,3));
     DEBUG_PRINTF((const uint8_t * )"): Error Code/Item ");
     DEBUG_PRINTF(U8ToDecascii(buf, &eventID,3));
@@ -280,7 +363,7 @@ static uint8_t DIAG_EntryWrite(uint8_t eventID, DIAG_EVENT_e event, uint8_t item
 
     // Copy error description  in buffer, maximum description length = 24 characters
     for(uint8_t i = 0; i < 24; i++)
-        buf[i] = diag_devptr->ch_cfg[diag.id2ch[eventID]].description[i];
+        buf[i] = diag_devptr->ch_cfg[ch].description[i];
 
     DEBUG_PRINTF((const uint8_t *)buf);
 
@@ -298,12 +381,167 @@ static uint8_t DIAG_EntryWrite(uint8_t eventID, DIAG_EVENT_e event, uint8_t item
 
 
 
+/**
+ * @brief   updates the number of unread entries in diag.errcntreported
+ *
+ * The value is derived from the free running counters instead of being incremented and
+ * decremented. It is only written by the readout (DIAG_GetUnreadEntries(),
+ * DIAG_AcknowledgeEntries()), DIAG_EntryWrite() does not touch it.
+ *
+ * @return  void
+ */
+static void DIAG_UpdateReadCursor(void) {
+    uint32_t unread = diag_entry_wrcnt - diag_entry_rdcnt;
+
+    if(unread > DIAG_FAIL_ENTRY_LENGTH)
+        unread = DIAG_FAIL_ENTRY_LENGTH;    // older entries have been overwritten
+
+    diag.errcntreported = (uint16_t)unread;
+}
+
+
+uint16_t DIAG_GetUnreadEntries(uint32_t *lost) {
+    uint32_t wrcnt = diag_entry_wrcnt;
+    uint32_t unread = wrcnt - diag_entry_rdcnt;
+
+    if(lost != NULL_PTR)
+        *lost = 0;
+
+    if(unread > DIAG_FAIL_ENTRY_LENGTH) {
+        /* writer overtook the read cursor: skip overwritten entries */
+        if(lost != NULL_PTR)
+            *lost = unread - DIAG_FAIL_ENTRY_LENGTH;
+        diag_entry_rdcnt = wrcnt - DIAG_FAIL_ENTRY_LENGTH;
+        diag_entry_rdptr = &diag_memory[diag_entry_rdcnt % DIAG_FAIL_ENTRY_LENGTH];
+        unread = DIAG_FAIL_ENTRY_LENGTH;
+    }
+    DIAG_UpdateReadCursor();
+
+    return (uint16_t)unread;
+}
+
+
+STD_RETURN_TYPE_e DIAG_ReadEntry(uint16_t offset, DIAG_ERROR_ENTRY_s *entry) {
+    uint32_t idx = diag_entry_rdcnt + offset;
+
+    if((uint32_t)offset >= (diag_entry_wrcnt - diag_entry_rdcnt))
+        return E_NOT_OK;    // entry not written yet
+
+    *entry = diag_memory[idx % DIAG_FAIL_ENTRY_LENGTH];
+    __DMB();
+
+    /* the copy is only valid if the slot has not been reused by DIAG_EntryWrite() meanwhile */
+    if((diag_entry_wrcnt - idx) >= DIAG_FAIL_ENTRY_LENGTH)
+        return E_NOT_OK;
+
+    return E_OK;
+}
+
+
+uint16_t DIAG_AcknowledgeEntries(uint16_t count) {
+    uint32_t unread = DIAG_GetUnreadEntries(NULL_PTR);
+
+    if(count > unread)
+        count = (uint16_t)unread;
+
+    diag_entry_rdcnt += count;
+    diag_entry_rdptr = &diag_memory[diag_entry_rdcnt % DIAG_FAIL_ENTRY_LENGTH];
+    DIAG_UpdateReadCursor();
+
+    return count;
+}
+
+
+/**
+ * @brief   writes a 32bit value little endian into a buffer
+ *
+ * @param   buf:    destination buffer
+ * @param   value:  value to write
+ *
+ * @return  pointer behind the written value
+ */
+static uint8_t *DIAG_PutU32(uint8_t *buf, uint32_t value) {
+    *buf++ = (uint8_t)value;
+    *buf++ = (uint8_t)(value >> 8);
+    *buf++ = (uint8_t)(value >> 16);
+    *buf++ = (uint8_t)(value >> 24);
+    return buf;
+}
+
+
+uint16_t DIAG_ReadoutCommand(const uint8_t *request, uint16_t reqlength, uint8_t *response, uint16_t maxlength) {
+    uint8_t *ptr = response;
+    uint16_t arg;
+    uint32_t lost;
+    uint16_t unread;
+    DIAG_ERROR_ENTRY_s entry;
+
+    if((reqlength < DIAG_READOUT_REQUEST_LENGTH) || (maxlength < DIAG_READOUT_RESPONSE_MAXLENGTH))
+        return 0;
+
+    arg = (uint16_t)request[1] | ((uint16_t)request[2] << 8);
+    *ptr++ = request[0];
+
+    switch(request[0]) {
+        case DIAG_READOUT_CMD_STATUS:
+            unread = DIAG_GetUnreadEntries(&lost);
+            *ptr++ = DIAG_READOUT_RESPONSE_OK;
+            ptr = DIAG_PutU32(ptr, unread);
+            ptr = DIAG_PutU32(ptr, lost);
+            ptr = DIAG_PutU32(ptr, diag_entry_rdcnt);
+            ptr = DIAG_PutU32(ptr, diag_entry_wrcnt);
+            break;
+
+        case DIAG_READOUT_CMD_READ:
+            if(DIAG_ReadEntry(arg, &entry) != E_OK) {
+                *ptr++ = DIAG_READOUT_RESPONSE_NOT_OK;
+                break;
+            }
+            *ptr++ = DIAG_READOUT_RESPONSE_OK;
+            *ptr++ = entry.JJ;
+            *ptr++ = entry.MM;
+            *ptr++ = entry.DD;
+            *ptr++ = entry.hh;
+            *ptr++ = entry.mm;
+            *ptr++ = entry.ss;
+            *ptr++ = (uint8_t)entry.event;
+            *ptr++ = (uint8_t)entry.event_id;
+            *ptr++ = entry.item;
+            ptr = DIAG_PutU32(ptr, entry.Val0);
+            ptr = DIAG_PutU32(ptr, entry.Val1);
+            ptr = DIAG_PutU32(ptr, entry.Val2);
+            ptr = DIAG_PutU32(ptr, entry.Val3);
+            break;
+
+        case DIAG_READOUT_CMD_ACK:
+            *ptr++ = DIAG_READOUT_RESPONSE_OK;
+            ptr = DIAG_PutU32(ptr, DIAG_AcknowledgeEntries(arg));
+            break;
+
+        default:
+            *ptr++ = DIAG_READOUT_RESPONSE_NOT_OK;
+            break;
+    }
+
+    return (uint16_t)(ptr - response);
+}
+
+
 DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint8_t item_nr, void* data) {
 
     DIAG_RETURNTYPE_e retVal = DIAG_HANDLER_RETURN_UNKNOWN;
+    DIAG_TYPE_e diagType;
+
+    if(diag.state == DIAG_STATE_UNINITIALIZED) {
+        return (DIAG_HANDLER_RETURN_NOT_READY);
+    }
+
+    if((diag_ch_id >= DIAG_ID_MAX) || (diag.id2ch[diag_ch_id] == DIAG_ID2CH_UNCONFIGURED)) {
+        return (DIAG_HANDLER_RETURN_WRONG_ID);
+    }
 
     /* Get diagnosis type */
-    DIAG_TYPE_e diagType = diag_dev.ch_cfg[diag.id2ch[diag_ch_id]].type;
+    diagType = diag_dev.ch_cfg[diag.id2ch[diag_ch_id]].type;
 
     switch(diagType) {
     /* Call handler function depending on diagnosis type */
@@ -322,6 +560,7 @@ DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint
             break;
 
         case DIAG_CONT_TYPE:
+            retVal = DIAG_ContHandler(diag_ch_id, item_nr, (float *)data);
             break;
 
         default:
@@ -356,6 +595,7 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
     uint16_t cfg_threshold;
     uint16_t err_enable_idx;
     uint32_t err_enable_bitmask;
+    uint8_t ch;
 
     DIAG_TYPE_RECORDING_e recordingenabled;
 
@@ -363,7 +603,7 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
         return (DIAG_HANDLER_RETURN_NOT_READY);
     }
 
-    if(diag_ch_id >= DIAG_ID_MAX) {
+    if((diag_ch_id >= DIAG_ID_MAX) || (diag.id2ch[diag_ch_id] == DIAG_ID2CH_UNCONFIGURED)) {
         return (DIAG_HANDLER_RETURN_WRONG_ID);
     }
 
@@ -377,9 +617,10 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
 
     u32ptr_errCodemsk   = &diag.errflag[err_enable_idx];
     u32ptr_warnCodemsk  = &diag.warnflag[err_enable_idx];
-    u16ptr_threshcounter = &diag.occurrence_cnt[diag_ch_id];
-    cfg_threshold       = diag_devptr->ch_cfg[diag.id2ch[diag_ch_id]].thresholds;
-    recordingenabled    = diag_devptr->ch_cfg[diag.id2ch[diag_ch_id]].enablerecording;
+    ch                  = diag.id2ch[diag_ch_id];
+    u16ptr_threshcounter = &diag.occurrence_cnt[ch];
+    cfg_threshold       = diag_devptr->ch_cfg[ch].thresholds;
+    recordingenabled    = diag_devptr->ch_cfg[ch].enablerecording;
 
     if(event == DIAG_EVENT_OK)
     {
@@ -388,7 +629,7 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
             //if (((*u16ptr_threshcounter) == 0) && (*u32ptr_errCodemsk == 0))
             if (((*u16ptr_threshcounter) == 0))
             {
-                ;   // everything ok, nothing to be handled
+                LAT_Abort(diag_ch_id);  // violation disappeared before the threshold
             }
             else if ((*u16ptr_threshcounter) > 1 )
             {
@@ -404,7 +645,8 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
                 if(recordingenabled==DIAG_RECORDING_ENABLED)
                     DIAG_EntryWrite(diag_ch_id,event,item_nr);
                 //////////////////////////////////////////////////////////////////////////////
-                diag_ch_cfg[diag.id2ch[diag_ch_id]].callbackfunc(diag_ch_id, DIAG_EVENT_RESET);
+                diag_ch_cfg[ch].callbackfunc(diag_ch_id, DIAG_EVENT_RESET);
+                (void)EVT_Post(EVT_DIAG_ERROR_RESET, diag_ch_id);
                 //////////////////////////////////////////////////////////////////////////////
             }
         }
@@ -434,7 +676,10 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
                 if(recordingenabled==DIAG_RECORDING_ENABLED)
                     DIAG_EntryWrite(diag_ch_id,event,item_nr);
                 //////////////////////////////////////////////////////////////////////////////
-                diag_ch_cfg[diag.id2ch[diag_ch_id]].callbackfunc(diag_ch_id, DIAG_EVENT_NOK);
+                LAT_MarkChannel(diag_ch_id, LAT_STAGE_THRESHOLD);
+                diag_ch_cfg[ch].callbackfunc(diag_ch_id, DIAG_EVENT_NOK);
+                LAT_MarkChannel(diag_ch_id, LAT_STAGE_ERRORFLAG);
+                (void)EVT_Post(EVT_DIAG_ERROR_SET, diag_ch_id);
                 //////////////////////////////////////////////////////////////////////////////
                 ret_val = DIAG_HANDLER_RETURN_ERR_OCCURRED; // Function returns an error-message!
             }
@@ -493,6 +738,87 @@ static DIAG_RETURNTYPE_e DIAG_GeneralHandler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT
     return (ret_val);
 }
 
+/**
+ * @brief DIAG_ContHandler counts the switching cycles of the contactors.
+ *
+ * Counters and accumulated I2t estimates are kept in the backup SRAM (bkpsram_contactors_count),
+ * each opening event is recorded with current and I2t estimate in diagContactorErrorMemory.
+ * The current is only known at the opening, the I2t of the arc is estimated from it
+ * with the assumed arcing time DIAG_CONTACTOR_ARCING_TIME_MS and is not measured.
+ * The costs are constant (no rescan of the backup SRAM data), so it can be called on
+ * every interlock transition from the 1ms task.
+ *
+ * @param   diag_ch_id: DIAG_CH_CONTACTOR_CLOSING, DIAG_CH_CONTACTOR_OPENING or DIAG_CH_CONTACTOR_DAMAGED
+ * @param   cont_nr:    number of the contactor
+ * @param   current:    pointer to current at switching in mA, NULL_PTR if unknown
+ *
+ * @return  DIAG_HANDLER_RETURN_OK if event was counted,\n
+ *          DIAG_HANDLER_RETURN_ERR_OCCURRED if contactor was opened at a current above DIAG_CONTACTOR_HARD_OPENING_CURRENT_MA,\n
+ *          DIAG_HANDLER_INVALID_DATA if invalid contactor number,\n
+ *          DIAG_HANDLER_INVALID_TYPE if channel is not a contactor channel
+ */
+static DIAG_RETURNTYPE_e DIAG_ContHandler(DIAG_CH_ID_e diag_ch_id, uint8_t cont_nr, float *current) {
+    DIAG_RETURNTYPE_e ret_val = DIAG_HANDLER_RETURN_OK;
+    DIAG_CONTACTOR_s *cont_cnt = &bkpsram_contactors_count.data;
+    RTC_Time_s currTime;
+    RTC_Date_s currDate;
+    float current_A = 0.0f;
+    float abs_current_mA = 0.0f;
+    uint32_t i2t_estimate = 0;
+
+    if(cont_nr >= BS_NR_OF_CONTACTORS)
+        return (DIAG_HANDLER_INVALID_DATA);
+
+    if(current != NULL_PTR) {
+        abs_current_mA = (*current < 0.0f) ? -(*current) : *current;
+        current_A = abs_current_mA/1000.0f;
+    }
+
+    if(diag_ch_id == DIAG_CH_CONTACTOR_CLOSING) {
+        BKPSRAM_Inc_contactorcnt(&cont_cnt->cont_switch_closed[cont_nr]);
+        return (ret_val);
+    }
+
+    if((diag_ch_id != DIAG_CH_CONTACTOR_OPENING) && (diag_ch_id != DIAG_CH_CONTACTOR_DAMAGED))
+        return (DIAG_HANDLER_INVALID_TYPE);
+
+    /* I2t estimate of the opening event */
+    i2t_estimate = (uint32_t)(current_A*current_A*DIAG_CONTACTOR_ARCING_TIME_MS + 0.5f);
+
+    BKPSRAM_Inc_contactorcnt(&cont_cnt->cont_switch_opened[cont_nr]);
+    BKPSRAM_Add_contactori2testimate(cont_nr, i2t_estimate);
+
+    if((diag_ch_id == DIAG_CH_CONTACTOR_DAMAGED) || (abs_current_mA > DIAG_CONTACTOR_HARD_OPENING_CURRENT_MA)) {
+        BKPSRAM_Inc_contactorcnt(&cont_cnt->cont_switch_opened_hard_at_current[cont_nr]);
+        BKPSRAM_Inc_contactorcnt(&cont_cnt->errcntreported);
+        ret_val = DIAG_HANDLER_RETURN_ERR_OCCURRED;
+    }
+
+    if(diag_locked)
+        return (ret_val);    // only locked when clearing the diagnosis memory
+
+    if(diagContactorError_entry_wrptr >= &diagContactorErrorMemory[DIAG_FAIL_ENTRY_CONTACTOR_LENGTH])
+        diagContactorError_entry_wrptr = &diagContactorErrorMemory[0];
+
+    RTC_getTime(&currTime);
+    RTC_getDate(&currDate);
+
+    diagContactorError_entry_wrptr->JJ = currDate.Year;
+    diagContactorError_entry_wrptr->MM = currDate.Month;
+    diagContactorError_entry_wrptr->DD = currDate.Date;
+    diagContactorError_entry_wrptr->hh = currTime.Hours;
+    diagContactorError_entry_wrptr->mm = currTime.Minutes;
+    diagContactorError_entry_wrptr->ss = currTime.Seconds;
+    diagContactorError_entry_wrptr->contactor = cont_nr;
+    diagContactorError_entry_wrptr->openingCurrent = (current != NULL_PTR) ? *current : 0.0f;
+    diagContactorError_entry_wrptr->i2t_estimate = i2t_estimate;
+
+    if(++diagContactorError_entry_wrptr >= &diagContactorErrorMemory[DIAG_FAIL_ENTRY_CONTACTOR_LENGTH])
+        diagContactorError_entry_wrptr = &diagContactorErrorMemory[0];
+
+    return (ret_val);
+}
+
 /**
  * @brief overall system monitoring
  *
@@ -505,10 +831,6 @@ void DIAG_SysMon(void)
 {
     DIAG_SYSMON_MODULE_ID_e module_id;
     uint32_t localTimer = MCU_GetTimeStamp();
-    if (diagsysmonTimestamp == localTimer) {
-        return;
-    }
-    diagsysmonTimestamp = localTimer;
 
     /* check modules */
     for (module_id = 0; module_id < DIAG_SYSMON_MODULE_ID_MAX; module_id++)
@@ -555,6 +877,26 @@ void DIAG_SysMon(void)
         diag_sysmon_last[module_id] = diag_sysmon[module_id];      /*save last values for next check*/
     }
 
+    /* check CPU load and stack high-water marks, once per load report */
+    if (OS_UpdateLoad(localTimer) == TRUE) {
+        if (OS_GetLoadTasksOverflow() != 0) {
+            /* more tasks than OS_LOAD_MAX_TASKS: load and stacks are not supervised */
+            DIAG_Handler(DIAG_CH_CPU_LOAD, DIAG_EVENT_NOK, (uint8_t)OS_GetLoadTasksOverflow(), NULL);
+            DIAG_Handler(DIAG_CH_STACK_HEADROOM, DIAG_EVENT_NOK, (uint8_t)OS_GetLoadTasksOverflow(), NULL);
+        } else {
+            if (OS_GetUtilization() > ((100 - DIAG_CPU_LOAD_HEADROOM_PERCENT) * 10000)) {
+                DIAG_Handler(DIAG_CH_CPU_LOAD, DIAG_EVENT_NOK, 0, NULL);
+            } else {
+                DIAG_Handler(DIAG_CH_CPU_LOAD, DIAG_EVENT_OK, 0, NULL);
+            }
+
+            if (OS_GetStackFreeMin() < DIAG_STACK_MIN_FREE_WORDS) {
+                DIAG_Handler(DIAG_CH_STACK_HEADROOM, DIAG_EVENT_NOK, 0, NULL);
+            } else {
+                DIAG_Handler(DIAG_CH_STACK_HEADROOM, DIAG_EVENT_OK, 0, NULL);
+            }
+        }
+    }
 }
 
 
@@ -570,6 +912,118 @@ void DIAG_SysMonNotify(DIAG_SYSMON_MODULE_ID_e module_id, uint32_t state) {
 }
 
 
+uint8_t DIAG_CrashFrameValid(uint32_t *stackframe) {
+    if((stackframe != NULL_PTR) && DIAG_ADDR_IN_RAM((uint32_t)stackframe) && DIAG_ADDR_IN_RAM((uint32_t)(stackframe + 7))) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+
+void DIAG_CrashDump(uint32_t *stackframe, uint32_t exc_return, uint32_t sp, DIAG_FAULT_SOURCE_e source) {
+    uint32_t *stackptr;
+    uint32_t i;
+
+    diag_crashdump.magic = 0;   // invalid until dump is complete
+
+    diag_crashdump.source = source;
+    diag_crashdump.task = 0;
+    diag_crashdump.exc_return = exc_return;
+    diag_crashdump.cfsr = SCB->CFSR;
+    diag_crashdump.hfsr = SCB->HFSR;
+    diag_crashdump.mmfar = SCB->MMFAR;
+    diag_crashdump.bfar = SCB->BFAR;
+    diag_crashdump.fault_timestamp = MCU_GetTimeStamp();
+
+    for(i = 0; i < 8; i++)
+        diag_crashdump.frame[i] = 0;
+
+    if(DIAG_CrashFrameValid(stackframe) == TRUE) {
+        for(i = 0; i < 8; i++)
+            diag_crashdump.frame[i] = stackframe[i];
+
+        /* stack of the faulting context starts above the basic (8 words) or extended (26 words) frame */
+        stackptr = stackframe + (((exc_return & 0x10) == 0) ? 26 : 8);
+    } else {
+        stackptr = (uint32_t *)sp;
+    }
+    diag_crashdump.sp = (uint32_t)stackptr;
+
+    /* copy stack window as long as it is inside RAM */
+    for(i = 0; (i < DIAG_CRASHDUMP_STACK_WORDS) && DIAG_ADDR_IN_RAM((uint32_t)stackptr); i++)
+        diag_crashdump.stack[i] = *stackptr++;
+    diag_crashdump.stack_words = i;
+
+    for(; i < DIAG_CRASHDUMP_STACK_WORDS; i++)
+        diag_crashdump.stack[i] = 0;
+
+    RTC_getTime(&diag_crashdump.fault_rtctime);
+    RTC_getDate(&diag_crashdump.fault_rtcdate);
+    diag_crashdump.boot_to_safe_ms = 0;
+    diag_crashdump.fault_to_safe_ms = 0;
+
+    diag_crashdump.count++;
+    diag_crashdump.resetpending = 1;
+    diag_crashdump.magic = DIAG_CRASHDUMP_MAGIC;
+    __DSB();
+}
+
+
+void DIAG_CrashReset(void) {
+#if DIAG_CRASHDUMP_RESET_ENABLE == TRUE
+    NVIC_SystemReset();
+#endif
+    while (1) {
+        ;
+    }
+}
+
+
+uint8_t DIAG_CrashResetPending(void) {
+    if((diag_crashdump.magic == DIAG_CRASHDUMP_MAGIC) && (diag_crashdump.resetpending == 1))
+        return TRUE;
+    return FALSE;
+}
+
+
+/**
+ * @brief   converts the RTC time of day into ms
+ *
+ * @param   time: RTC time including sub seconds
+ *
+ * @return  ms since midnight
+ */
+static uint32_t DIAG_RtcTimeToMs(RTC_Time_s *time) {
+    uint32_t ms = (((uint32_t)time->Hours*60 + time->Minutes)*60 + time->Seconds)*1000;
+
+    ms += ((time->SecondFraction - time->SubSeconds)*1000)/(time->SecondFraction + 1);
+    return ms;
+}
+
+
+void DIAG_CrashRecoveryDone(void) {
+    RTC_Time_s currTime;
+    RTC_Date_s currDate;
+    uint32_t fault_ms;
+    uint32_t now_ms;
+
+    if(DIAG_CrashResetPending() == FALSE)
+        return;
+
+    diag_crashdump.boot_to_safe_ms = MCU_GetTimeStamp();
+
+    RTC_getTime(&currTime);
+    RTC_getDate(&currDate);     // unlocks the RTC shadow registers after reading the time
+    fault_ms = DIAG_RtcTimeToMs(&diag_crashdump.fault_rtctime);
+    now_ms = DIAG_RtcTimeToMs(&currTime);
+    if(now_ms < fault_ms)
+        now_ms += 24*60*60*1000;    // midnight passed
+    diag_crashdump.fault_to_safe_ms = now_ms - fault_ms;
+
+    diag_crashdump.resetpending = 0;
+}
+
+
 void DIAG_configASSERT(void) {
 
 #ifdef STM32F4
@@ -579,6 +1033,8 @@ void DIAG_configASSERT(void) {
     __ASM volatile ("mov %0, r14" : "=r" (lr_register) );
     __ASM volatile ("mov %0, r13" : "=r" (sp_register) );
 
+    DIAG_CrashDump(NULL_PTR, lr_register, sp_register, DIAG_FAULT_CONFIGASSERT);
+
     lr_register = lr_register & 0xFFFFFFFE;     // mask out LSB as this only is indicates thumb instruction
     diag_fc.Val0 = sp_register;                 // actual stack pointer
     diag_fc.Val1 = lr_register;                 // report instruction address where this function has been called
@@ -586,7 +1042,5 @@ void DIAG_configASSERT(void) {
     DIAG_Handler(DIAG_CH_CONFIGASSERT,DIAG_EVENT_NOK,0, NULL);
 #endif
 
-    while (1) {
-        ;
-    }
+    DIAG_CrashReset();
 }
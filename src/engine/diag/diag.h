@@ -109,7 +109,9 @@ typedef struct {
 //    DIAG_EVENT_e event;
 //    DIAG_CH_ID_e event_id;
     uint8_t contactor;
-    float openingCurrent;
+    float openingCurrent;       /*!< current at opening in mA */
+    uint32_t i2t_estimate;      /*!< I2t estimate of the opening event in A^2*ms, opening current^2 *
+                                     DIAG_CONTACTOR_ARCING_TIME_MS, not an integration of the current */
 } DIAG_CONTACTOR_ERROR_ENTRY_s;
 
 /**
@@ -120,7 +122,8 @@ typedef struct {
     uint16_t cont_switch_opened[BS_NR_OF_CONTACTORS];
     uint16_t cont_switch_opened_hard_at_current[BS_NR_OF_CONTACTORS];
     uint16_t errcntreported;          /*!<  number of hard switches occurred since last call of DIAG_PrintContactorInfo */
-    uint16_t reserved[11];            /*!< reserved for future use */
+    uint16_t reserved[1];             /*!< reserved for future use, keeps i2t_estimate_opened 32bit aligned */
+    uint32_t i2t_estimate_opened[BS_NR_OF_CONTACTORS]; /*!< accumulated I2t estimates of all opening events in A^2*ms (saturating) */
 } DIAG_CONTACTOR_s;
 
 // FIXME doxygen comment missing
@@ -131,14 +134,105 @@ typedef struct {
     uint32_t Val3;
 } DIAG_FAILURECODE_s;
 
-// FIXME doxygen comment missing, maybe even with explanation of struct member or use ///< comments
+/**
+ * @ingroup API_DIAG
+ * commands of the incremental readout of the diagnosis memory (first byte of a request).
+ * A request consists of the command byte followed by a 16bit argument (little endian).
+ *  - DIAG_READOUT_CMD_STATUS: response: cmd, result, unread, lost, read counter, write counter (4 bytes each)
+ *  - DIAG_READOUT_CMD_READ:   argument: offset to read cursor; response: cmd, result, entry (25 bytes)
+ *  - DIAG_READOUT_CMD_ACK:    argument: number of entries to acknowledge; response: cmd, result, acknowledged entries
+ */
+#define DIAG_READOUT_CMD_STATUS             (0x01)
+#define DIAG_READOUT_CMD_READ               (0x02)
+#define DIAG_READOUT_CMD_ACK                (0x03)
+
+#define DIAG_READOUT_RESPONSE_OK            (0x00)
+#define DIAG_READOUT_RESPONSE_NOT_OK        (0x01)
+
+/**
+ * length of a readout request and maximum length of a response in bytes
+ */
+#define DIAG_READOUT_REQUEST_LENGTH         (3)
+#define DIAG_READOUT_RESPONSE_MAXLENGTH     (27)
+
+/**
+ * layout version of the diagnosis memory in backup SRAM ('D', 'G', version).
+ * Must be incremented whenever variables are added to or removed from the
+ * backup SRAM, DIAG_Init() then clears the diagnosis memory once.
+ */
+#define DIAG_BKPSRAM_LAYOUT                 (0x44470003)
+
+/**
+ * marker of a valid crash dump in backup SRAM
+ */
+#define DIAG_CRASHDUMP_MAGIC                (0x4641554C)
+
+/**
+ * source of a crash dump: exception number of the fault, stack overflow hook or configASSERT
+ */
+typedef enum {
+    DIAG_FAULT_HARDFAULT        = 3,    /*!< hard fault exception           */
+    DIAG_FAULT_MEMMANAGE        = 4,    /*!< memory management exception    */
+    DIAG_FAULT_BUSFAULT         = 5,    /*!< bus fault exception            */
+    DIAG_FAULT_USAGEFAULT       = 6,    /*!< usage fault exception          */
+    DIAG_FAULT_STACKOVERFLOW    = 0xFE, /*!< FreeRTOS stack overflow hook   */
+    DIAG_FAULT_CONFIGASSERT     = 0xFF, /*!< FreeRTOS configASSERT          */
+} DIAG_FAULT_SOURCE_e;
+
+/**
+ * crash dump of the last fault, located in backup SRAM
+ *
+ * Written by the fault handler before the controlled reset. The recovery times are
+ * filled in when the system reaches normal operation again after the reset.
+ */
+typedef struct {
+    uint32_t magic;                                 /*!< DIAG_CRASHDUMP_MAGIC if dump is valid */
+    uint32_t resetpending;                          /*!< 1 between fault reset and reaching normal operation */
+    uint32_t count;                                 /*!< number of captured faults */
+    uint32_t source;                                /*!< DIAG_FAULT_SOURCE_e */
+    uint32_t task;                                  /*!< task number of DIAG_FAULT_STACKOVERFLOW, 0 otherwise */
+    uint32_t exc_return;                            /*!< EXC_RETURN (LR at exception entry), LR for configASSERT and stack overflow */
+    uint32_t sp;                                    /*!< stack pointer of the faulting context */
+    uint32_t frame[8];                              /*!< exception frame: r0, r1, r2, r3, r12, lr, pc, xpsr */
+    uint32_t cfsr;                                  /*!< configurable fault status register */
+    uint32_t hfsr;                                  /*!< hard fault status register */
+    uint32_t mmfar;                                 /*!< memory management fault address register */
+    uint32_t bfar;                                  /*!< bus fault address register */
+    uint32_t stack_words;                           /*!< number of valid words in stack[] */
+    uint32_t stack[DIAG_CRASHDUMP_STACK_WORDS];     /*!< stack window above the exception frame */
+    uint32_t fault_timestamp;                       /*!< MCU_GetTimeStamp() at fault */
+    RTC_Time_s fault_rtctime;                       /*!< RTC time at fault */
+    RTC_Date_s fault_rtcdate;                       /*!< RTC date at fault */
+    uint32_t boot_to_safe_ms;                       /*!< time from reset to normal operation in ms */
+    uint32_t fault_to_safe_ms;                      /*!< time from fault to normal operation in ms (RTC based) */
+} DIAG_CRASHDUMP_s;
+
+/**
+ * id2ch[] value of diagnosis ids without entry in diag_ch_cfg[]
+ */
+#define DIAG_ID2CH_UNCONFIGURED     (0xFF)
+
+/**
+ * number of 32bit words needed to store the 2bit event states of all configured channels
+ */
+#define DIAG_ENTRY_EVENT_WORDS      ((DIAG_CH_CFG_MAX+15)/16)
+
+/**
+ * runtime data of the diagnosis module
+ *
+ * The last recorded event (DIAG_EVENT_e, 2 bits) and the counters are only
+ * kept for configured channels and are indexed by the channel index taken from
+ * id2ch[], not by the diagnosis id. With DIAG_ID_MAX = 96 and
+ * DIAG_CH_CFG_MAX = 64 this needs 16 + 64 + 128 = 208 bytes instead of
+ * 384 + 96 + 192 = 672 bytes for entry_event, entry_cnt and occurrence_cnt.
+ */
 typedef struct {
     DIAG_STATE_e    state;                                  /*!< actual state of diagnosis module */
     uint16_t        errcnttotal;                            /*!< total counts of diagnosis entry records*/
-    uint16_t        errcntreported;                         /*!< reported error counts to external tool*/
-    uint32_t        entry_event[DIAG_ID_MAX];               /*!< last detected entry event*/
-    uint8_t         entry_cnt[DIAG_ID_MAX];                 /*!< reported event counter used for limitation  */
-    uint16_t         occurrence_cnt[DIAG_ID_MAX];            /*!< */
+    uint16_t        errcntreported;                         /*!< recorded entries not yet acknowledged by external tool, written by the readout only */
+    uint32_t        entry_event[DIAG_ENTRY_EVENT_WORDS];    /*!< last detected entry event, 2 bits per channel index */
+    uint8_t         entry_cnt[DIAG_CH_CFG_MAX];             /*!< reported event counter used for limitation, per channel index */
+    uint16_t        occurrence_cnt[DIAG_CH_CFG_MAX];        /*!< threshold counter, per channel index */
     uint8_t         id2ch[DIAG_ID_MAX];                     /*!< diagnosis-id to configuration channel selector*/
     uint8_t         nr_of_ch;                               /*!< number of configured channels*/
     uint32_t        errflag[(DIAG_ID_MAX+31)/32];           /*!< detected error   flags (bit_nr = diag_id ) */
@@ -152,6 +246,11 @@ extern DIAG_FAILURECODE_s diag_fc;
 // FIXME doxygen comment missing
 //extern DIAG_s diag;
 
+/**
+ * crash dump of the last fault (backup SRAM)
+ */
+extern DIAG_CRASHDUMP_s diag_crashdump;
+
 /*================== Function Prototypes ==================================*/
 
 /**
@@ -187,6 +286,109 @@ extern DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e even
  */
 extern void DIAG_Init(DIAG_DEV_s *diag_dev_pointer);
 
+/**
+ * @brief   returns the number of recorded but not yet acknowledged entries of the diagnosis memory
+ * @ingroup API_DIAG
+ *
+ * If more entries have been recorded than fit into the diagnosis memory since the last
+ * acknowledge, the read cursor is moved to the oldest available entry.
+ *
+ * @param   lost:   if not NULL_PTR, number of overwritten entries that have been skipped
+ *
+ * @return  number of unread entries
+ */
+extern uint16_t DIAG_GetUnreadEntries(uint32_t *lost);
+
+/**
+ * @brief   copies an entry of the diagnosis memory without locking the recording
+ * @ingroup API_DIAG
+ *
+ * @param   offset: offset of the entry relative to the read cursor (0 = oldest unread entry)
+ * @param   entry:  destination of the copy
+ *
+ * @return  E_OK if the entry was copied, E_NOT_OK if it does not exist or has been overwritten during the copy
+ */
+extern STD_RETURN_TYPE_e DIAG_ReadEntry(uint16_t offset, DIAG_ERROR_ENTRY_s *entry);
+
+/**
+ * @brief   acknowledges read entries and advances the read cursor (diag_entry_rdptr)
+ * @ingroup API_DIAG
+ *
+ * @param   count:  number of entries to acknowledge
+ *
+ * @return  number of acknowledged entries (limited to the unread entries)
+ */
+extern uint16_t DIAG_AcknowledgeEntries(uint16_t count);
+
+/**
+ * @brief   processes one request of the incremental readout protocol
+ * @ingroup API_DIAG
+ *
+ * Transport independent, called by the UART link of the external tool (COM_Trigger()).
+ * See DIAG_READOUT_CMD_STATUS for the request and response format.
+ *
+ * @param   request:    received request
+ * @param   reqlength:  length of the request
+ * @param   response:   buffer for the response
+ * @param   maxlength:  size of the response buffer, at least DIAG_READOUT_RESPONSE_MAXLENGTH
+ *
+ * @return  length of the response, 0 if the request could not be processed
+ */
+extern uint16_t DIAG_ReadoutCommand(const uint8_t *request, uint16_t reqlength, uint8_t *response, uint16_t maxlength);
+
+/**
+ * @brief   saves exception frame, fault status registers and a stack window in backup SRAM
+ *
+ * Has to be called first in the fault handler, before anything else is done on the stack.
+ *
+ * @param   stackframe: exception frame of the faulting context (MSP or PSP), NULL_PTR if not available
+ * @param   exc_return: EXC_RETURN value of the exception entry, LR if not called from an exception
+ * @param   sp:         stack pointer of the faulting context, only used if stackframe is NULL_PTR
+ * @param   source:     DIAG_FAULT_SOURCE_e
+ *
+ * @return  void
+ */
+extern void DIAG_CrashDump(uint32_t *stackframe, uint32_t exc_return, uint32_t sp, DIAG_FAULT_SOURCE_e source);
+
+/**
+ * @brief   checks that an exception frame (8 words) lies completely inside SRAM or CCM RAM
+ *
+ * @details A corrupted stack pointer must not be dereferenced in the fault handlers,
+ *          otherwise a second fault (lockup) follows.
+ *
+ * @param   stackframe: exception frame of the faulting context
+ *
+ * @return  TRUE if stackframe[0..7] can be read, otherwise FALSE
+ */
+extern uint8_t DIAG_CrashFrameValid(uint32_t *stackframe);
+
+/**
+ * @brief   controlled reset after a fault (configurable by DIAG_CRASHDUMP_RESET_ENABLE)
+ *
+ * @return  void (does not return)
+ */
+extern void DIAG_CrashReset(void);
+
+/**
+ * @brief   checks if the last reset was triggered by DIAG_CrashReset()
+ *
+ * Only reads the backup SRAM, can be called before BKP_SRAM_Init() once the
+ * backup SRAM clock is enabled.
+ *
+ * @return  TRUE if fault reset is pending, otherwise FALSE
+ */
+extern uint8_t DIAG_CrashResetPending(void);
+
+/**
+ * @brief   records the time-to-safe-operation after a fault reset
+ *
+ * Called when the system reaches normal operation. Measures the time from the reset
+ * and from the fault and clears the pending fault reset.
+ *
+ * @return  void
+ */
+extern void DIAG_CrashRecoveryDone(void);
+
 /**
  * @brief   trap of configuration errors derived by FreeRTOS configASSERT
  *
@@ -0,0 +1,234 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    evt.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  EVT
+ *
+ * @brief   Event bus of the event handler and diagnosis tasks
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "evt.h"
+
+#include "os.h"
+#include "stm32f4xx_hal.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * queue of a consumer
+ *
+ * head counts the reserved slots (producers), tail the dispatched events (consumer).
+ * A slot is reserved before it is written, ready[] marks the written slots.
+ */
+typedef struct {
+    volatile uint32_t head;                     /*!< write index, incremented with LDREX/STREX  */
+    volatile uint32_t tail;                     /*!< read index, only written by the consumer   */
+    EVT_EVENT_s event[EVT_QUEUE_LENGTH];        /*!< events                                     */
+    volatile uint8_t ready[EVT_QUEUE_LENGTH];   /*!< TRUE if the event of the slot is written   */
+    xSemaphoreHandle wakeup;                    /*!< given by EVT_Post(), taken by EVT_Wait()   */
+} EVT_QUEUE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+static EVT_QUEUE_s evt_queue[EVT_NR_OF_CONSUMERS];
+
+static EVT_STATISTICS_s evt_statistics[EVT_NR_OF_TYPES];
+
+/*================== Function Prototypes ==================================*/
+static void EVT_AtomicIncrement(volatile uint32_t *counter);
+static void EVT_WakeUp(EVT_QUEUE_s *queue);
+
+/*================== Function Implementations =============================*/
+
+STD_RETURN_TYPE_e EVT_Init(void) {
+    STD_RETURN_TYPE_e retval = E_OK;
+    uint8_t c = 0;
+    uint8_t i = 0;
+
+    for (c = 0; c < EVT_NR_OF_CONSUMERS; c++) {
+        evt_queue[c].head = 0;
+        evt_queue[c].tail = 0;
+        for (i = 0; i < EVT_QUEUE_LENGTH; i++) {
+            evt_queue[c].ready[i] = FALSE;
+        }
+        evt_queue[c].wakeup = xSemaphoreCreateBinary();
+        if (evt_queue[c].wakeup == NULL) {
+            retval = E_NOT_OK;
+        }
+    }
+    return retval;
+}
+
+
+STD_RETURN_TYPE_e EVT_Post(EVT_TYPE_e type, uint32_t data) {
+    EVT_QUEUE_s *queue;
+    uint32_t head = 0;
+    uint32_t slot = 0;
+
+    if (type >= EVT_NR_OF_TYPES) {
+        return E_NOT_OK;
+    }
+    queue = &evt_queue[evt_type_cfg[type].consumer];
+
+    /* reserve a slot, retried if another producer (or an interrupt) reserved in between */
+    do {
+        head = __LDREXW(&queue->head);
+        if ((head - queue->tail) >= EVT_QUEUE_LENGTH) {
+            __CLREX();
+            EVT_AtomicIncrement(&evt_statistics[type].dropped);
+            return E_NOT_OK;
+        }
+    } while (__STREXW(head + 1, &queue->head) != 0);
+
+    slot = head % EVT_QUEUE_LENGTH;
+    queue->event[slot].type = type;
+    queue->event[slot].data = data;
+    queue->event[slot].timestamp = DWT->CYCCNT;
+    __DMB();                        // event must be complete before it is marked ready
+    queue->ready[slot] = TRUE;
+
+    EVT_AtomicIncrement(&evt_statistics[type].posted);
+    EVT_WakeUp(queue);
+
+    return E_OK;
+}
+
+
+void EVT_Wait(EVT_CONSUMER_e consumer) {
+    if ((consumer < EVT_NR_OF_CONSUMERS) && (evt_queue[consumer].wakeup != NULL)) {
+        (void)xSemaphoreTake(evt_queue[consumer].wakeup, EVT_WAIT_TIMEOUT_MS / portTICK_PERIOD_MS);
+    } else {
+        osDelay(1);
+    }
+}
+
+
+uint32_t EVT_Dispatch(EVT_CONSUMER_e consumer) {
+    EVT_QUEUE_s *queue;
+    EVT_STATISTICS_s *statistics;
+    EVT_EVENT_s event;
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    uint32_t latency = 0;
+    uint32_t slot = 0;
+    uint32_t count = 0;
+
+    if (consumer >= EVT_NR_OF_CONSUMERS) {
+        return 0;
+    }
+    queue = &evt_queue[consumer];
+
+    while (queue->tail != queue->head) {
+        slot = queue->tail % EVT_QUEUE_LENGTH;
+        if (queue->ready[slot] == FALSE) {
+            /* reserved but not written yet, the producer wakes the consumer again */
+            break;
+        }
+        event = queue->event[slot];
+        queue->ready[slot] = FALSE;
+        __DMB();                    // slot must be released before it can be reserved again
+        queue->tail++;
+
+        latency = (DWT->CYCCNT - event.timestamp) / cycles_per_us;
+        statistics = &evt_statistics[event.type];
+        statistics->dispatched++;
+        statistics->latency_last_us = latency;
+        statistics->latency_sum_us += latency;
+        if (latency > statistics->latency_max_us) {
+            statistics->latency_max_us = latency;
+        }
+
+        evt_type_cfg[event.type].handler(&event);
+        count++;
+    }
+    return count;
+}
+
+
+void EVT_GetStatistics(EVT_TYPE_e type, EVT_STATISTICS_s *statistics) {
+    if (type < EVT_NR_OF_TYPES) {
+        OS_TaskEnter_Critical();
+        *statistics = evt_statistics[type];
+        OS_TaskExit_Critical();
+    }
+}
+
+
+/**
+ * @brief   increments a counter that is written by tasks and interrupts
+ *
+ * @param   counter:    counter
+ *
+ * @return  void
+ */
+static void EVT_AtomicIncrement(volatile uint32_t *counter) {
+    uint32_t value = 0;
+
+    do {
+        value = __LDREXW(counter);
+    } while (__STREXW(value + 1, counter) != 0);
+}
+
+
+/**
+ * @brief   gives the wake-up semaphore of the consumer
+ *
+ * In an interrupt the FromISR variant is used, but only if the priority of the
+ * interrupt allows calls of the FreeRTOS API. Reset, NMI and HardFault have a
+ * fixed negative priority and never call the API, the priorities of the other
+ * system exceptions are read from SCB->SHP instead of the NVIC.
+ *
+ * @param   queue:  queue of the consumer
+ *
+ * @return  void
+ */
+static void EVT_WakeUp(EVT_QUEUE_s *queue) {
+    BaseType_t woken = pdFALSE;
+    uint32_t exception = 0;
+    uint32_t priority = 0;
+
+    if (queue->wakeup == NULL) {
+        return;
+    }
+
+    if (OS_Check_Context() == 0) {
+        (void)xSemaphoreGive(queue->wakeup);
+    } else {
+        exception = SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk;
+        if (exception <= 3) {
+            return;     // reset, NMI, HardFault: consumer wakes up after EVT_WAIT_TIMEOUT_MS
+        } else if (exception < 16) {
+            priority = (uint32_t)SCB->SHP[exception - 4] >> (8 - configPRIO_BITS);
+        } else {
+            priority = NVIC_GetPriority((IRQn_Type)(exception - 16));
+        }
+        if (priority >= configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY) {
+            (void)xSemaphoreGiveFromISR(queue->wakeup, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+    }
+}
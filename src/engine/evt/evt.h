@@ -0,0 +1,119 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    evt.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  EVT
+ *
+ * @brief   Event bus of the event handler and diagnosis tasks
+ *
+ * Producers (tasks and interrupts) post typed events with EVT_Post(). Every
+ * consumer task has its own queue, a ring buffer that is written without locks:
+ * the slot is reserved with LDREX/STREX on the write index, so a producer never
+ * blocks and never disables interrupts. The consumer blocks in EVT_Wait() until
+ * an event is posted and calls the handlers of evt_type_cfg[] with EVT_Dispatch().
+ * The dispatch latency (post to handler call) is measured per event type.
+ */
+
+#ifndef EVT_H_
+#define EVT_H_
+
+/*================== Includes =============================================*/
+#include "evt_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * statistics of an event type
+ */
+typedef struct {
+    uint32_t posted;                /*!< events accepted by EVT_Post()                  */
+    uint32_t dropped;               /*!< events rejected because the queue was full     */
+    uint32_t dispatched;            /*!< events passed to the handler                   */
+    uint32_t latency_last_us;       /*!< dispatch latency of the last event in us       */
+    uint32_t latency_max_us;        /*!< longest dispatch latency in us                 */
+    uint64_t latency_sum_us;        /*!< sum of the dispatch latencies in us            */
+} EVT_STATISTICS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   initializes the queues and creates the wake-up semaphores of the consumers
+ *
+ * Called before the scheduler start (ENG_CreateEvent()). Without the semaphores
+ * the consumers poll their queue every 1ms.
+ *
+ * @return  E_OK if all semaphores were created, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e EVT_Init(void);
+
+/**
+ * @brief   posts an event to the queue of its consumer and wakes the consumer
+ *
+ * Can be called from tasks and interrupts. Interrupts above
+ * configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY do not wake the consumer,
+ * their events are dispatched at the latest after EVT_WAIT_TIMEOUT_MS.
+ *
+ * @param   type:   event type
+ * @param   data:   data of the event
+ *
+ * @return  E_OK if the event was queued, E_NOT_OK if the queue was full
+ */
+extern STD_RETURN_TYPE_e EVT_Post(EVT_TYPE_e type, uint32_t data);
+
+/**
+ * @brief   blocks the calling task until an event is posted to the consumer
+ *          or EVT_WAIT_TIMEOUT_MS has elapsed
+ *
+ * @param   consumer:   queue to wait for
+ *
+ * @return  void
+ */
+extern void EVT_Wait(EVT_CONSUMER_e consumer);
+
+/**
+ * @brief   calls the handlers of all queued events of the consumer in the order of posting
+ *
+ * @param   consumer:   queue to process
+ *
+ * @return  number of dispatched events
+ */
+extern uint32_t EVT_Dispatch(EVT_CONSUMER_e consumer);
+
+/**
+ * @brief   copies the statistics of an event type
+ *
+ * @param   type:       event type
+ * @param   statistics: destination
+ *
+ * @return  void
+ */
+extern void EVT_GetStatistics(EVT_TYPE_e type, EVT_STATISTICS_s *statistics);
+
+/*================== Function Implementations =============================*/
+
+#endif /* EVT_H_ */
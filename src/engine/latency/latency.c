@@ -0,0 +1,283 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    latency.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  LAT
+ *
+ * @brief   Measurement of the latency from a limit violation to the opening of the interlock
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "latency.h"
+
+#include "bms_cfg.h"
+#include "mcu.h"
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+#define LAT_GET_CYCLES()        (DWT->CYCCNT)
+#define LAT_GET_MS()            (MCU_GetTimeStamp())
+#define LAT_ENTER_CRITICAL()    OS_TaskEnter_Critical()
+#define LAT_EXIT_CRITICAL()     OS_TaskExit_Critical()
+
+/**
+ * running measurement of a channel
+ */
+typedef struct {
+    uint8_t next;                           /*!< next stage to timestamp, 0: no measurement running */
+    uint32_t stamp[LAT_NR_OF_STAGES];       /*!< cycle counter at the stages                        */
+} LAT_EPISODE_s;
+
+/*================== Constant and Variable Definitions ====================*/
+static LAT_EPISODE_s lat_episodes[LAT_NR_OF_CHANNELS];
+static LAT_STATISTICS_s lat_stats[LAT_NR_OF_CHANNELS];
+static uint32_t lat_cycles_per_us = 1;
+
+/*================== Function Prototypes ==================================*/
+static uint8_t LAT_GetIndex(DIAG_CH_ID_e id);
+static void LAT_Expire(uint32_t now);
+static void LAT_Complete(uint8_t idx);
+static uint8_t LAT_HistogramBin(uint32_t us);
+
+/*================== Function Implementations =============================*/
+
+void LAT_Init(void) {
+    LAT_STATISTICS_s empty = {0};
+    uint8_t i = 0;
+
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    if (SystemCoreClock >= 1000000) {
+        lat_cycles_per_us = SystemCoreClock / 1000000;
+    }
+
+    LAT_ENTER_CRITICAL();
+    for (i = 0; i < LAT_NR_OF_CHANNELS; i++) {
+        lat_episodes[i].next = 0;
+        lat_stats[i] = empty;
+    }
+    LAT_EXIT_CRITICAL();
+}
+
+
+void LAT_MarkSample(DIAG_CH_ID_e id, uint32_t sample_timestamp) {
+#if LAT_ENABLE == TRUE
+    uint8_t idx = LAT_GetIndex(id);
+    uint32_t now = 0;
+    uint32_t age_ms = 0;
+
+    if (idx >= LAT_NR_OF_CHANNELS) {
+        return;
+    }
+
+    LAT_ENTER_CRITICAL();
+    now = LAT_GET_CYCLES();
+    age_ms = LAT_GET_MS() - sample_timestamp;
+    LAT_Expire(now);
+    /* a sample older than the timeout is stale, the threshold crossing starts the measurement */
+    if ((lat_episodes[idx].next == 0) && (age_ms < LAT_EPISODE_TIMEOUT_MS)) {
+        lat_episodes[idx].stamp[LAT_STAGE_SAMPLE] = now - age_ms * 1000 * lat_cycles_per_us;
+        lat_episodes[idx].next = LAT_STAGE_THRESHOLD;
+    }
+    LAT_EXIT_CRITICAL();
+#endif
+}
+
+
+void LAT_MarkChannel(DIAG_CH_ID_e id, LAT_STAGE_e stage) {
+#if LAT_ENABLE == TRUE
+    uint8_t idx = LAT_GetIndex(id);
+    uint32_t now = 0;
+
+    if (idx >= LAT_NR_OF_CHANNELS) {
+        return;
+    }
+
+    LAT_ENTER_CRITICAL();
+    now = LAT_GET_CYCLES();
+    LAT_Expire(now);
+    if ((stage == LAT_STAGE_THRESHOLD) && (lat_episodes[idx].next == 0)) {
+        lat_episodes[idx].stamp[LAT_STAGE_SAMPLE] = now;
+        lat_episodes[idx].next = LAT_STAGE_THRESHOLD;
+    }
+    if (lat_episodes[idx].next == stage) {
+        lat_episodes[idx].stamp[stage] = now;
+        lat_episodes[idx].next++;
+    }
+    LAT_EXIT_CRITICAL();
+#endif
+}
+
+
+void LAT_Abort(DIAG_CH_ID_e id) {
+#if LAT_ENABLE == TRUE
+    uint8_t idx = LAT_GetIndex(id);
+
+    if (idx >= LAT_NR_OF_CHANNELS) {
+        return;
+    }
+
+    LAT_ENTER_CRITICAL();
+    if (lat_episodes[idx].next == LAT_STAGE_THRESHOLD) {
+        lat_episodes[idx].next = 0;
+    }
+    LAT_EXIT_CRITICAL();
+#endif
+}
+
+
+void LAT_Mark(LAT_STAGE_e stage) {
+#if LAT_ENABLE == TRUE
+    uint32_t now = 0;
+    uint8_t i = 0;
+
+    LAT_ENTER_CRITICAL();
+    now = LAT_GET_CYCLES();
+    LAT_Expire(now);
+    for (i = 0; i < LAT_NR_OF_CHANNELS; i++) {
+        if (lat_episodes[i].next == stage) {
+            lat_episodes[i].stamp[stage] = now;
+            lat_episodes[i].next++;
+            if (stage == LAT_STAGE_ILCK_OFF) {
+                LAT_Complete(i);
+                lat_episodes[i].next = 0;
+            }
+        }
+    }
+    LAT_EXIT_CRITICAL();
+#endif
+}
+
+
+STD_RETURN_TYPE_e LAT_GetStatistics(uint8_t idx, LAT_STATISTICS_s *stats) {
+    if (idx >= LAT_NR_OF_CHANNELS) {
+        return E_NOT_OK;
+    }
+
+    LAT_ENTER_CRITICAL();
+    *stats = lat_stats[idx];
+    LAT_EXIT_CRITICAL();
+    return E_OK;
+}
+
+
+/**
+ * @brief   returns the index of a channel in lat_channels[]
+ *
+ * @param   id:     DIAG channel
+ *
+ * @return  index, LAT_NR_OF_CHANNELS if the channel is not measured
+ */
+static uint8_t LAT_GetIndex(DIAG_CH_ID_e id) {
+    uint8_t i = 0;
+
+    for (i = 0; i < LAT_NR_OF_CHANNELS; i++) {
+        if (lat_channels[i].id == id) {
+            break;
+        }
+    }
+    return i;
+}
+
+
+/**
+ * @brief   drops the measurements that did not reach LAT_STAGE_ILCK_OFF within LAT_EPISODE_TIMEOUT_MS
+ *
+ * @param   now:    actual cycle counter
+ */
+static void LAT_Expire(uint32_t now) {
+    uint8_t i = 0;
+
+    for (i = 0; i < LAT_NR_OF_CHANNELS; i++) {
+        if ((lat_episodes[i].next != 0) &&
+                ((now - lat_episodes[i].stamp[LAT_STAGE_SAMPLE]) / lat_cycles_per_us > LAT_EPISODE_TIMEOUT_MS * 1000UL)) {
+            lat_episodes[i].next = 0;
+            lat_stats[i].incomplete++;
+        }
+    }
+}
+
+
+/**
+ * @brief   adds a measurement that reached LAT_STAGE_ILCK_OFF to the statistics of its channel
+ *
+ * @param   idx:    index in lat_channels[]
+ */
+static void LAT_Complete(uint8_t idx) {
+    LAT_EPISODE_s *episode = &lat_episodes[idx];
+    LAT_STATISTICS_s *stats = &lat_stats[idx];
+    uint32_t us = 0;
+    uint8_t bin = 0;
+    uint8_t s = 0;
+
+    for (s = LAT_STAGE_THRESHOLD; s < LAT_NR_OF_STAGES; s++) {
+        us = (episode->stamp[s] - episode->stamp[s - 1]) / lat_cycles_per_us;
+        if ((stats->count == 0) || (us < stats->stage_min_us[s])) {
+            stats->stage_min_us[s] = us;
+        }
+        if (us > stats->stage_max_us[s]) {
+            stats->stage_max_us[s] = us;
+        }
+    }
+
+    us = (episode->stamp[LAT_STAGE_ILCK_OFF] - episode->stamp[LAT_STAGE_SAMPLE]) / lat_cycles_per_us;
+    if ((stats->count == 0) || (us < stats->total_min_us)) {
+        stats->total_min_us = us;
+    }
+    if (us > stats->total_max_us) {
+        stats->total_max_us = us;
+    }
+    stats->total_sum_us += us;
+
+    bin = LAT_HistogramBin(us);
+    if (stats->histogram[bin] < UINT16_MAX) {
+        stats->histogram[bin]++;
+    }
+    stats->count++;
+}
+
+
+/**
+ * @brief   returns the histogram bin of a latency
+ *
+ * @param   us:     latency in us
+ *
+ * @return  bin, the first with us < (LAT_HISTOGRAM_FIRST_US << bin), or the last bin
+ */
+static uint8_t LAT_HistogramBin(uint32_t us) {
+    uint32_t limit = LAT_HISTOGRAM_FIRST_US;
+    uint8_t bin = 0;
+
+    while ((us >= limit) && (bin < (LAT_HISTOGRAM_BINS - 1))) {
+        limit <<= 1;
+        bin++;
+    }
+    return bin;
+}
@@ -0,0 +1,136 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    latency.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  LAT
+ *
+ * @brief   Measurement of the latency from a limit violation to the opening of the interlock
+ *
+ * Every stage of the path is timestamped with the DWT cycle counter: the database write of
+ * the violating sample (LAT_MarkSample(), resolution 1ms), the DIAG threshold crossing and
+ * the error flag (DIAG_GeneralHandler()), the BMS state change and the interlock request
+ * (BMS state machine) and the interlock switched off (LAT_STAGE_ILCK_OFF). When the
+ * interlock is off, the stage times are added to the statistics of the channel.
+ *
+ * LAT_STAGE_ILCK_OFF is not taken at the pin write itself: ENG_InterlockSwitchingAccounting()
+ * marks it when the 1ms engine task sees ilck_interlock_state.set change to OFF after
+ * ILCK_Trigger(). If the pin was written outside that call, the mark lags the pin by up
+ * to 1ms, so the last stage and the totals have a resolution of 1ms.
+ */
+
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+/*================== Includes =============================================*/
+#include "latency_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * stages of the path from the limit violation to the interlock switched off
+ */
+typedef enum {
+    LAT_STAGE_SAMPLE     = 0,   /*!< violating sample written to the database               */
+    LAT_STAGE_THRESHOLD  = 1,   /*!< DIAG threshold crossed                                 */
+    LAT_STAGE_ERRORFLAG  = 2,   /*!< error flag set by the DIAG callback                    */
+    LAT_STAGE_STATE      = 3,   /*!< BMS state machine takes the transition to ERROR        */
+    LAT_STAGE_REQUEST    = 4,   /*!< interlock open request                                 */
+    LAT_STAGE_ILCK_OFF   = 5,   /*!< interlock set state OFF seen by the 1ms engine task    */
+    LAT_NR_OF_STAGES     = 6,
+} LAT_STAGE_e;
+
+/**
+ * latency statistics of one channel
+ */
+typedef struct {
+    uint32_t count;                             /*!< completed measurements                                 */
+    uint32_t incomplete;                        /*!< measurements dropped after LAT_EPISODE_TIMEOUT_MS      */
+    uint32_t stage_min_us[LAT_NR_OF_STAGES];    /*!< minimum time from the previous stage, [0] unused       */
+    uint32_t stage_max_us[LAT_NR_OF_STAGES];    /*!< maximum time from the previous stage, [0] unused       */
+    uint32_t total_min_us;                      /*!< minimum time from the sample to interlock off          */
+    uint32_t total_max_us;                      /*!< maximum time from the sample to interlock off          */
+    uint64_t total_sum_us;                      /*!< sum of the times from the sample to interlock off      */
+    uint16_t histogram[LAT_HISTOGRAM_BINS];     /*!< times from the sample to interlock off, bin i < (FIRST << i) */
+} LAT_STATISTICS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   enables the cycle counter and clears measurements and statistics
+ */
+extern void LAT_Init(void);
+
+/**
+ * @brief   starts a measurement with the database timestamp of a violating sample
+ *
+ * @details Call before reporting DIAG_EVENT_NOK. A running measurement of the channel is kept,
+ *          so the first violating sample of a debounced violation is the start.
+ *
+ * @param   id:                 DIAG channel
+ * @param   sample_timestamp:   timestamp of the database block in ms
+ */
+extern void LAT_MarkSample(DIAG_CH_ID_e id, uint32_t sample_timestamp);
+
+/**
+ * @brief   timestamps a stage of a channel (LAT_STAGE_THRESHOLD, LAT_STAGE_ERRORFLAG)
+ *
+ * @details A threshold crossing without a running measurement starts one at the crossing.
+ *
+ * @param   id:     DIAG channel
+ * @param   stage:  stage to timestamp
+ */
+extern void LAT_MarkChannel(DIAG_CH_ID_e id, LAT_STAGE_e stage);
+
+/**
+ * @brief   drops the measurement of a channel if its DIAG threshold has not been crossed
+ *
+ * @param   id:     DIAG channel
+ */
+extern void LAT_Abort(DIAG_CH_ID_e id);
+
+/**
+ * @brief   timestamps a common stage (LAT_STAGE_STATE, LAT_STAGE_REQUEST, LAT_STAGE_ILCK_OFF)
+ *          of all channels that have reached the previous stage
+ *
+ * @param   stage:  stage to timestamp
+ */
+extern void LAT_Mark(LAT_STAGE_e stage);
+
+/**
+ * @brief   copies the statistics of a channel
+ *
+ * @param   idx:    index in lat_channels[]
+ * @param   stats:  destination
+ *
+ * @return  E_NOT_OK if idx is out of range
+ */
+extern STD_RETURN_TYPE_e LAT_GetStatistics(uint8_t idx, LAT_STATISTICS_s *stats);
+
+/*================== Function Implementations =============================*/
+
+#endif /* LATENCY_H_ */
@@ -0,0 +1,239 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sm.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  SM
+ *
+ * @brief   Table-driven state machine engine
+ */
+
+/*================== Includes =============================================*/
+#include "sm.h"
+#include "os.h"
+#if SM_STATISTICS_ENABLE == TRUE
+#include "stm32f4xx_hal.h"
+#endif
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+static uint8_t SM_CheckReEntrance(SM_INSTANCE_s *sm);
+static const SM_TRANSITION_s *SM_FindTransition(const SM_INSTANCE_s *sm);
+#if SM_STATISTICS_ENABLE == TRUE
+static SM_STATS_s *SM_GetStateStats(const SM_INSTANCE_s *sm, uint8_t state);
+static void SM_UpdateStatistics(SM_INSTANCE_s *sm, uint8_t state, uint32_t cycles, uint32_t timestamp);
+#endif
+
+/*================== Function Implementations =============================*/
+
+uint8_t SM_Trigger(SM_INSTANCE_s *sm, uint32_t timestamp) {
+    const SM_TRANSITION_s *transition = NULL_PTR;
+    uint8_t state = sm->state;
+#if SM_STATISTICS_ENABLE == TRUE
+    uint32_t cycles = 0;
+#endif
+
+    if (SM_CheckReEntrance(sm)) {
+        return FALSE;
+    }
+
+    if (sm->timer) {
+        if ((timestamp - sm->lastrun) < sm->timer) {
+            sm->triggerentry--;
+            return FALSE;   // handle state machine only if timer has elapsed
+        }
+    }
+
+#if SM_STATISTICS_ENABLE == TRUE
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    cycles = DWT->CYCCNT;
+#endif
+
+    sm->lastrun = timestamp;
+    sm->timer = 0;
+
+    transition = SM_FindTransition(sm);
+    if (transition != NULL_PTR) {
+        sm->laststate = sm->state;
+        sm->lastsubstate = sm->substate;
+        if (transition->action != NULL_PTR) {
+            transition->action();
+        }
+        sm->state = transition->nextstate;
+        if (transition->nextsubstate != SM_SUBSTATE_KEEP) {
+            sm->substate = transition->nextsubstate;
+        }
+        sm->timer = transition->timer;
+    }
+
+#if SM_STATISTICS_ENABLE == TRUE
+    SM_UpdateStatistics(sm, state, DWT->CYCCNT - cycles, timestamp);
+#else
+    (void)state;
+#endif
+
+    sm->triggerentry--;
+    return TRUE;
+}
+
+
+STD_RETURN_TYPE_e SM_GetStatistics(const SM_INSTANCE_s *sm, uint8_t state, SM_STATS_s *stats) {
+    STD_RETURN_TYPE_e retval = E_NOT_OK;
+#if SM_STATISTICS_ENABLE == TRUE
+    SM_STATS_s *statestats = SM_GetStateStats(sm, state);
+
+    if (statestats != NULL_PTR) {
+        OS_TaskEnter_Critical();
+        *stats = *statestats;
+        OS_TaskExit_Critical();
+        retval = E_OK;
+    }
+#endif
+    return retval;
+}
+
+
+uint32_t SM_GetWorstCaseCycles(const SM_INSTANCE_s *sm) {
+    return sm->cycles_max;
+}
+
+/*================== Static functions =====================================*/
+
+/**
+ * @brief   re-entrance check of SM_Trigger()
+ *
+ * @details SM_Trigger() must not run twice at the same time for the same state machine, so
+ *          triggerentry should never be higher than 0 when this function is called.
+ *
+ * @param   sm      state machine
+ *
+ * @return  0 if no further instance of the function is active, 0xff else
+ */
+static uint8_t SM_CheckReEntrance(SM_INSTANCE_s *sm) {
+    uint8_t retval = 0;
+
+    OS_TaskEnter_Critical();
+    if (!sm->triggerentry) {
+        sm->triggerentry++;
+    } else {
+        retval = 0xFF;  // multiple calls of function
+    }
+    OS_TaskExit_Critical();
+
+    return retval;
+}
+
+
+/**
+ * @brief   searches the transition to take
+ *
+ * @param   sm      state machine
+ *
+ * @return  first row of the actual state/substate whose guard is TRUE, NULL_PTR if none
+ */
+static const SM_TRANSITION_s *SM_FindTransition(const SM_INSTANCE_s *sm) {
+    const SM_TRANSITION_s *transition = NULL_PTR;
+    uint16_t i = 0;
+
+    for (i = 0; i < sm->nr_of_transitions; i++) {
+        transition = &sm->table[i];
+        if ((transition->state == sm->state) &&
+                ((transition->substate == SM_SUBSTATE_ANY) || (transition->substate == sm->substate))) {
+            if ((transition->guard == NULL_PTR) || (transition->guard() == TRUE)) {
+                return transition;
+            }
+        }
+    }
+    return NULL_PTR;
+}
+
+
+#if SM_STATISTICS_ENABLE == TRUE
+/**
+ * @brief   returns the statistics entry of a state
+ *
+ * @param   sm      state machine
+ * @param   state   state
+ *
+ * @return  statistics of the state, NULL_PTR if the state has none
+ */
+static SM_STATS_s *SM_GetStateStats(const SM_INSTANCE_s *sm, uint8_t state) {
+    uint8_t i = 0;
+
+    for (i = 0; i < sm->nr_of_states; i++) {
+        if (sm->states[i] == state) {
+            return &sm->stats[i];
+        }
+    }
+    return NULL_PTR;
+}
+
+
+/**
+ * @brief   updates the statistics after an execution
+ *
+ * @param   sm          state machine
+ * @param   state       state that has been executed
+ * @param   cycles      CPU cycles of the execution
+ * @param   timestamp   actual time in ms
+ */
+static void SM_UpdateStatistics(SM_INSTANCE_s *sm, uint8_t state, uint32_t cycles, uint32_t timestamp) {
+    SM_STATS_s *stats = SM_GetStateStats(sm, state);
+    uint32_t dwell = 0;
+
+    if (cycles > sm->cycles_max) {
+        sm->cycles_max = cycles;
+    }
+    if (stats != NULL_PTR) {
+        stats->runs++;
+        stats->cycles_last = cycles;
+        if (cycles > stats->cycles_max) {
+            stats->cycles_max = cycles;
+        }
+    }
+
+    if (sm->state != state) {
+        dwell = timestamp - sm->stateentry;
+        if (stats != NULL_PTR) {
+            stats->dwell_last_ms = dwell;
+            if (dwell > stats->dwell_max_ms) {
+                stats->dwell_max_ms = dwell;
+            }
+        }
+        stats = SM_GetStateStats(sm, sm->state);
+        if (stats != NULL_PTR) {
+            stats->entries++;
+        }
+        sm->stateentry = timestamp;
+    }
+}
+#endif
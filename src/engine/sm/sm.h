@@ -0,0 +1,177 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    sm.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup ENGINE
+ * @prefix  SM
+ *
+ * @brief   Table-driven state machine engine
+ *
+ * A state machine is described by a constant transition table. Every row belongs to a
+ * state/substate pair and holds an optional guard, an optional action, the next
+ * state/substate and the time until the next execution. SM_Trigger() takes care of the
+ * re-entrance protection, of the timer and of saving the last state, so the users only
+ * provide the table and the guard/action functions.
+ */
+
+#ifndef SM_H_
+#define SM_H_
+
+/*================== Includes =============================================*/
+#include "sm_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * substate of a transition row that matches every substate of the state
+ */
+#define SM_SUBSTATE_ANY     (0xFF)
+
+/**
+ * next substate of a transition row that keeps the actual substate
+ */
+#define SM_SUBSTATE_KEEP    (0xFF)
+
+/**
+ * guard of a transition, returns TRUE if the transition is taken.
+ * A guard may consume input (e.g. a state request), it is only called for rows
+ * of the actual state/substate.
+ */
+typedef uint8_t (*SM_GUARD_f)(void);
+
+/**
+ * action of a transition, executed before the state changes
+ */
+typedef void (*SM_ACTION_f)(void);
+
+/**
+ * one row of a transition table
+ */
+typedef struct {
+    uint8_t state;                  /*!< state the row belongs to                                   */
+    uint8_t substate;               /*!< substate the row belongs to, or SM_SUBSTATE_ANY            */
+    SM_GUARD_f guard;               /*!< condition of the transition, NULL_PTR: always taken        */
+    SM_ACTION_f action;             /*!< action of the transition, NULL_PTR: none                   */
+    uint8_t nextstate;              /*!< state after the transition                                 */
+    uint8_t nextsubstate;           /*!< substate after the transition, or SM_SUBSTATE_KEEP        */
+    uint16_t timer;                 /*!< time in ms until the next execution                        */
+} SM_TRANSITION_s;
+
+/**
+ * statistics of one state
+ */
+typedef struct {
+    uint32_t entries;               /*!< number of entries into the state                           */
+    uint32_t runs;                  /*!< number of executions of the state                          */
+    uint32_t dwell_last_ms;         /*!< duration of the last completed stay in the state           */
+    uint32_t dwell_max_ms;          /*!< longest completed stay in the state                        */
+    uint32_t cycles_last;           /*!< CPU cycles of the last execution                           */
+    uint32_t cycles_max;            /*!< worst-case CPU cycles of one execution                     */
+} SM_STATS_s;
+
+/**
+ * a state machine: the constant description and the runtime data
+ */
+typedef struct {
+    const SM_TRANSITION_s *table;   /*!< transition table, rows are evaluated in order              */
+    uint16_t nr_of_transitions;     /*!< number of rows of the table                                */
+    const uint8_t *states;          /*!< states with statistics                                     */
+    SM_STATS_s *stats;              /*!< statistics, one entry per element of states                */
+    uint8_t nr_of_states;           /*!< number of elements of states and stats                     */
+    uint16_t timer;                 /*!< time in ms before the state machine processes the next state */
+    uint8_t state;                  /*!< actual state                                               */
+    uint8_t substate;               /*!< actual substate                                            */
+    uint8_t laststate;              /*!< previous state                                             */
+    uint8_t lastsubstate;           /*!< previous substate                                          */
+    uint8_t triggerentry;           /*!< counter for re-entrance protection (function running flag) */
+    uint32_t lastrun;               /*!< timestamp of the last execution in ms                      */
+    uint32_t stateentry;            /*!< timestamp of the entry into the actual state in ms         */
+    uint32_t cycles_max;            /*!< worst-case CPU cycles of one execution over all states     */
+} SM_INSTANCE_s;
+
+/**
+ * static initializer of a state machine
+ */
+#define SM_INSTANCE_INIT(tab, statelist, statistics, initstate, initsubstate) { \
+    .table              = (tab), \
+    .nr_of_transitions  = sizeof(tab) / sizeof((tab)[0]), \
+    .states             = (statelist), \
+    .stats              = (statistics), \
+    .nr_of_states       = sizeof(statelist) / sizeof((statelist)[0]), \
+    .timer              = 0, \
+    .state              = (initstate), \
+    .substate           = (initsubstate), \
+    .laststate          = (initstate), \
+    .lastsubstate       = (initsubstate), \
+    .triggerentry       = 0, \
+    .lastrun            = 0, \
+    .stateentry         = 0, \
+    .cycles_max         = 0, \
+}
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   executes one step of a state machine
+ *
+ * @details Returns without execution if the function is already running for this state
+ *          machine or if the timer of the last transition has not elapsed. Otherwise the
+ *          first row of the actual state/substate whose guard is TRUE is taken: its action is
+ *          executed, the state/substate and the timer are set. Without a matching row the
+ *          state is kept and the state machine runs again on the next call. The execution
+ *          time is bounded by the number of rows.
+ *
+ * @param   sm          state machine
+ * @param   timestamp   actual time in ms
+ *
+ * @return  TRUE if the state machine has been executed, FALSE otherwise
+ */
+extern uint8_t SM_Trigger(SM_INSTANCE_s *sm, uint32_t timestamp);
+
+/**
+ * @brief   copies the statistics of a state
+ *
+ * @param   sm      state machine
+ * @param   state   state
+ * @param   stats   pointer where the statistics are copied to
+ *
+ * @return  E_OK if the state has statistics, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e SM_GetStatistics(const SM_INSTANCE_s *sm, uint8_t state, SM_STATS_s *stats);
+
+/**
+ * @brief   returns the worst-case CPU cycles of one execution of a state machine
+ *
+ * @param   sm      state machine
+ *
+ * @return  CPU cycles, 0 without SM_STATISTICS_ENABLE
+ */
+extern uint32_t SM_GetWorstCaseCycles(const SM_INSTANCE_s *sm);
+
+/*================== Function Implementations =============================*/
+
+#endif /* SM_H_ */
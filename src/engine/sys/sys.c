@@ -43,26 +43,72 @@
 /*================== Macros and Definitions ===============================*/
 
 /**
- * Saves the last state and the last substate
+ * number of executions of a waiting state before the initialization is considered failed
  */
-#define SYS_SAVELASTSTATES()    sys_state.laststate=sys_state.state; \
-                                sys_state.lastsubstate = sys_state.substate
+#define SYS_INIT_TIMEOUT_COUNT  1000
 
 /*================== Constant and Variable Definitions ====================*/
 
+static uint8_t SYS_GuardInitRequest(void);
+static uint8_t SYS_GuardInterlockInitialized(void);
+static uint8_t SYS_GuardBmsInitialized(void);
+static uint8_t SYS_GuardInitTimeout(void);
+static void SYS_ActionStartMeasurement(void);
+static void SYS_ActionInitInterlock(void);
+static void SYS_ActionCloseInterlock(void);
+static void SYS_ActionInitBms(void);
+static void SYS_ActionRecoveryDone(void);
+static void SYS_ActionCountInit(void);
+
+/**
+ * transition table of the SYS state machine, rows of a state are evaluated in order
+ */
+static const SM_TRANSITION_s sys_transitions[] = {
+    /* state                                substate                            guard                           action                          next state                              next substate                       timer */
+    {SYS_STATEMACH_UNINITIALIZED,           SM_SUBSTATE_ANY,                    SYS_GuardInitRequest,           NULL_PTR,                       SYS_STATEMACH_INITIALIZATION,           SYS_ENTRY,                          SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZATION,          SM_SUBSTATE_ANY,                    NULL_PTR,                       NULL_PTR,                       SYS_STATEMACH_INITIALIZED,              SYS_ENTRY,                          SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZED,             SM_SUBSTATE_ANY,                    NULL_PTR,                       SYS_ActionStartMeasurement,     SYS_STATEMACH_INITIALIZE_INTERLOCK,     SYS_ENTRY,                          SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_INTERLOCK,    SYS_ENTRY,                          NULL_PTR,                       SYS_ActionInitInterlock,        SYS_STATEMACH_INITIALIZE_INTERLOCK,     SYS_WAIT_INITIALIZATION_INTERLOCK,  SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_INTERLOCK,    SYS_WAIT_INITIALIZATION_INTERLOCK,  SYS_GuardInterlockInitialized,  SYS_ActionCloseInterlock,       SYS_STATEMACH_INITIALIZE_MISC,          SYS_ENTRY,                          SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_INTERLOCK,    SYS_WAIT_INITIALIZATION_INTERLOCK,  SYS_GuardInitTimeout,           NULL_PTR,                       SYS_STATEMACH_ERROR,                    SYS_ILCK_INIT_ERROR,                SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_INTERLOCK,    SYS_WAIT_INITIALIZATION_INTERLOCK,  NULL_PTR,                       SYS_ActionCountInit,            SYS_STATEMACH_INITIALIZE_INTERLOCK,     SM_SUBSTATE_KEEP,                   SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_MISC,         SM_SUBSTATE_ANY,                    NULL_PTR,                       NULL_PTR,                       SYS_STATEMACH_INITIALIZE_BMS,           SYS_ENTRY,                          SYS_STATEMACH_MEDIUMTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_BMS,          SYS_ENTRY,                          NULL_PTR,                       SYS_ActionInitBms,              SYS_STATEMACH_INITIALIZE_BMS,           SYS_WAIT_INITIALIZATION_BMS,        SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_BMS,          SYS_WAIT_INITIALIZATION_BMS,        SYS_GuardBmsInitialized,        SYS_ActionRecoveryDone,         SYS_STATEMACH_RUNNING,                  SYS_ENTRY,                          SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_BMS,          SYS_WAIT_INITIALIZATION_BMS,        SYS_GuardInitTimeout,           NULL_PTR,                       SYS_STATEMACH_ERROR,                    SYS_BMS_INIT_ERROR,                 SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_INITIALIZE_BMS,          SYS_WAIT_INITIALIZATION_BMS,        NULL_PTR,                       SYS_ActionCountInit,            SYS_STATEMACH_INITIALIZE_BMS,           SM_SUBSTATE_KEEP,                   SYS_STATEMACH_SHORTTIME_MS},
+    {SYS_STATEMACH_RUNNING,                 SM_SUBSTATE_ANY,                    NULL_PTR,                       NULL_PTR,                       SYS_STATEMACH_RUNNING,                  SM_SUBSTATE_KEEP,                   SYS_STATEMACH_LONGTIME_MS},
+    {SYS_STATEMACH_ERROR,                   SM_SUBSTATE_ANY,                    NULL_PTR,                       NULL_PTR,                       SYS_STATEMACH_ERROR,                    SM_SUBSTATE_KEEP,                   SYS_STATEMACH_LONGTIME_MS},
+};
+
+/**
+ * states of the SYS state machine with statistics
+ */
+static const uint8_t sys_states[] = {
+    SYS_STATEMACH_UNINITIALIZED,
+    SYS_STATEMACH_INITIALIZATION,
+    SYS_STATEMACH_INITIALIZED,
+    SYS_STATEMACH_INITIALIZE_INTERLOCK,
+    SYS_STATEMACH_INITIALIZE_MISC,
+    SYS_STATEMACH_INITIALIZE_BMS,
+    SYS_STATEMACH_RUNNING,
+    SYS_STATEMACH_ERROR,
+};
+
+/**
+ * statistics of the states in sys_states
+ */
+static SM_STATS_s sys_stats[sizeof(sys_states)];
+
 /**
  * contains the state of the contactor state machine
  *
  */
 static SYS_STATE_s sys_state = {
-    .timer                  = 0,
+    .sm                     = SM_INSTANCE_INIT(sys_transitions, sys_states, sys_stats, SYS_STATEMACH_UNINITIALIZED, SYS_ENTRY),
     .statereq               = SYS_STATE_NO_REQUEST,
-    .state                  = SYS_STATEMACH_UNINITIALIZED,
-    .substate               = SYS_ENTRY,
-    .laststate              = SYS_STATEMACH_UNINITIALIZED,
-    .lastsubstate           = 0,
-    .triggerentry           = 0,
     .ErrRequestCounter      = 0,
+    .InitCounter            = 0,
 };
 
 /*================== Function Prototypes ==================================*/
@@ -70,39 +116,9 @@ static SYS_STATE_s sys_state = {
 static SYS_RETURN_TYPE_e SYS_CheckStateRequest(SYS_STATE_REQUEST_e statereq);
 static SYS_STATE_REQUEST_e SYS_GetStateRequest(void);
 static SYS_STATE_REQUEST_e SYS_TransferStateRequest(void);
-static uint8_t SYS_CheckReEntrance(void);
 
 /*================== Function Implementations =============================*/
 
-/**
- * @brief   re-entrance check of SYS state machine trigger function
- *
- * This function is not re-entrant and should only be called time- or event-triggered.
- * It increments the triggerentry counter from the state variable ltc_state.
- * It should never be called by two different processes, so if it is the case, triggerentry
- * should never be higher than 0 when this function is called.
- *
- *
- * @return  retval  0 if no further instance of the function is active, 0xff else
- *
- */
-static uint8_t SYS_CheckReEntrance(void) {
-    uint8_t retval = 0;
-
-    taskENTER_CRITICAL();
-    if (!sys_state.triggerentry) {
-        sys_state.triggerentry++;
-    } else {
-        retval = 0xFF;  // multiple calls of function
-    }
-    taskEXIT_CRITICAL();
-
-    return retval;
-}
-
-
-
-
 /**
  * @brief   gets the current state request.
  *
@@ -122,7 +138,12 @@ static SYS_STATE_REQUEST_e SYS_GetStateRequest(void) {
 
 
 SYS_STATEMACH_e SYS_GetState(void) {
-    return (sys_state.state);
+    return ((SYS_STATEMACH_e)sys_state.sm.state);
+}
+
+
+const SM_INSTANCE_s *SYS_GetStateMachine(void) {
+    return (&sys_state.sm);
 }
 
 
@@ -182,7 +203,7 @@ static SYS_RETURN_TYPE_e SYS_CheckStateRequest(SYS_STATE_REQUEST_e statereq) {
     if (sys_state.statereq == SYS_STATE_NO_REQUEST) {
         // init only allowed from the uninitialized state
         if (statereq == SYS_STATE_INIT_REQUEST) {
-            if (sys_state.state == SYS_STATEMACH_UNINITIALIZED) {
+            if (sys_state.sm.state == SYS_STATEMACH_UNINITIALIZED) {
                 return SYS_OK;
             } else {
                 return SYS_ALREADY_INITIALIZED;
@@ -197,149 +218,109 @@ static SYS_RETURN_TYPE_e SYS_CheckStateRequest(SYS_STATE_REQUEST_e statereq) {
 
 
 void SYS_Trigger(void) {
-    //  STD_RETURN_TYPE_e retVal=E_OK;
-    SYS_STATE_REQUEST_e statereq = SYS_STATE_NO_REQUEST;
-    ILCK_STATEMACH_e ilckstate = ILCK_STATEMACH_UNDEFINED;
-    BMS_STATEMACH_e bmsstate = BMS_STATEMACH_UNDEFINED;
+    DIAG_SysMonNotify(DIAG_SYSMON_SYS_ID, 0);  // task is running, state = ok
 
+    (void)SM_Trigger(&sys_state.sm, MCU_GetTimeStamp());
+}
 
-    DIAG_SysMonNotify(DIAG_SYSMON_SYS_ID, 0);  // task is running, state = ok
-    // Check re-entrance of function
-    if (SYS_CheckReEntrance()) {
-        return;
-    }
+/*================== Static functions =====================================*/
 
-    if (sys_state.timer) {
-        if (--sys_state.timer) {
-            sys_state.triggerentry--;
-            return;  // handle state machine only if timer has elapsed
-        }
+/**
+ * @brief   guard: initialization requested
+ *
+ * @details Takes the pending state request, illegal requests are counted.
+ *
+ * @return  TRUE if the initialization has been requested
+ */
+static uint8_t SYS_GuardInitRequest(void) {
+    SYS_STATE_REQUEST_e statereq = SYS_TransferStateRequest();
+
+    if (statereq == SYS_STATE_INIT_REQUEST) {
+        return TRUE;
+    } else if (statereq != SYS_STATE_NO_REQUEST) {
+        sys_state.ErrRequestCounter++;   // illegal request pending
     }
+    return FALSE;
+}
 
-    /****Happens every time the state machine is triggered**************/
-
-
-    switch (sys_state.state) {
-        /****************************UNINITIALIZED***********************************/
-        case SYS_STATEMACH_UNINITIALIZED:
-            // waiting for Initialization Request
-            statereq = SYS_TransferStateRequest();
-            if (statereq == SYS_STATE_INIT_REQUEST) {
-                SYS_SAVELASTSTATES();
-                sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                sys_state.state = SYS_STATEMACH_INITIALIZATION;
-                sys_state.substate = SYS_ENTRY;
-            } else if (statereq == SYS_STATE_NO_REQUEST) {
-                // no actual request pending //
-            } else {
-                sys_state.ErrRequestCounter++;   // illegal request pending
-            }
-            break;
-        /****************************INITIALIZATION**********************************/
-        case SYS_STATEMACH_INITIALIZATION:
-
-            SYS_SAVELASTSTATES();
-            //Initializations done here
-            sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-            sys_state.state = SYS_STATEMACH_INITIALIZED;
-            sys_state.substate = SYS_ENTRY;
-            break;
-
-        /****************************INITIALIZED*************************************/
-        case SYS_STATEMACH_INITIALIZED:
-            SYS_SAVELASTSTATES();
-            MEAS_StartMeasurement();
-            sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-            sys_state.state = SYS_STATEMACH_INITIALIZE_INTERLOCK;
-            sys_state.substate = SYS_ENTRY;
-            break;
-
-        /****************************INITIALIZE INTERLOCK*************************************/
-        case SYS_STATEMACH_INITIALIZE_INTERLOCK:
-            SYS_SAVELASTSTATES();
-
-            if (sys_state.substate == SYS_ENTRY) {
-                ILCK_SetStateRequest(ILCK_STATE_INIT_REQUEST);
-                sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                sys_state.substate = SYS_WAIT_INITIALIZATION_INTERLOCK;
-                sys_state.InitCounter = 0;
-                break;
-            } else if (sys_state.substate == SYS_WAIT_INITIALIZATION_INTERLOCK) {
-                ilckstate = ILCK_GetState();
-                if (ilckstate == ILCK_STATEMACH_WAIT_FIRST_REQUEST) {
-                    ILCK_SetStateRequest(ILCK_STATE_CLOSE_REQUEST);
-                    sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                    sys_state.state = SYS_STATEMACH_INITIALIZE_MISC;
-                    sys_state.substate = SYS_ENTRY;
-                    break;
-                } else {
-                    if (sys_state.InitCounter > 1000) {
-                        sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                        sys_state.state = SYS_STATEMACH_ERROR;
-                        sys_state.substate = SYS_ILCK_INIT_ERROR;
-                        break;
-                    }
-                    sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                    sys_state.InitCounter++;
-                    break;
-                }
-            }
 
-            break;
-
-
-                /****************************INITIALIZED_MISC*************************************/
-                case SYS_STATEMACH_INITIALIZE_MISC:
-                    SYS_SAVELASTSTATES();
-
-
-                    sys_state.timer = SYS_STATEMACH_MEDIUMTIME_MS;
-                    sys_state.state = SYS_STATEMACH_INITIALIZE_BMS;
-                    sys_state.substate = SYS_ENTRY;
-                    break;
-
-            /****************************INITIALIZE BMS*************************************/
-            case SYS_STATEMACH_INITIALIZE_BMS:
-                SYS_SAVELASTSTATES();
-
-                if (sys_state.substate == SYS_ENTRY){
-                    BMS_SetStateRequest(BMS_STATE_INIT_REQUEST);
-                    sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                    sys_state.substate = SYS_WAIT_INITIALIZATION_BMS;
-                    sys_state.InitCounter = 0;
-                    break;
-                } else if (sys_state.substate == SYS_WAIT_INITIALIZATION_BMS) {
-                    bmsstate = BMS_GetState();
-                    if (bmsstate == BMS_STATEMACH_IDLE || bmsstate == BMS_STATEMACH_STANDBY) {
-                        sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                        sys_state.state = SYS_STATEMACH_RUNNING;
-                        sys_state.substate = SYS_ENTRY;
-                        break;
-                    } else {
-                        if (sys_state.InitCounter > 1000) {
-                            sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                            sys_state.state = SYS_STATEMACH_ERROR;
-                            sys_state.substate = SYS_BMS_INIT_ERROR;
-                            break;
-                        }
-                        sys_state.timer = SYS_STATEMACH_SHORTTIME_MS;
-                        sys_state.InitCounter++;
-                        break;
-                    }
-                }
-                break;
-
-        /****************************RUNNNIG*************************************/
-        case SYS_STATEMACH_RUNNING:
-            SYS_SAVELASTSTATES();
-            sys_state.timer = SYS_STATEMACH_LONGTIME_MS;
-            break;
-
-        /****************************ERROR*************************************/
-        case SYS_STATEMACH_ERROR:
-            SYS_SAVELASTSTATES();
-            sys_state.timer = SYS_STATEMACH_LONGTIME_MS;
-            break;
-    }  // end switch(sys_state.state)
-    sys_state.triggerentry--;
+/**
+ * @brief   guard: interlock state machine initialized
+ *
+ * @return  TRUE if the interlock waits for its first request
+ */
+static uint8_t SYS_GuardInterlockInitialized(void) {
+    return (ILCK_GetState() == ILCK_STATEMACH_WAIT_FIRST_REQUEST) ? TRUE : FALSE;
+}
+
+
+/**
+ * @brief   guard: BMS state machine initialized
+ *
+ * @return  TRUE if the BMS is in idle or standby
+ */
+static uint8_t SYS_GuardBmsInitialized(void) {
+    BMS_STATEMACH_e bmsstate = BMS_GetState();
+
+    return ((bmsstate == BMS_STATEMACH_IDLE) || (bmsstate == BMS_STATEMACH_STANDBY)) ? TRUE : FALSE;
+}
+
+
+/**
+ * @brief   guard: initialization of a sub state machine timed out
+ *
+ * @return  TRUE if the waiting state has been executed more than SYS_INIT_TIMEOUT_COUNT times
+ */
+static uint8_t SYS_GuardInitTimeout(void) {
+    return (sys_state.InitCounter > SYS_INIT_TIMEOUT_COUNT) ? TRUE : FALSE;
+}
+
+
+/**
+ * @brief   action: starts the measurement
+ */
+static void SYS_ActionStartMeasurement(void) {
+    MEAS_StartMeasurement();
+}
+
+
+/**
+ * @brief   action: requests the initialization of the interlock
+ */
+static void SYS_ActionInitInterlock(void) {
+    ILCK_SetStateRequest(ILCK_STATE_INIT_REQUEST);
+    sys_state.InitCounter = 0;
+}
+
+
+/**
+ * @brief   action: closes the interlock after its initialization
+ */
+static void SYS_ActionCloseInterlock(void) {
+    ILCK_SetStateRequest(ILCK_STATE_CLOSE_REQUEST);
+}
+
+
+/**
+ * @brief   action: requests the initialization of the BMS
+ */
+static void SYS_ActionInitBms(void) {
+    BMS_SetStateRequest(BMS_STATE_INIT_REQUEST);
+    sys_state.InitCounter = 0;
+}
+
+
+/**
+ * @brief   action: system running
+ */
+static void SYS_ActionRecoveryDone(void) {
+    DIAG_CrashRecoveryDone();   // measure time-to-safe-operation after a fault reset
+}
+
+
+/**
+ * @brief   action: counts the executions of a waiting state
+ */
+static void SYS_ActionCountInit(void) {
+    sys_state.InitCounter++;
 }
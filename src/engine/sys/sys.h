@@ -37,6 +37,7 @@
 
 /*================== Includes =============================================*/
 #include "sys_cfg.h"
+#include "sm.h"
 
 
 /*================== Macros and Definitions ===============================*/
@@ -154,19 +155,14 @@ typedef enum {
 
 
 /**
- * This structure contains all the variables relevant for the CONT state machine.
- * The user can get the current state of the CONT state machine with this variable
+ * This structure contains all the variables relevant for the SYS state machine.
+ * State, substate, timer and re-entrance protection are handled by the state machine engine.
  */
 typedef struct {
-    uint16_t timer;                         /*!< time in ms before the state machine processes the next state, e.g. in counts of 1ms    */
+    SM_INSTANCE_s sm;                       /*!< state machine, see sys_transitions                                                     */
     SYS_STATE_REQUEST_e statereq;           /*!< current state request made to the state machine                                        */
-    SYS_STATEMACH_e state;                  /*!< state of Driver State Machine                                                          */
-    uint8_t substate;                       /*!< current substate of the state machine                                                  */
-    SYS_STATEMACH_e laststate;              /*!< previous state of the state machine                                                    */
-    uint8_t lastsubstate;                   /*!< previous substate of the state machine                                                 */
     uint32_t ErrRequestCounter;             /*!< counts the number of illegal requests to the SYS state machine */
     uint16_t InitCounter;                   /*!< Timeout to wait for initialization of state machine state machine */
-    uint8_t triggerentry;                   /*!< counter for re-entrance protection (function running flag) */
 } SYS_STATE_s;
 
 
@@ -204,5 +200,12 @@ extern SYS_STATEMACH_e SYS_GetState(void);
  */
 extern void SYS_Trigger(void);
 
+/**
+ * @brief   returns the SYS state machine, e.g. for SM_GetStatistics()
+ *
+ * @return  pointer to the state machine
+ */
+extern const SM_INSTANCE_s *SYS_GetStateMachine(void);
+
 
 #endif /* SYS_H_ */
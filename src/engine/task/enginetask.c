@@ -36,20 +36,43 @@
 #include "enginetask.h"
 #include "database.h"
 #include "os.h"
+#include "evt.h"
+#include "diag.h"
 #include "bkpsram.h"
+#include "stm32f4xx_hal.h"
 
 
 /*================== Macros and Definitions ===============================*/
 
 
 /*================== Constant and Variable Definitions ====================*/
-static BMS_Task_Definition_s eng_tskdef_engine  = { 0,      1,  OS_PRIORITY_REALTIME,          1024/4};
+static BMS_Task_Definition_s eng_tskdef_engine  = { 0,      DIAG_SYSMON_PERIOD_MS,  OS_PRIORITY_REALTIME,          ENG_TSK_ENGINE_STACKSIZE};
+
+/**
+ * Statically allocated stacks of the engine tasks
+ */
+static StackType_t MEM_OS_STATIC eng_stack_engine[ENG_TSK_ENGINE_STACKSIZE];
+#if OS_TIME_TRIGGERED_EXECUTIVE == TRUE
+static StackType_t MEM_OS_STATIC eng_stack_executive[ENG_TSK_EXECUTIVE_STACKSIZE];
+#else
+static StackType_t MEM_OS_STATIC eng_stack_cyclic_1ms[ENG_TSK_CYCLIC_1MS_STACKSIZE];
+static StackType_t MEM_OS_STATIC eng_stack_cyclic_10ms[ENG_TSK_CYCLIC_10MS_STACKSIZE];
+static StackType_t MEM_OS_STATIC eng_stack_cyclic_100ms[ENG_TSK_CYCLIC_100MS_STACKSIZE];
+static StackType_t MEM_OS_STATIC eng_stack_eventhandler[ENG_TSK_EVENTHANDLER_STACKSIZE];
+static StackType_t MEM_OS_STATIC eng_stack_diagnosis[ENG_TSK_DIAGNOSIS_STACKSIZE];
+#endif
 
 /**
  * Definition of task handle of the engine task
  */
 static xTaskHandle eng_handle_engine;
 
+#if OS_TIME_TRIGGERED_EXECUTIVE == TRUE
+/**
+ * Definition of task handle of the time-triggered executive
+ */
+static xTaskHandle eng_handle_tsk_executive;
+#else
 /**
  * Definition of task handle 1 millisecond task
  */
@@ -74,6 +97,17 @@ static xTaskHandle eng_handle_tsk_diagnosis;
  * Definition of task handle EventHandler
  */
 static xTaskHandle eng_handle_tsk_eventhandler;
+#endif
+
+/**
+ * execution times of the time-triggered executive
+ */
+static ENG_EXECUTIVE_TIMING_s eng_executive_timing;
+
+/**
+ * timing of the engine task
+ */
+static ENG_ENGINE_TIMING_s eng_engine_timing;
 
 QueueHandle_t data_queueID;
 
@@ -84,40 +118,42 @@ QueueHandle_t data_queueID;
 
 void ENG_CreateTask(void) {
     // Database Task
-    osThreadDef(TSK_Engine, (os_pthread) ENG_TSK_Engine,
-            eng_tskdef_engine.Priority, 0, eng_tskdef_engine.Stacksize);
-    eng_handle_engine = osThreadCreate(osThread(TSK_Engine), NULL);
-
+    eng_handle_engine = OS_CreateTask("TSK_Engine", (os_pthread) ENG_TSK_Engine,
+            &eng_tskdef_engine, eng_stack_engine);
+
+#if OS_TIME_TRIGGERED_EXECUTIVE == TRUE
+    // Time-triggered executive, runs all cyclic functions
+    eng_handle_tsk_executive = OS_CreateTask("TSK_Executive", (os_pthread) ENG_TSK_Executive,
+            &eng_tskdef_executive, eng_stack_executive);
+#else
     // Cyclic Task 1ms
-    osThreadDef(TSK_Cyclic_1ms, (os_pthread) ENG_TSK_Cyclic_1ms,
-            eng_tskdef_cyclic_1ms.Priority, 0, eng_tskdef_cyclic_1ms.Stacksize);
-    eng_handle_tsk_1ms = osThreadCreate(osThread(TSK_Cyclic_1ms), NULL);
+    eng_handle_tsk_1ms = OS_CreateTask("TSK_Cyclic_1ms", (os_pthread) ENG_TSK_Cyclic_1ms,
+            &eng_tskdef_cyclic_1ms, eng_stack_cyclic_1ms);
 
     // Cyclic Task 10ms
-    osThreadDef(TSK_Cyclic_10ms, (os_pthread) ENG_TSK_Cyclic_10ms,
-            eng_tskdef_cyclic_10ms.Priority, 0, eng_tskdef_cyclic_10ms.Stacksize);
-    eng_handle_tsk_10ms = osThreadCreate(osThread(TSK_Cyclic_10ms), NULL);
+    eng_handle_tsk_10ms = OS_CreateTask("TSK_Cyclic_10ms", (os_pthread) ENG_TSK_Cyclic_10ms,
+            &eng_tskdef_cyclic_10ms, eng_stack_cyclic_10ms);
 
     // Cyclic Task 100ms
-    osThreadDef(TSK_Cyclic_100ms, (os_pthread) ENG_TSK_Cyclic_100ms,
-            eng_tskdef_cyclic_100ms.Priority, 0, eng_tskdef_cyclic_100ms.Stacksize);
-    eng_handle_tsk_100ms = osThreadCreate(osThread(TSK_Cyclic_100ms), NULL);
+    eng_handle_tsk_100ms = OS_CreateTask("TSK_Cyclic_100ms", (os_pthread) ENG_TSK_Cyclic_100ms,
+            &eng_tskdef_cyclic_100ms, eng_stack_cyclic_100ms);
 
     // EventHandler Task
-    osThreadDef(TSK_EventHandler, (os_pthread) ENG_TSK_EventHandler,
-            eng_tskdef_eventhandler.Priority, 0, eng_tskdef_eventhandler.Stacksize);
-    eng_handle_tsk_eventhandler = osThreadCreate(osThread(TSK_EventHandler), NULL);
+    eng_handle_tsk_eventhandler = OS_CreateTask("TSK_EventHandler", (os_pthread) ENG_TSK_EventHandler,
+            &eng_tskdef_eventhandler, eng_stack_eventhandler);
 
     // Diagnosis Task
-    osThreadDef(TSK_Diagnosis, (os_pthread) ENG_TSK_Diagnosis,
-            eng_tskdef_diagnosis.Priority, 0, eng_tskdef_diagnosis.Stacksize);
-    eng_handle_tsk_diagnosis = osThreadCreate(osThread(TSK_Diagnosis), NULL);
+    eng_handle_tsk_diagnosis = OS_CreateTask("TSK_Diagnosis", (os_pthread) ENG_TSK_Diagnosis,
+            &eng_tskdef_diagnosis, eng_stack_diagnosis);
+#endif
 }
 
 void ENG_CreateMutex(void) {
 }
 
 void ENG_CreateEvent(void) {
+    // Event bus, without the wake-up semaphores the consumers poll every 1ms
+    (void)EVT_Init();
 }
 
 void ENG_CreateQueues(void) {
@@ -132,21 +168,55 @@ void ENG_CreateQueues(void) {
 }
 
 void ENG_TSK_Engine(void) {
+    DATA_QUEUE_MESSAGE_s request;
+    uint32_t sysmon_next = 0;
+    uint32_t now = 0;
+    uint32_t wait = 0;
+    uint32_t late = 0;
+
     OS_PostOSInit();
 
-    os_boot = OS_SYSTEM_RUNNING;
+    OS_ReleaseStartBarrier();
+
+    sysmon_next = osKernelSysTick() + eng_tskdef_engine.CycleTime;
 
     for (;;) {
-        DATA_Task();    /* Call database manager */
-        DIAG_SysMon();  /* Call Overall System Monitoring */
+        /* sleep until a database request arrives or the system monitoring is due */
+        now = osKernelSysTick();
+        wait = ((int32_t)(sysmon_next - now) > 0) ? (sysmon_next - now) : 0;
+        if (xQueuePeek(data_queueID, &request, (TickType_t)wait) == pdTRUE) {
+            DATA_Task();    /* Call database manager, the request is already queued */
+            eng_engine_timing.requests++;
+        }
+        eng_engine_timing.wakeups++;
+        /* the database is served by this loop, which wakes up at least every DIAG_SYSMON_PERIOD_MS,
+           also without requests */
+        DIAG_SysMonNotify(DIAG_SYSMON_DATABASE_ID, 0);
+
+        if ((int32_t)(osKernelSysTick() - sysmon_next) >= 0) {
+            late = OS_GetReleaseLatency(sysmon_next);
+            DIAG_SysMon();  /* Call Overall System Monitoring */
+            eng_engine_timing.sysmon_runs++;
+            if (late > eng_engine_timing.sysmon_late_max_us) {
+                eng_engine_timing.sysmon_late_max_us = late;
+            }
+
+            /* fixed period; after a delay of more than one period the missed checks
+               are skipped, repeated checks would count the monitored tasks as stopped */
+            sysmon_next += eng_tskdef_engine.CycleTime;
+            now = osKernelSysTick();
+            if ((int32_t)(now - sysmon_next) >= 0) {
+                eng_engine_timing.sysmon_overruns += (now - sysmon_next) / eng_tskdef_engine.CycleTime + 1;
+                sysmon_next = now + eng_tskdef_engine.CycleTime;
+            }
+        }
+        OS_MarkActivation();
     }
 }
 
 
 void ENG_TSK_Cyclic_1ms(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_ENG_CYCLIC_1MS);
 
     if (eng_init == FALSE) {
         ENG_Init();
@@ -154,69 +224,157 @@ void ENG_TSK_Cyclic_1ms(void) {
     }
 
     osDelayUntil(&os_schedulerstarttime, eng_tskdef_cyclic_1ms.Phase);
+    OS_MarkFirstCycle(OS_START_ENG_CYCLIC_1MS);
 
     while (1) {
         uint32_t currentTime = osKernelSysTick();
         OS_TimerTrigger();  // Increment system timer os_timer
         ENG_Cyclic_1ms();
+        OS_MarkActivation();
         osDelayUntil(&currentTime, eng_tskdef_cyclic_1ms.CycleTime);
+        /* delay from the due tick (currentTime, updated by osDelayUntil()) to the release */
+        eng_engine_timing.release_1ms_last_us = OS_GetReleaseLatency(currentTime);
+        if (eng_engine_timing.release_1ms_last_us > eng_engine_timing.release_1ms_max_us) {
+            eng_engine_timing.release_1ms_max_us = eng_engine_timing.release_1ms_last_us;
+        }
     }
 }
 
 
 void ENG_TSK_Cyclic_10ms(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_ENG_CYCLIC_10MS);
 
     osDelayUntil(&os_schedulerstarttime, eng_tskdef_cyclic_10ms.Phase);
+    OS_MarkFirstCycle(OS_START_ENG_CYCLIC_10MS);
 
     while (1) {
         uint32_t currentTime = osKernelSysTick();
         ENG_Cyclic_10ms();
+        OS_MarkActivation();
         osDelayUntil(&currentTime, eng_tskdef_cyclic_10ms.CycleTime);
     }
 }
 
 void ENG_TSK_Cyclic_100ms(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_ENG_CYCLIC_100MS);
 
     osDelayUntil(&os_schedulerstarttime, eng_tskdef_cyclic_100ms.Phase);
+    OS_MarkFirstCycle(OS_START_ENG_CYCLIC_100MS);
 
     while (1) {
         uint32_t currentTime = osKernelSysTick();
         ENG_Cyclic_100ms();
+        OS_MarkActivation();
         osDelayUntil(&currentTime, eng_tskdef_cyclic_100ms.CycleTime);
     }
 }
 
 
 void ENG_TSK_EventHandler(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_ENG_EVENTHANDLER);
 
     osDelayUntil(&os_schedulerstarttime, eng_tskdef_eventhandler.Phase);
+    OS_MarkFirstCycle(OS_START_ENG_EVENTHANDLER);
 
     while (1) {
-        uint32_t currentTime = osKernelSysTick();
+        EVT_Wait(EVT_CONSUMER_EVENTHANDLER);
         ENG_EventHandler();
-        osDelayUntil(&currentTime, eng_tskdef_eventhandler.CycleTime);
+        OS_MarkActivation();
     }
 }
 
 void ENG_TSK_Diagnosis(void) {
-    while (os_boot != OS_SYSTEM_RUNNING) {
-        ;
-    }
+    OS_WaitStartBarrier(OS_START_ENG_DIAGNOSIS);
 
     osDelayUntil(&os_schedulerstarttime, eng_tskdef_diagnosis.Phase);
+    OS_MarkFirstCycle(OS_START_ENG_DIAGNOSIS);
 
     while (1) {
-        uint32_t currentTime = osKernelSysTick();
+        EVT_Wait(EVT_CONSUMER_DIAGNOSIS);
         ENG_Diagnosis();
-        osDelayUntil(&currentTime, eng_tskdef_diagnosis.CycleTime);
+        OS_MarkActivation();
     }
 }
+
+
+void ENG_TSK_Executive(void) {
+    uint32_t next[ENG_EXECUTIVE_NR_OF_SLOTS];
+    const BMS_Task_Definition_s *taskdef;
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    uint32_t wakeTime = 0;
+    uint32_t tick = 0;
+    uint32_t tickstart = 0;
+    uint32_t slotstart = 0;
+    uint32_t duration = 0;
+    uint8_t i = 0;
+
+    OS_WaitStartBarrier(OS_START_ENG_CYCLIC_1MS);
+
+    if (eng_init == FALSE) {
+        ENG_Init();
+        eng_init = TRUE;
+    }
+
+    /* the time line starts now, the ticks count from the start of the scheduler */
+    wakeTime = osKernelSysTick();
+    tick = wakeTime - os_schedulerstarttime;
+    OS_MarkFirstCycle(OS_START_ENG_CYCLIC_1MS);
+
+    /* first due tick of every runnable */
+    for (i = 0; i < ENG_EXECUTIVE_NR_OF_SLOTS; i++) {
+        taskdef = eng_executive_table[i].taskdef;
+        next[i] = taskdef->Phase;
+        if (tick > taskdef->Phase) {
+            next[i] += ((tick - taskdef->Phase + taskdef->CycleTime - 1) / taskdef->CycleTime) * taskdef->CycleTime;
+        }
+    }
+
+    while (1) {
+        tickstart = DWT->CYCCNT;
+        OS_TimerTrigger();  // Increment system timer os_timer
+
+        for (i = 0; i < ENG_EXECUTIVE_NR_OF_SLOTS; i++) {
+            if (tick == next[i]) {
+                next[i] += eng_executive_table[i].taskdef->CycleTime;
+
+                slotstart = DWT->CYCCNT;
+                eng_executive_table[i].runnable();
+                duration = (DWT->CYCCNT - slotstart) / cycles_per_us;
+
+                eng_executive_timing.slot[i].count++;
+                eng_executive_timing.slot[i].last_us = duration;
+                if (duration > eng_executive_timing.slot[i].max_us) {
+                    eng_executive_timing.slot[i].max_us = duration;
+                }
+            }
+        }
+
+        duration = (DWT->CYCCNT - tickstart) / cycles_per_us;
+        if (duration > eng_executive_timing.tick_max_us) {
+            eng_executive_timing.tick_max_us = duration;
+        }
+        eng_executive_timing.ticks++;
+        tick++;
+
+        OS_MarkActivation();
+        osDelayUntil(&wakeTime, eng_tskdef_executive.CycleTime);
+        if (osKernelSysTick() != wakeTime) {
+            /* next tick was already due, osDelayUntil() did not block */
+            eng_executive_timing.overruns++;
+        }
+    }
+}
+
+
+void ENG_GetExecutiveTiming(ENG_EXECUTIVE_TIMING_s *timing) {
+    OS_TaskEnter_Critical();
+    *timing = eng_executive_timing;
+    OS_TaskExit_Critical();
+}
+
+
+void ENG_GetEngineTiming(ENG_ENGINE_TIMING_s *timing) {
+    OS_TaskEnter_Critical();
+    *timing = eng_engine_timing;
+    OS_TaskExit_Critical();
+}
@@ -39,6 +39,39 @@
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * execution time of a runnable of the time-triggered executive
+ */
+typedef struct {
+    uint32_t count;         /*!< number of executions           */
+    uint32_t last_us;       /*!< last execution time in us      */
+    uint32_t max_us;        /*!< longest execution time in us   */
+} ENG_EXECUTIVE_SLOT_TIMING_s;
+
+/**
+ * timing of the time-triggered executive
+ */
+typedef struct {
+    uint32_t ticks;             /*!< executed ticks                                             */
+    uint32_t overruns;          /*!< ticks that ended after the start of the next tick          */
+    uint32_t tick_max_us;       /*!< longest execution time of all runnables of a tick in us    */
+    ENG_EXECUTIVE_SLOT_TIMING_s slot[ENG_EXECUTIVE_NR_OF_SLOTS];    /*!< per runnable, index of eng_executive_table[] */
+} ENG_EXECUTIVE_TIMING_s;
+
+/**
+ * timing of the engine task and release latency of the 1ms task
+ */
+typedef struct {
+    uint32_t wakeups;               /*!< activations of the engine task                                 */
+    uint32_t requests;              /*!< activations with a database request                            */
+    uint32_t sysmon_runs;           /*!< executions of DIAG_SysMon()                                    */
+    uint32_t sysmon_overruns;       /*!< periods of DIAG_SysMon() skipped because the task was late     */
+    uint32_t sysmon_late_max_us;    /*!< longest delay of DIAG_SysMon() after its due tick in us        */
+    uint32_t release_1ms_last_us;   /*!< last delay of TSK_Cyclic_1ms after its due tick in us,
+                                         0 with the time-triggered executive                            */
+    uint32_t release_1ms_max_us;    /*!< longest delay of TSK_Cyclic_1ms after its due tick in us       */
+} ENG_ENGINE_TIMING_s;
+
 /*================== Constant and Variable Definitions ====================*/
 extern QueueHandle_t data_queueID;
 
@@ -113,24 +146,60 @@ extern void ENG_TSK_Cyclic_100ms(void);
 
 
 /**
- * @brief   cyclic and event driven handler.
+ * @brief   event driven handler.
  *
- * @details Task configurations (cycle and delay time) are specified by
- *          eng_tskdef_eventhandler.
+ * @details After the phase of eng_tskdef_eventhandler, the task blocks until
+ *          an event for EVT_CONSUMER_EVENTHANDLER is posted (EVT_Post()) and
+ *          dispatches the queued events. The cycle time is not used.
  *
  */
 extern void ENG_TSK_EventHandler(void);
 
 
 /**
- * @brief   cyclic diagnosis task.
+ * @brief   event driven diagnosis task.
  *
- * @details Task configurations (cycle and delay time) are specified by
- *          eng_tskdef_diagnosis.
+ * @details After the phase of eng_tskdef_diagnosis, the task blocks until
+ *          an event for EVT_CONSUMER_DIAGNOSIS is posted (EVT_Post()) and
+ *          dispatches the queued events. The cycle time is not used.
  *
  */
 extern void ENG_TSK_Diagnosis(void);
 
+/**
+ * @brief   time-triggered executive, replaces the cyclic engine and application
+ *          tasks if OS_TIME_TRIGGERED_EXECUTIVE is TRUE
+ *
+ * @details Wakes every 1ms and executes the runnables of eng_executive_table[]
+ *          that are due in this tick, in the order of the table. A tick that
+ *          is not finished at the start of the next one is counted as overrun,
+ *          the next tick then starts without delay.
+ *
+ */
+extern void ENG_TSK_Executive(void);
+
+/**
+ * @brief   copies the execution times of the time-triggered executive
+ *
+ * @param   timing:     destination
+ *
+ * @return  void
+ */
+extern void ENG_GetExecutiveTiming(ENG_EXECUTIVE_TIMING_s *timing);
+
+/**
+ * @brief   copies the timing of the engine task
+ *
+ * @details The CPU time of the engine task is part of the CPU load report
+ *          (OS_GetLoad(), "TSK_Engine"), wakeups compared to the elapsed time in
+ *          ms shows the polling that is left.
+ *
+ * @param   timing:     destination
+ *
+ * @return  void
+ */
+extern void ENG_GetEngineTiming(ENG_ENGINE_TIMING_s *timing);
+
 /*================== Function Implementations =============================*/
 
 #endif /* ENGINETASK_H_ */
@@ -83,13 +83,16 @@
 #if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
     #include <stdint.h>
     extern uint32_t SystemCoreClock;
+    extern void OS_ConfigureRunTimeCounter(void);
+    extern void OS_TraceSwitchedIn(uint32_t tasknumber);
+    extern void OS_TraceSwitchedOut(void);
 #endif
 
 #include "diag.h"
 
 #define configUSE_PREEMPTION                1
 #define configUSE_IDLE_HOOK                 1
-#define configUSE_TICK_HOOK                 0
+#define configUSE_TICK_HOOK                 1
 #define configCPU_CLOCK_HZ                  ( SystemCoreClock )
 #define configTICK_RATE_HZ                  ( ( TickType_t ) 1000 )
 
@@ -103,19 +106,39 @@
 #define configMAX_PRIORITIES                (7 + 3)
 
 #define configMINIMAL_STACK_SIZE            ( ( uint16_t ) 128 )
-#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 15 * 1024 ) )
+/* The task stacks are allocated statically (OS_CreateTask()). The heap only holds
+the kernel objects created at start up, about 3.3KB with FreeRTOS V8.1.2 and heap_4:
+    11 TCBs (9 tasks, idle, timer)  11 * (92 + 8 header) bytes, aligned to 8   1144
+    idle task stack                 configMINIMAL_STACK_SIZE * 4 + 8             520
+    timer task stack                configTIMER_TASK_STACK_DEPTH * 4 + 8        1032
+    timer queue                     queue + 10 * 12 + 1 bytes storage            224
+    data queue, start barrier       queue + storage, event group                 160
+    event bus wake-up semaphores    2 * (queue + 1 byte storage)                 208
+The rest is the margin for objects of the drivers, see OS_GetHeapFree(). */
+#define configTOTAL_HEAP_SIZE               ( ( size_t ) ( 4 * 1024 ) )
 #define configMAX_TASK_NAME_LEN             ( 20 )
 #define configUSE_TRACE_FACILITY            1
 #define configUSE_16_BIT_TICKS              0
 #define configIDLE_SHOULD_YIELD             1
 #define configUSE_MUTEXES                   1
 #define configQUEUE_REGISTRY_SIZE           8
-#define configCHECK_FOR_STACK_OVERFLOW      0
+#define configCHECK_FOR_STACK_OVERFLOW      2
 #define configUSE_RECURSIVE_MUTEXES         1
-#define configUSE_MALLOC_FAILED_HOOK        0
+#define configUSE_MALLOC_FAILED_HOOK        1
 #define configUSE_APPLICATION_TASK_TAG      0
 #define configUSE_COUNTING_SEMAPHORES       1
-#define configGENERATE_RUN_TIME_STATS       0
+#define configGENERATE_RUN_TIME_STATS       1
+
+/* Run-time stats: the DWT cycle counter (DWT->CYCCNT) counts CPU cycles. The
+per task cycles of the trace hooks below wrap after 2^32 cycles, so
+OS_UpdateLoad() works on differences. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    OS_ConfigureRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()            ( *( ( volatile uint32_t * ) 0xE0001004UL ) )
+
+/* Trace hooks for the per task activation and time slice measurement of the
+CPU load report, expanded inside tasks.c where pxCurrentTCB is visible. */
+#define traceTASK_SWITCHED_IN()             OS_TraceSwitchedIn( pxCurrentTCB->uxTCBNumber )
+#define traceTASK_SWITCHED_OUT()            OS_TraceSwitchedOut()
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES               0
@@ -137,6 +160,10 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelayUntil             1
 #define INCLUDE_vTaskDelay                  1
 #define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle  1
+#define INCLUDE_pcTaskGetTaskName           1
+#define INCLUDE_uxTaskGetStackHighWaterMark 1
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
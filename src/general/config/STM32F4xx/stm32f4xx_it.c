@@ -63,16 +63,42 @@
 #include "spi.h"
 
 #include "diag.h"
+#include "com.h"
 #include "timer.h"
 #include "mcu.h"
 #include "io.h"
 #include "adc.h"
+#include "fasttrip.h"
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+  * @brief  Enters the C fault handler with the exception frame of the faulting context.
+  *
+  * Selects MSP or PSP depending on EXC_RETURN (bit 2) and passes the frame pointer and
+  * EXC_RETURN to FAULT_HandlerC(). Must not use the stack itself (naked function).
+  */
+#define FAULT_ENTER_HANDLER_C()     __ASM volatile (            \
+                                        "tst lr, #4         \n" \
+                                        "ite eq             \n" \
+                                        "mrseq r0, msp      \n" \
+                                        "mrsne r0, psp      \n" \
+                                        "mov r1, lr         \n" \
+                                        "b FAULT_HandlerC   \n" \
+                                    )
+
+
 /*================== Constant and Variable Definitions ====================*/
 
 /*================== Function Prototypes ==================================*/
+void FAULT_HandlerC(uint32_t *stackframe, uint32_t exc_return);
+static void FAULT_Classify(uint32_t *stackframe);
+
+void HardFault_Handler(void) __attribute__((naked));
+void MemManage_Handler(void) __attribute__((naked));
+void BusFault_Handler(void) __attribute__((naked));
+void UsageFault_Handler(void) __attribute__((naked));
+
 
 /*================== Function Implementations =============================*/
 
@@ -90,101 +116,86 @@ void NMI_Handler(void)
 }
 
 /**
-  * @brief  This function handles Hard Fault exception.
+  * @brief  Common C part of the fault handlers.
+  *
+  * Dumps exception frame, fault status registers and a stack window into backup SRAM,
+  * maps the fault to a diagnosis channel and performs a controlled reset.
+  *
+  * @param  stackframe: exception frame of the faulting context
+  * @param  exc_return: EXC_RETURN value of the exception entry
   *
   * @retval void
   */
-void HardFault_Handler(void)
+void FAULT_HandlerC(uint32_t *stackframe, uint32_t exc_return)
 {
-    uint32_t faultaddress;        // note: MSP Stack will be changed
-    uint32_t lr_register;
-    uint32_t sp_register;
-    uint32_t caller_addr_at_stack;
-  /* Go to infinite loop when Hard Fault exception occurs */
-//  while (1)
-//  {
-//  }
-
-#ifdef STM32F4
-
-    __ASM volatile ("mov %0, r14" : "=r" (lr_register) );
-
-//    VOID_FUNC_VOID fuptr;
-//    fuptr = (VOID_FUNC_VOID)(0xB0000020);
-//    fuptr();
-
-    // Check EXC_RETURN at exception entry to identify the used stack (MSP or PSP)
-    if(lr_register== 0xFFFFFFFD)   // Return to Thread mode, exception return uses non-floating-point state from
-    {                              // the PSP and execution uses PSP after return
-        sp_register = __get_PSP();
-    }
-    else if(lr_register== 0xFFFFFFF1)  // Return to Handler mode, exception return uses non-floating-point state from
-    {                                   // MSP and execution uses MSP after return
-        sp_register = __get_MSP() + 0x20;    // becaose of function local variables stack will be changed in MSP
+    DIAG_CrashDump(stackframe, exc_return, (uint32_t)stackframe, (DIAG_FAULT_SOURCE_e)(__get_IPSR() & 0x1FF));
+    FAULT_Classify(stackframe);
+    DIAG_CrashReset();
+}
+
+/**
+  * @brief  Maps the fault status to a diagnosis channel.
+  *
+  * @param  stackframe: exception frame of the faulting context
+  *
+  * @retval void
+  */
+static void FAULT_Classify(uint32_t *stackframe)
+{
+    uint32_t cfsr = SCB->CFSR;
+    uint32_t faultaddress = SCB->BFAR;
+
+    diag_fc.Val0 = cfsr;
+    diag_fc.Val1 = 0;
+    if(DIAG_CrashFrameValid(stackframe) == TRUE) {
+        diag_fc.Val1 = stackframe[6];   // report instruction address (stacked PC) where the fault has occured
     }
 
-    diag_fc.Val0 = SCB->CFSR;
     // Check if division by zero exception occured
-    if(SCB->CFSR &= 0x02000000) //FLAG: DIVBYZERO
+    if(cfsr & 0x02000000) //FLAG: DIVBYZERO
     {
-        caller_addr_at_stack = sp_register + 0x18;
-
-        diag_fc.Val1 = *(uint32_t*)caller_addr_at_stack;  // report instruction address where division has occured
         DIAG_Handler(DIAG_CH_DIV_BY_ZERO_FAILURE,DIAG_EVENT_NOK,0, NULL);
-
     }
 
-    else if(SCB->CFSR &= 0x00010000) //FLAG: UNDEFINSTR
+    else if(cfsr & 0x00010000) //FLAG: UNDEFINSTR
     {   // tested by undefined instruction in memory: "0xF7F0A000"
-        caller_addr_at_stack = sp_register+0x18;
-
-        diag_fc.Val1 = *(uint32_t*)caller_addr_at_stack;  // report instruction address with undefined instruction
         DIAG_Handler(DIAG_CH_UNDEF_INSTRUCTION_FAILURE,DIAG_EVENT_NOK,0, NULL);
     }
 
-
     // Check if data bus error occured or data access violation
-    else if(SCB->CFSR &= 0x00000202) //FLAG: PRECIS ERR or DACC VIOL
+    else if(cfsr & 0x00000202) //FLAG: PRECIS ERR or DACC VIOL
     {   // tested by data pointer to address area 0x04000000, 0xb0000000...
-        caller_addr_at_stack = sp_register+0x18;
-
-        diag_fc.Val1 = *(uint32_t*)(caller_addr_at_stack);    // report instruction address where data bus error has occured
-
-        faultaddress = SCB->BFAR;
-        if(SCB->CFSR &= 0x00008000) // check if BFAR (reported Bus Fault Address) is valid
+        if(cfsr & 0x00008000) // check if BFAR (reported Bus Fault Address) is valid
         {
             diag_fc.Val2 = faultaddress;                    // report bus address being accessed
         }
         DIAG_Handler(DIAG_CH_DATA_BUS_FAILURE,DIAG_EVENT_NOK,0, NULL);
-
     }
 
     // Check if instruction bus error occured or instruction access violation
-    else if(SCB->CFSR &= 0x00000101) //FLAG: IBUS ERR or IACC VIOL
+    else if(cfsr & 0x00000101) //FLAG: IBUS ERR or IACC VIOL
     {   // tested by using function pointer to address area 0x04000000, 0xb0000000...
-        caller_addr_at_stack = (sp_register+0x18);
-
-        diag_fc.Val1 = *(uint32_t*)(caller_addr_at_stack);    // report instruction address where instruction bus error has occured
-
-        faultaddress = SCB->BFAR;
-        if(SCB->CFSR &= 0x00008000) // check if BFAR (reported Bus Fault Address) is valid
+        if(cfsr & 0x00008000) // check if BFAR (reported Bus Fault Address) is valid
         {
             diag_fc.Val2 = faultaddress;                        // report bus address being accessed
         }
         DIAG_Handler(DIAG_CH_INSTRUCTION_BUS_FAILURE,DIAG_EVENT_NOK, 0, NULL);
-
     }
 
     else
     {
         DIAG_Handler(DIAG_CH_HARDFAULT_NOTHANDLED, DIAG_EVENT_NOK, 0, NULL);
     }
-#endif
-
-    while(1) {
-        ;
-    }
+}
 
+/**
+  * @brief  This function handles Hard Fault exception.
+  *
+  * @retval void
+  */
+void HardFault_Handler(void)
+{
+    FAULT_ENTER_HANDLER_C();
 }
 
 /**
@@ -194,10 +205,7 @@ void HardFault_Handler(void)
   */
 void MemManage_Handler(void)
 {
-  /* Go to infinite loop when Memory Manage exception occurs */
-  while (1)
-  {
-  }
+    FAULT_ENTER_HANDLER_C();
 }
 
 /**
@@ -208,10 +216,7 @@ void MemManage_Handler(void)
   */
 void BusFault_Handler(void)
 {
-  /* Go to infinite loop when Bus Fault exception occurs */
-  while (1)
-  {
-  }
+    FAULT_ENTER_HANDLER_C();
 }
 
 /**
@@ -221,10 +226,7 @@ void BusFault_Handler(void)
   */
 void UsageFault_Handler(void)
 {
-  /* Go to infinite loop when Usage Fault exception occurs */
-  while (1)
-  {
-  }
+    FAULT_ENTER_HANDLER_C();
 }
 
 #if 0
@@ -385,7 +387,7 @@ void DMA2_Stream3_IRQHandler(void)
  */
 void USART3_IRQHandler(void)
 {
-
+    COM_IRQHandler();
 }
 
 /**
@@ -405,6 +407,7 @@ void USART2_IRQHandler(void)
 
 void ADC_IRQHandler(void)
 {
+  FTRIP_IRQHandler();     // first: fast trip of the interlock
 
   HAL_NVIC_ClearPendingIRQ(ADC_IRQn);
   HAL_ADC_IRQHandler(&adc_devices[0]);
@@ -168,6 +168,13 @@
  */
 #define MEM_BKP_SRAM    __attribute__((section (".BKP_RAMSection")))
 
+/**
+ * A variable defined as ``(type) MEM_OS_STATIC (name)`` is placed in the
+ * statically allocated RTOS memory (task stacks), a not initialized section
+ * in RAM. Its size is listed in the map file (_sos_static, _eos_static).
+ */
+#define MEM_OS_STATIC   __attribute__((section (".os_static")))
+
 
 /*================== Constant and Variable Definitions ====================*/
 
@@ -35,6 +35,8 @@
 #include "general.h"
 #include "nvic_cfg.h"
 
+#include "fasttrip_cfg.h"
+
 /*================== Macros and Definitions ===============================*/
 
 /*================== Constant and Variable Definitions ====================*/
@@ -42,14 +44,14 @@
 /**
  IntPrio |
  ----------------------------------------------
- 0      |  -
+ 0      | ADC (analog watchdog fast trip, ADC1 shares the interrupt)
  1      | RTC Wakeup, Window Watchdog Prewarn
  2      | DMA
  3      | SPI
  4      |  -
  ---------------------------------------------
- 5      | ADC
- 6      | ADC
+ 5      |  -
+ 6      |  -
  7      | CAN
  8      | UART
  9-14   |  -
@@ -59,24 +61,38 @@
 
  A lower number equals a higher priority. Priority needs to be between 0 and 15
 
+ ADC1, ADC2 and ADC3 share ADC_IRQn, so ADC1 cannot have its own priority. With
+ FTRIP_ENABLE its end of conversion callback runs at priority 0 as well; it only stores
+ the raw value and uses no operating system function (adc_ex.c), the timestamp is taken
+ in ADC_Ctrl().
+
  If irqlock is set to NVIC_IRQ_LOCK_ENABLE, the interrupt is locked and will
  always have the state defined in nvic_interrupts[]
+
+ Interrupts are set up by NVIC_PostOsInit() in the engine task after the scheduler
+ start. Interrupts with NVIC_IRQ_INIT_PRE_OS are set up by NVIC_PreOsInit() before the
+ initialization of the drivers already: the self test of FTRIP_Init() waits for the
+ analog watchdog interrupt before the scheduler starts.
  */
 NVIC_InitStruct_s nvic_interrupts[] = { 
 
-        { USART2_IRQn, 7, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
-        { USART3_IRQn, 7, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
+        { USART2_IRQn, 7, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
+        { USART3_IRQn, 7, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
 
-        { DMA2_Stream2_IRQn, 2, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
-        { DMA2_Stream3_IRQn, 2, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
+        { DMA2_Stream2_IRQn, 2, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
+        { DMA2_Stream3_IRQn, 2, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
 
-        { ADC_IRQn, 8, NVIC_IRQ_LOCK_DISABLE, NVIC_IRQ_ENABLE },
+#if FTRIP_ENABLE == TRUE
+        { ADC_IRQn, 0, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_PRE_OS },
+#else
+        { ADC_IRQn, 8, NVIC_IRQ_LOCK_DISABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
+#endif
 
-        { SPI6_IRQn, 3, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
+        { SPI6_IRQn, 3, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
 
 #if BUILD_MODULE_ENABLE_SAFETY_FEATURES
-        { TIM3_IRQn, 4, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
-        { SPI2_IRQn, 3, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE },
+        { TIM3_IRQn, 4, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
+        { SPI2_IRQn, 3, NVIC_IRQ_LOCK_ENABLE, NVIC_IRQ_ENABLE, NVIC_IRQ_INIT_POST_OS },
 #endif
 };
 
@@ -51,11 +51,21 @@ typedef enum {
     NVIC_IRQ_LOCK_ENABLE = 1,
 }NVIC_IRQ_LOCK_e;
 
+/**
+ * initialization of an interrupt: by NVIC_PostOsInit() from the engine task (default)
+ * or already by NVIC_PreOsInit(), for interrupts needed before the scheduler starts
+ */
+typedef enum {
+    NVIC_IRQ_INIT_POST_OS = 0,
+    NVIC_IRQ_INIT_PRE_OS = 1,
+} NVIC_IRQ_INIT_e;
+
 typedef struct {
     IRQn_Type IRQ;
     uint8_t Prio;
     NVIC_IRQ_LOCK_e irqlock;
     NVIC_IRQ_STATE_e state;
+    NVIC_IRQ_INIT_e init;
 } NVIC_InitStruct_s;
 
 
@@ -59,6 +59,7 @@
 #include "mcu.h"
 #include "wdg.h"
 #include "adc.h"
+#include "fasttrip.h"
 
 /*================== Macros and Definitions ===============================*/
 
@@ -69,6 +70,7 @@
 /*================== Function Prototypes ==================================*/
 void SystemClock_Config(void);
 void BOOT_Init(void);
+static uint8_t MAIN_BackupDomainWarmInit(void);
 
 /*================== Function Implementations =============================*/
 /**
@@ -79,16 +81,25 @@ void BOOT_Init(void);
   */
 int main(void)
 {
+    uint8_t warmstart = FALSE;
+
     HAL_Init();         /* STM32F4xx HAL library initialization */
-    RTC_Init();
+    warmstart = MAIN_BackupDomainWarmInit();
+    if(warmstart == FALSE) {
+        RTC_Init();
+    }
 #if BUILD_MODULE_ENABLE_WATCHDOG
     WDG_Init();        /* initialize and start watchdog*/
 #endif
-    BKP_SRAM_Init();    // at this point diagnosis event memory in BKP_SRAM will be available
+    if(warmstart == FALSE) {
+        BKP_SRAM_Init();    // at this point diagnosis event memory in BKP_SRAM will be available
+    }
     SystemClock_Config();
 
     DIAG_Init(&diag_dev);
     BOOT_Init();
+    /* reset cause is evaluated (warm start, watchdog, main_state.CSR), otherwise the flags survive the next reset */
+    __HAL_RCC_CLEAR_RESET_FLAGS();
     IO_Init(&io_cfg[0]);
 
 #if BUILD_MODULE_ENABLE_SAFETY_FEATURES == 0
@@ -107,6 +118,9 @@ int main(void)
     LED_Init();
 #endif
     ADC_Init(adc_devices);
+    if (FTRIP_Init() != E_OK) {
+        DIAG_Handler(DIAG_CH_INTERLOCK_FAST_TRIP, DIAG_EVENT_NOK, 0, NULL);
+    }
 
     /* Initialize mutexes, events and tasks */
     OS_TaskInit();
@@ -130,6 +144,7 @@ int main(void)
     }
 
     os_boot = OS_INIT_OSSTARTKERNEL;    // start scheduler
+    OS_MarkKernelStart();
     osKernelStart();                    // osKernelStart() should never return 
     
     while(1)
@@ -140,6 +155,41 @@ int main(void)
 }
 
 
+/**
+ * @brief  enables the access to the backup domain after a fault reset without re-initializing it
+ *
+ * After the controlled reset of the fault handler (DIAG_CrashReset()) RTC and backup SRAM keep
+ * running and their configuration and content are still valid, so RTC_Init() and BKP_SRAM_Init()
+ * are skipped and only the register access is restored. This shortens the time until the system
+ * is back in safe operation.
+ *
+ * @return TRUE if backup domain was taken over (warm start), FALSE if it has to be initialized
+ */
+static uint8_t MAIN_BackupDomainWarmInit(void)
+{
+    __HAL_RCC_PWR_CLK_ENABLE();
+    __HAL_RCC_BKPSRAM_CLK_ENABLE();
+
+    /* only a pure software reset, a watchdog, brown-out or power-on reset always initializes the backup domain */
+    if((__HAL_RCC_GET_FLAG(RCC_FLAG_SFTRST) == RESET) || (DIAG_CrashResetPending() == FALSE) ||
+            (__HAL_RCC_GET_FLAG(RCC_FLAG_IWDGRST) != RESET) || (__HAL_RCC_GET_FLAG(RCC_FLAG_WWDGRST) != RESET) ||
+            (__HAL_RCC_GET_FLAG(RCC_FLAG_BORRST) != RESET) || (__HAL_RCC_GET_FLAG(RCC_FLAG_PORRST) != RESET) ||
+            (__HAL_RCC_GET_FLAG(RCC_FLAG_LPWRRST) != RESET)) {
+        return FALSE;
+    }
+
+    HAL_PWR_EnableBkUpAccess();
+    hrtc.Instance = RTC;
+    hrtc.Init = rtc_cfg.initconfig;
+
+    /* calendar shadow registers are not synchronized after a system reset */
+    __HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+    HAL_RTC_WaitForSynchro(&hrtc);
+    __HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+
+    return TRUE;
+}
+
 void SystemClock_Config(void)
 {
     RCC_ClockConfig();
@@ -107,7 +107,17 @@ static void NVIC_InitEXTI(void);
 /*================== Function Implementations =============================*/
 
 void NVIC_PreOsInit(void) {
-    ;
+    uint8_t i = 0;
+
+    /* NVIC_PostOsInit() sets up all interrupts again, including these */
+    for (i = 0; i < nvic_cfg_length; i++) {
+        if ((nvic_interrupts[i].init == NVIC_IRQ_INIT_PRE_OS) && (nvic_interrupts[i].Prio <= 15)) {
+            HAL_NVIC_SetPriority(nvic_interrupts[i].IRQ, nvic_interrupts[i].Prio, 0);
+            if (nvic_interrupts[i].state == NVIC_IRQ_ENABLE) {
+                HAL_NVIC_EnableIRQ(nvic_interrupts[i].IRQ);
+            }
+        }
+    }
 }
 
 
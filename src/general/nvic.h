@@ -46,6 +46,9 @@
 /**
  * @brief   Initializes and enables interrupts for usage before operating system has started.
  *
+ * Only the interrupts of nvic_interrupts[] with NVIC_IRQ_INIT_PRE_OS. Must be called
+ * before the driver initializations that wait for an interrupt (FTRIP_Init()).
+ *
  * @return  void
  */
 extern void NVIC_PreOsInit(void);
@@ -77,13 +77,19 @@ static DATA_BLOCK_ADC_s adc_tab = {
     .state_temperature = 0,
 };
 
-static uint8_t adc_conversion_state = ADC_CONVERT;
+/**
+ * conversion state and raw result, written by HAL_ADC_ConvCpltCallback()
+ */
+static volatile uint8_t adc_conversion_state = ADC_CONVERT;
+static volatile uint32_t adc_raw_voltage = 0;
 
 /*================== Function Prototypes ==================================*/
 
 /*================== Function Implementations =============================*/
 
 void ADC_Ctrl(void) {
+    float scaled_voltage = 0.0;
+    float scaled_temperature = 0.0;
 
     adc_cfg.Rank = 1;
     adc_cfg.SamplingTime = ADC_SAMPLETIME_3CYCLES;
@@ -96,6 +102,13 @@ void ADC_Ctrl(void) {
         ADC_Convert(&adc_devices[0]);
         adc_conversion_state = ADC_WAITFORCONVERSION;
     } else if (adc_conversion_state == ADC_STOREDATA) {
+        scaled_voltage = ((float)(adc_raw_voltage)*(1000.0*(float)(ADC_VREF_EXT)))/(ADC_FULL_RANGE);
+        scaled_temperature = (scaled_voltage - ADC_V25)/(1000.0*ADC_AVG_SLOPE) + 25.0;
+        adc_tab.temperature = scaled_temperature;
+        adc_tab.temperature_previous_timestamp = adc_tab.temperature_timestamp;
+        adc_tab.temperature_timestamp = MCU_GetTimeStamp();
+        adc_tab.state_temperature++;
+
         /* Store data in database */
         DB_WriteBlock(&adc_tab, DATA_BLOCK_ID_ADC);
         adc_conversion_state = ADC_CONVERT;
@@ -103,21 +116,17 @@ void ADC_Ctrl(void) {
 }
 
 
+/**
+ * @brief   stores the raw conversion result
+ *
+ * @details Runs in ADC_IRQHandler(), with FTRIP_ENABLE at the priority of the fast trip (above the
+ *          operating system, nvic_cfg.c), so it must not call operating system functions (including
+ *          MCU_GetTimeStamp()). Scaling and timestamp are done in ADC_Ctrl().
+ */
 void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* AdcHandle) {
-    uint32_t raw_voltage = 0;
-    float scaled_voltage = 0.0;
-    float scaled_temperature = 0.0;
-
     /* Disable interrupt and stop ADC conversion */
     HAL_ADC_Stop_IT(AdcHandle);
-    raw_voltage = HAL_ADC_GetValue(AdcHandle);
-
-    scaled_voltage = ((float)(raw_voltage)*(1000.0*(float)(ADC_VREF_EXT)))/(ADC_FULL_RANGE);
-    scaled_temperature = (scaled_voltage - ADC_V25)/(1000.0*ADC_AVG_SLOPE) + 25.0;
-    adc_tab.temperature = scaled_temperature;
-    adc_tab.temperature_previous_timestamp = adc_tab.temperature_timestamp;
-    adc_tab.temperature_timestamp = MCU_GetTimeStamp();
-    adc_tab.state_temperature++;
+    adc_raw_voltage = HAL_ADC_GetValue(AdcHandle);
 
     adc_conversion_state = ADC_STOREDATA;
 }
@@ -56,8 +56,9 @@ BKPSRAM_OPERATING_HOURS_s MEM_BKP_SRAM bkpsram_op_hours;
 const BKPSRAM_CH_CONT_COUNT_s default_contactors_count = {
     .data.cont_switch_closed = {0,0,0},
     .data.cont_switch_opened = {0,0,0},
-    .data.cont_switch_opened = {0,0,0}
-
+    .data.cont_switch_opened_hard_at_current = {0,0,0},
+    .data.i2t_estimate_opened = {0,0,0},
+    .checksum = BKPSRAM_CHECKSUM_SEED,
 };
 
 const BKPSRAM_CH_OP_HOURS_s default_operating_hours = {
@@ -66,9 +67,26 @@ const BKPSRAM_CH_OP_HOURS_s default_operating_hours = {
 };
 
 /*================== Function Prototypes ==================================*/
+static uint32_t BKPSRAM_CalcChecksum(DIAG_CONTACTOR_s *ptr);
 
 /*================== Function Implementations =============================*/
 
+/**
+ * @brief  calculates the checksum of the contactor data over all 16bit words
+ *
+ * @param  ptr pointer to the contactor data
+ * @return checksum
+*/
+static uint32_t BKPSRAM_CalcChecksum(DIAG_CONTACTOR_s *ptr) {
+    uint16_t *u16ptr = (uint16_t *)ptr;
+    uint32_t checksum = BKPSRAM_CHECKSUM_SEED;
+
+    for(uint32_t i = 0; i < sizeof(DIAG_CONTACTOR_s)/2; i++)
+        checksum += *u16ptr++;
+
+    return checksum;
+}
+
 void BKPSRAM_Set_contactorcnt(DIAG_CONTACTOR_s *ptr) {
     uint32_t interrupt_status = 0;
 
@@ -79,7 +97,7 @@ void BKPSRAM_Set_contactorcnt(DIAG_CONTACTOR_s *ptr) {
     bkpsram_contactors_count.data = *ptr;
 
     /* calculate checksum*/
-    //bkpsram_ch_1.checksum = EEPR_CalcChecksum((uint8_t *)(&bkpsram_ch_1),sizeof(bkpsram_ch_1)-4);
+    bkpsram_contactors_count.checksum = BKPSRAM_CalcChecksum(&bkpsram_contactors_count.data);
 
     /* Enable interrupts */
     MCU_RestoreINT(interrupt_status);
@@ -92,3 +110,50 @@ void BKPSRAM_Get_contactorcnt(DIAG_CONTACTOR_s *ptr) {
 }
 
 
+void BKPSRAM_Inc_contactorcnt(uint16_t *counter) {
+    uint32_t interrupt_status = 0;
+
+    interrupt_status = MCU_DisableINT();
+
+    if(*counter < 0xFFFF) {
+        (*counter)++;
+        bkpsram_contactors_count.checksum++;
+    }
+
+    MCU_RestoreINT(interrupt_status);
+}
+
+
+void BKPSRAM_Add_contactori2testimate(uint8_t contactor, uint32_t i2t_estimate) {
+    uint32_t interrupt_status = 0;
+    uint32_t oldval;
+    uint32_t newval;
+
+    if(contactor >= BS_NR_OF_CONTACTORS)
+        return;
+
+    interrupt_status = MCU_DisableINT();
+
+    oldval = bkpsram_contactors_count.data.i2t_estimate_opened[contactor];
+    newval = oldval + i2t_estimate;
+    if(newval < oldval)
+        newval = 0xFFFFFFFF;
+
+    bkpsram_contactors_count.data.i2t_estimate_opened[contactor] = newval;
+
+    /* the value contributes with both 16bit halves to the checksum */
+    bkpsram_contactors_count.checksum += (newval & 0xFFFF) + (newval >> 16) - (oldval & 0xFFFF) - (oldval >> 16);
+
+    MCU_RestoreINT(interrupt_status);
+}
+
+
+STD_RETURN_TYPE_e BKPSRAM_Check_contactorcnt(void) {
+    if(bkpsram_contactors_count.checksum == BKPSRAM_CalcChecksum(&bkpsram_contactors_count.data))
+        return E_OK;
+
+    bkpsram_contactors_count = default_contactors_count;
+    return E_NOT_OK;
+}
+
+
@@ -55,6 +55,13 @@
  */
 #define BKP_SRAM_ENABLE
 
+/**
+ * Start value of the checksum of bkpsram_contactors_count.
+ * The checksum is the sum of all 16bit words of the data plus this value,
+ * so a zero-filled backup SRAM is not accepted as valid.
+ */
+#define BKPSRAM_CHECKSUM_SEED   (0xC0A7C0A7)
+
 
 
 /**
@@ -107,6 +114,33 @@ extern void BKPSRAM_Set_contactorcnt(DIAG_CONTACTOR_s *ptr);
 */
 extern void BKPSRAM_Get_contactorcnt(DIAG_CONTACTOR_s *ptr);
 
+/**
+ * @brief  Increments a switching counter of bkpsram_contactors_count.data (saturating)
+ *
+ * The checksum is updated with the difference of the counter value, so the costs
+ * do not depend on the size of the data.
+ *
+ * @param  counter pointer to a counter inside bkpsram_contactors_count.data
+ * @return void
+*/
+extern void BKPSRAM_Inc_contactorcnt(uint16_t *counter);
+
+/**
+ * @brief  Adds the I2t estimate of an opening event to the accumulated I2t estimate of a contactor (saturating)
+ *
+ * @param  contactor        contactor number
+ * @param  i2t_estimate     I2t estimate of the opening event in A^2*ms
+ * @return void
+*/
+extern void BKPSRAM_Add_contactori2testimate(uint8_t contactor, uint32_t i2t_estimate);
+
+/**
+ * @brief  Verifies the checksum of bkpsram_contactors_count and restores the defaults if it is invalid
+ *
+ * @return E_OK if the data was valid, E_NOT_OK if the defaults were restored
+*/
+extern STD_RETURN_TYPE_e BKPSRAM_Check_contactorcnt(void);
+
 /*================== Function Implementations =============================*/
 
 
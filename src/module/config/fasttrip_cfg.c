@@ -0,0 +1,79 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    fasttrip_cfg.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS_CONF
+ * @prefix  FTRIP
+ *
+ * @brief   Configuration of the hardware fast trip path
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "fasttrip_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * ADC configuration of the fast trip channels: single channel, continuous conversion,
+ * no end of conversion interrupt. Same clock prescaler as ADC1 (common to all ADCs).
+ */
+#define FTRIP_ADC_INIT(instance)    {                                           \
+            .Instance = (instance),                                             \
+            .Init.Resolution = ADC_RESOLUTION_12B,                              \
+            .Init.DataAlign = ADC_DATAALIGN_RIGHT,                              \
+            .Init.ScanConvMode = DISABLE,                                       \
+            .Init.ContinuousConvMode = ENABLE,                                  \
+            .Init.DiscontinuousConvMode = DISABLE,                              \
+            .Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE,         \
+            .Init.ExternalTrigConv = ADC_SOFTWARE_START,                        \
+            .Init.DMAContinuousRequests = DISABLE,                              \
+            .Init.NbrOfDiscConversion = 1,                                      \
+            .Init.NbrOfConversion = 1,                                          \
+            .Init.EOCSelection = ADC_EOC_SINGLE_CONV,                           \
+            .Init.ClockPrescaler = ADC_CLOCKPRESCALER_PCLK_DIV2,                \
+    }
+
+/*================== Constant and Variable Definitions ====================*/
+
+ADC_HandleTypeDef ftrip_adc_devices[FTRIP_NR_OF_CHANNELS] = {
+    FTRIP_ADC_INIT(ADC2),
+    FTRIP_ADC_INIT(ADC3),
+};
+
+/**
+ * current on PC0 (ADC123_IN10), pack voltage on PC1 (ADC123_IN11).
+ * The pack voltage window has no lower limit, undervoltage is not a fast fault.
+ */
+const FTRIP_CHANNEL_CFG_s ftrip_channels[FTRIP_NR_OF_CHANNELS] = {
+    {&ftrip_adc_devices[0], ADC_CHANNEL_10, ADC_SAMPLETIME_15CYCLES,
+     FTRIP_RAW_CURRENT(-FTRIP_CURRENT_MAX_CHARGE_MA), FTRIP_RAW_CURRENT(FTRIP_CURRENT_MAX_DISCHARGE_MA)},
+    {&ftrip_adc_devices[1], ADC_CHANNEL_11, ADC_SAMPLETIME_15CYCLES,
+     0, FTRIP_RAW_VOLTAGE(FTRIP_PACK_VOLTAGE_MAX_MV)},
+};
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
@@ -0,0 +1,210 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    fasttrip_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS_CONF
+ * @prefix  FTRIP
+ *
+ * @brief   Configuration of the hardware fast trip path
+ *
+ * The battery current (output of the current sense amplifier) and the divided pack
+ * voltage are converted continuously by ADC2 and ADC3. The analog watchdog of each
+ * ADC compares every conversion with the trip window and raises an interrupt on a
+ * violation, which opens the interlock directly.
+ */
+
+#ifndef FASTTRIP_CFG_H_
+#define FASTTRIP_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "mcu_cfg.h"
+#include "batterycell_cfg.h"
+#include "batterysystem_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * enables the fast trip path. If FALSE, only the software checks of the BMS open the interlock.
+ * Enable only on hardware with the analog front-end below, after the trip latency has been
+ * measured on the target. Can be set by the build, the host test (test_fasttrip) runs with TRUE.
+ * \par Type:
+ * select(2)
+ * \par Default:
+ * FALSE
+*/
+#ifndef FTRIP_ENABLE
+#define FTRIP_ENABLE                        FALSE
+#endif
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * reference voltage of the ADCs (same as ADC_VREF_EXT of the ADC driver)
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * 2500
+*/
+#define FTRIP_ADC_VREF_MV                   (2500)
+
+/**
+ * full scale of the 12bit ADCs
+ */
+#define FTRIP_ADC_FULL_RANGE                (4095)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * output voltage of the current sense amplifier at zero current
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * 1250
+*/
+#define FTRIP_CURRENT_ZERO_MV               (1250)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * sensitivity of the current sense amplifier, positive for discharge current
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV/A
+ * \par Default:
+ * 25
+*/
+#define FTRIP_CURRENT_SENSITIVITY_MV_PER_A  (25)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * trip limit of the discharge current. Above the software limit BMS_CURRENTMAX, the fast
+ * path catches hard faults only and the software checks stay the supervisory layer.
+ * \par Type:
+ * int
+ * \par Unit:
+ * mA
+ * \par Default:
+ * 30000
+*/
+#define FTRIP_CURRENT_MAX_DISCHARGE_MA      (30000)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * trip limit of the charge current (magnitude)
+ * \par Type:
+ * int
+ * \par Unit:
+ * mA
+ * \par Default:
+ * 30000
+*/
+#define FTRIP_CURRENT_MAX_CHARGE_MA         (30000)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * ratio of the pack voltage divider (pack voltage / ADC input voltage)
+ * \par Type:
+ * int
+ * \par Default:
+ * 40
+*/
+#define FTRIP_VOLTAGE_DIVIDER               (40)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * trip limit of the pack voltage, 5% above all cells at BC_VOLTMAX
+ * \par Type:
+ * int
+ * \par Unit:
+ * mV
+ * \par Default:
+ * BS_NR_OF_BAT_CELLS * BC_VOLTMAX * 105 / 100
+*/
+#define FTRIP_PACK_VOLTAGE_MAX_MV           ((uint32_t)BS_NR_OF_BAT_CELLS * BC_VOLTMAX * 105 / 100)
+
+/**
+ * @ingroup CONFIG_FTRIP
+ * longest time the self test of FTRIP_Init() waits for the trip
+ * \par Type:
+ * int
+ * \par Unit:
+ * CPU cycles
+ * \par Default:
+ * 10000
+*/
+#define FTRIP_SELFTEST_TIMEOUT_CYCLES       (10000)
+
+/**
+ * ADC raw value of an ADC input voltage in mV
+ */
+#define FTRIP_RAW(mV)                       ((uint32_t)(((mV) * FTRIP_ADC_FULL_RANGE) / FTRIP_ADC_VREF_MV))
+
+/**
+ * ADC raw value of a current in mA (discharge positive)
+ */
+#define FTRIP_RAW_CURRENT(mA)               FTRIP_RAW(FTRIP_CURRENT_ZERO_MV + ((mA) * FTRIP_CURRENT_SENSITIVITY_MV_PER_A) / 1000)
+
+/**
+ * ADC raw value of a pack voltage in mV
+ */
+#define FTRIP_RAW_VOLTAGE(mV)               FTRIP_RAW((mV) / FTRIP_VOLTAGE_DIVIDER)
+
+/**
+ * GPIO port and pin of the interlock control line (IO_PIN_MCU_1_INTERLOCK_CONTROL),
+ * written directly from the interrupt. Reset level opens the interlock.
+ */
+#define FTRIP_INTERLOCK_GPIO                GPIOD
+#define FTRIP_INTERLOCK_PIN                 GPIO_PIN_4
+
+/**
+ * configuration of a fast trip channel, one channel per ADC
+ */
+typedef struct {
+    ADC_HandleTypeDef *adc;     /*!< ADC that converts the channel continuously     */
+    uint32_t channel;           /*!< ADC input channel                              */
+    uint32_t sampling_time;     /*!< sampling time of the conversion                */
+    uint32_t low_raw;           /*!< lower limit of the window, ADC raw value       */
+    uint32_t high_raw;          /*!< upper limit of the window, ADC raw value       */
+} FTRIP_CHANNEL_CFG_s;
+
+/**
+ * number of fast trip channels in ftrip_channels[]
+ */
+#define FTRIP_NR_OF_CHANNELS                (2)
+
+/*================== Constant and Variable Definitions ====================*/
+
+extern ADC_HandleTypeDef ftrip_adc_devices[FTRIP_NR_OF_CHANNELS];
+extern const FTRIP_CHANNEL_CFG_s ftrip_channels[FTRIP_NR_OF_CHANNELS];
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* FASTTRIP_CFG_H_ */
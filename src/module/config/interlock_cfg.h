@@ -70,6 +70,13 @@ typedef enum {
 
 #define ILCK_STATEMACH_SHORTTIME_MS     1
 
+/**
+ * contactor index in DIAG_CONTACTOR_s used for the switching accounting of the interlock.
+ * Opening the interlock opens the contactors of the primary, so every interlock transition
+ * is counted as one switching cycle of this contactor.
+ */
+#define ILCK_ACCOUNTING_CONTACTOR_NR    0
+
 
 /*================== Constant and Variable Definitions ====================*/
 
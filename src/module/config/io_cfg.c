@@ -86,6 +86,8 @@ const IO_PIN_CFG_s io_cfg[] = {
      */
     {IO_PIN_MCU_1_INTERLOCK_CONTROL,               IO_MODE_OUTPUT_PP,   0,                     0,                  IO_ALTERNATE_NO_ALTERNATE,  IO_PIN_LOCK_ENABLE},
     {IO_PIN_MCU_1_INTERLOCK_FEEDBACK,              IO_MODE_INPUT,       IO_PIN_PULLDOWN,       IO_SPEED_FAST,      IO_ALTERNATE_NO_ALTERNATE,  IO_PIN_LOCK_ENABLE},
+    {IO_PIN_MCU_1_FAST_TRIP_CURRENT,               IO_MODE_ANALOG,      IO_PIN_NOPULL,         0,                  IO_ALTERNATE_NO_ALTERNATE,  IO_PIN_LOCK_ENABLE},
+    {IO_PIN_MCU_1_FAST_TRIP_VOLTAGE,               IO_MODE_ANALOG,      IO_PIN_NOPULL,         0,                  IO_ALTERNATE_NO_ALTERNATE,  IO_PIN_LOCK_ENABLE},
 
     /*
      * Interfaces
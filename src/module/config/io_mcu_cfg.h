@@ -81,6 +81,12 @@
 #define IO_PIN_MCU_1_INTERLOCK_CONTROL               IO_PD_4
 #define IO_PIN_MCU_1_INTERLOCK_FEEDBACK              IO_PD_5
 
+/*
+ *Analog inputs of the fast trip path
+ */
+#define IO_PIN_MCU_1_FAST_TRIP_CURRENT               IO_PC_0
+#define IO_PIN_MCU_1_FAST_TRIP_VOLTAGE               IO_PC_1
+
 /*
  *Interfaces
  */
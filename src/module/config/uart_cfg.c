@@ -46,7 +46,17 @@
 
 /*================== Constant and Variable Definitions ====================*/
 UART_HandleTypeDef uart_cfg[UART_NUMBER_OF_USED_UART_CHANNELS] = {
-
+    {
+        /* FTDI USB-UART bridge, link of the external diagnosis tool (COM) */
+        .Instance = USART3,
+        .Init.BaudRate = 115200,
+        .Init.WordLength = UART_WORDLENGTH_8B,
+        .Init.StopBits = UART_STOPBITS_1,
+        .Init.Parity = UART_PARITY_NONE,
+        .Init.Mode = UART_MODE_TX_RX,
+        .Init.HwFlowCtl = UART_HWCONTROL_NONE,
+        .Init.OverSampling = UART_OVERSAMPLING_16,
+    },
 };
 
 uint8_t uart_cfg_length = sizeof(uart_cfg)/sizeof(uart_cfg[0]);
@@ -42,7 +42,7 @@
 /**
  * Number of UART-channels that can be used
  */
-#define UART_NUMBER_OF_USED_UART_CHANNELS 0
+#define UART_NUMBER_OF_USED_UART_CHANNELS 1
 
 /*================== Constant and Variable Definitions ====================*/
 extern UART_HandleTypeDef uart_cfg[];
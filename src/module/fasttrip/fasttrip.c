@@ -0,0 +1,234 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    fasttrip.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  FTRIP
+ *
+ * @brief   Hardware fast trip path for overcurrent and overvoltage
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "fasttrip.h"
+
+#include "diag.h"
+#include "evt.h"
+#include "mcu.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * status, written by the interrupt
+ */
+static volatile FTRIP_STATUS_s ftrip_status;
+
+/**
+ * trips already seen by FTRIP_Trigger()
+ */
+static uint8_t ftrip_detected = 0;
+
+static volatile uint8_t ftrip_rearm_request = FALSE;
+static volatile uint8_t ftrip_selftest = FALSE;
+static volatile uint32_t ftrip_selftest_start = 0;
+
+/*================== Function Prototypes ==================================*/
+
+static void FTRIP_SetWindow(uint8_t ch, uint32_t low_raw, uint32_t high_raw);
+static void FTRIP_Arm(uint8_t ch);
+
+/*================== Function Implementations =============================*/
+
+STD_RETURN_TYPE_e FTRIP_Init(void) {
+    STD_RETURN_TYPE_e retval = E_OK;
+#if FTRIP_ENABLE == TRUE
+    ADC_ChannelConfTypeDef channel;
+    ADC_AnalogWDGConfTypeDef watchdog;
+    uint32_t start = 0;
+    uint8_t i = 0;
+
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    __HAL_RCC_ADC2_CLK_ENABLE();
+    __HAL_RCC_ADC3_CLK_ENABLE();
+
+    for (i = 0; i < FTRIP_NR_OF_CHANNELS; i++) {
+        HAL_ADC_Init(ftrip_channels[i].adc);
+
+        channel.Channel = ftrip_channels[i].channel;
+        channel.Rank = 1;
+        channel.SamplingTime = ftrip_channels[i].sampling_time;
+        channel.Offset = 0;
+        HAL_ADC_ConfigChannel(ftrip_channels[i].adc, &channel);
+
+        watchdog.WatchdogMode = ADC_ANALOGWATCHDOG_SINGLE_REG;
+        watchdog.HighThreshold = ftrip_channels[i].high_raw;
+        watchdog.LowThreshold = ftrip_channels[i].low_raw;
+        watchdog.Channel = ftrip_channels[i].channel;
+        watchdog.ITMode = ENABLE;
+        watchdog.WatchdogNumber = 0;
+        HAL_ADC_AnalogWDGConfig(ftrip_channels[i].adc, &watchdog);
+
+        HAL_ADC_Start(ftrip_channels[i].adc);
+    }
+
+    /* self test of each channel: an empty window (low > high) is violated by the next conversion */
+    ftrip_selftest = TRUE;
+    for (i = 0; i < FTRIP_NR_OF_CHANNELS; i++) {
+        ftrip_selftest_start = DWT->CYCCNT;
+        FTRIP_SetWindow(i, FTRIP_ADC_FULL_RANGE, 0);
+        start = DWT->CYCCNT;
+        while (((ftrip_status.tripped_channels & (1U << i)) == 0) &&
+               ((DWT->CYCCNT - start) < FTRIP_SELFTEST_TIMEOUT_CYCLES)) {
+            ;
+        }
+        if ((ftrip_status.tripped_channels & (1U << i)) == 0) {
+            retval = E_NOT_OK;
+        }
+
+        FTRIP_SetWindow(i, ftrip_channels[i].low_raw, ftrip_channels[i].high_raw);
+        FTRIP_Arm(i);
+    }
+    ftrip_selftest = FALSE;
+#endif
+    return retval;
+}
+
+
+void FTRIP_IRQHandler(void) {
+#if FTRIP_ENABLE == TRUE
+    uint32_t entry = DWT->CYCCNT;
+    uint32_t cycles = 0;
+    ADC_TypeDef *adc = NULL_PTR;
+    uint8_t i = 0;
+
+    for (i = 0; i < FTRIP_NR_OF_CHANNELS; i++) {
+        adc = ftrip_channels[i].adc->Instance;
+        if (((adc->SR & ADC_SR_AWD) != 0) && ((adc->CR1 & ADC_CR1_AWDIE) != 0)) {
+            FTRIP_INTERLOCK_GPIO->BSRR = (uint32_t)FTRIP_INTERLOCK_PIN << 16;
+            cycles = DWT->CYCCNT;
+
+            /* latched until re-armed by FTRIP_Trigger() */
+            adc->CR1 &= ~ADC_CR1_AWDIE;
+            adc->SR = ~ADC_SR_AWD;
+            ftrip_status.tripped_channels |= (uint8_t)(1U << i);
+
+            if (ftrip_selftest == TRUE) {
+                ftrip_status.selftest_cycles[i] = cycles - ftrip_selftest_start;
+            } else {
+                ftrip_status.isr_cycles_last = cycles - entry;
+                if (ftrip_status.isr_cycles_last > ftrip_status.isr_cycles_max) {
+                    ftrip_status.isr_cycles_max = ftrip_status.isr_cycles_last;
+                }
+                ftrip_status.trip_count++;
+            }
+        }
+    }
+#endif
+}
+
+
+void FTRIP_Trigger(void) {
+#if FTRIP_ENABLE == TRUE
+    uint8_t tripped = ftrip_status.tripped_channels;
+    uint32_t value = 0;
+    uint8_t i = 0;
+
+    if ((tripped & ~ftrip_detected) != 0) {
+        ftrip_status.trip_timestamp = MCU_GetTimeStamp();
+        (void)EVT_Post(EVT_FAST_TRIP, tripped);
+    }
+    ftrip_detected = tripped;
+
+    if (tripped == 0) {
+        DIAG_Handler(DIAG_CH_INTERLOCK_FAST_TRIP, DIAG_EVENT_OK, 0, NULL_PTR);
+    } else {
+        DIAG_Handler(DIAG_CH_INTERLOCK_FAST_TRIP, DIAG_EVENT_NOK, 0, NULL_PTR);
+
+        if (ftrip_rearm_request == TRUE) {
+            for (i = 0; i < FTRIP_NR_OF_CHANNELS; i++) {
+                value = ftrip_channels[i].adc->Instance->DR;
+                if (((tripped & (1U << i)) != 0) &&
+                    (value >= ftrip_channels[i].low_raw) && (value <= ftrip_channels[i].high_raw)) {
+                    FTRIP_Arm(i);
+                }
+            }
+            if (ftrip_status.tripped_channels == 0) {
+                ftrip_rearm_request = FALSE;
+            }
+        }
+    }
+#endif
+}
+
+
+void FTRIP_Rearm(void) {
+    if (ftrip_status.tripped_channels != 0) {
+        ftrip_rearm_request = TRUE;
+    }
+}
+
+
+void FTRIP_GetStatus(FTRIP_STATUS_s *status) {
+    __disable_irq();
+    *status = ftrip_status;
+    __enable_irq();
+}
+
+
+/**
+ * @brief   sets the window of the analog watchdog of a channel
+ *
+ * @param   ch:         channel index in ftrip_channels[]
+ * @param   low_raw:    lower limit, ADC raw value
+ * @param   high_raw:   upper limit, ADC raw value
+ */
+static void FTRIP_SetWindow(uint8_t ch, uint32_t low_raw, uint32_t high_raw) {
+    ftrip_channels[ch].adc->Instance->LTR = low_raw;
+    ftrip_channels[ch].adc->Instance->HTR = high_raw;
+}
+
+
+/**
+ * @brief   clears the trip of a channel and enables its analog watchdog interrupt
+ *
+ * @details The trip mask is also written by the interrupt, so the interrupts are disabled
+ *          for the read-modify-write (the ADC interrupt is not masked by the operating system).
+ *
+ * @param   ch:     channel index in ftrip_channels[]
+ */
+static void FTRIP_Arm(uint8_t ch) {
+    ADC_TypeDef *adc = ftrip_channels[ch].adc->Instance;
+
+    __disable_irq();
+    adc->SR = ~ADC_SR_AWD;
+    adc->CR1 |= ADC_CR1_AWDIE;
+    ftrip_status.tripped_channels &= (uint8_t)~(1U << ch);
+    __enable_irq();
+}
@@ -0,0 +1,116 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    fasttrip.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  FTRIP
+ *
+ * @brief   Hardware fast trip path for overcurrent and overvoltage
+ *
+ * The analog watchdogs of ADC2 and ADC3 supervise current and pack voltage on
+ * every conversion. On a violation the ADC interrupt (highest priority, not masked
+ * by the operating system) drives the interlock control line low and latches the
+ * trip. The software path stays the supervisory layer: FTRIP_Trigger() reports the
+ * trip on DIAG_CH_INTERLOCK_FAST_TRIP, which sets an error flag, so the BMS enters
+ * its error state and requests the interlock open as well. The trip is re-armed
+ * after the BMS has opened the interlock (FTRIP_Rearm()) and both values are back
+ * inside their window.
+ *
+ * Latency from the ADC input to the interlock control pin, derived from the clock
+ * configuration (ADCCLK 42MHz, 15 + 12 ADCCLK per conversion, 168MHz core) and not
+ * measured on the target: at most two conversions (1.3us) until the violating sample
+ * is converted, 12 cycles interrupt entry and the cycles of FTRIP_IRQHandler() up to the
+ * pin write (isr_cycles_last). The self test measures the digital part only (window
+ * change to pin, selftest_cycles). The analog front-end, the interlock driver and the
+ * contactors are not included.
+ */
+
+#ifndef FASTTRIP_H_
+#define FASTTRIP_H_
+
+/*================== Includes =============================================*/
+#include "fasttrip_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * trip latencies in CPU cycles, SystemCoreClock cycles per second
+ */
+typedef struct {
+    uint32_t selftest_cycles[FTRIP_NR_OF_CHANNELS]; /*!< from window violation (threshold change) to interlock line low, measured by FTRIP_Init()  */
+    uint32_t isr_cycles_last;   /*!< from interrupt handler entry to interlock line low, last trip                             */
+    uint32_t isr_cycles_max;    /*!< maximum of isr_cycles_last                                                                 */
+    uint32_t trip_count;        /*!< number of trips since startup, without the self test                                       */
+    uint32_t trip_timestamp;    /*!< MCU_GetTimeStamp() when FTRIP_Trigger() detected the last trip                              */
+    uint8_t tripped_channels;   /*!< bit i set if channel i tripped since the last re-arm                                       */
+} FTRIP_STATUS_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   initializes ADC2/ADC3 with their analog watchdogs and measures the trip latency
+ *
+ * @details Must be called before the interlock is closed for the first time: the self test
+ *          moves the window of each channel in turn so that the next conversion violates it and
+ *          measures the cycles until the interrupt has driven the interlock line low.
+ *
+ * @return  E_OK if the self test of every channel tripped within FTRIP_SELFTEST_TIMEOUT_CYCLES,
+ *          E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e FTRIP_Init(void);
+
+/**
+ * @brief   handles the analog watchdog flags of the fast trip ADCs
+ *
+ * @details Called first in ADC_IRQHandler(). Does not use any operating system function.
+ */
+extern void FTRIP_IRQHandler(void);
+
+/**
+ * @brief   reports the trip state to the diagnosis and re-arms the trip if requested
+ *
+ * @details Called every 1ms in the engine task.
+ */
+extern void FTRIP_Trigger(void);
+
+/**
+ * @brief   requests to re-arm the trip once both values are back inside their window
+ *
+ * @details Called by the BMS after it has requested the interlock open itself.
+ */
+extern void FTRIP_Rearm(void);
+
+/**
+ * @brief   returns the trip latencies and counters
+ *
+ * @param   status: pointer where the status is written to
+ */
+extern void FTRIP_GetStatus(FTRIP_STATUS_s *status);
+
+/*================== Function Implementations =============================*/
+
+#endif /* FASTTRIP_H_ */
@@ -50,6 +50,7 @@
 
 #include "nvic.h"
 #include "diag.h"
+#include "stm32f4xx_hal.h"
 
 
 /*================== Macros and Definitions ===============================*/
@@ -66,12 +67,105 @@ uint8_t eng_init = FALSE;
  */
 uint32_t os_schedulerstarttime;
 
+/**
+ * start barrier of the tasks, OS_EVENT_SYSTEM_RUNNING is set after the post-OS initialization
+ */
+static EventGroupHandle_t os_start_barrier = NULL;
+
+/**
+ * cycle counter at the start of the scheduler, reference of os_start_timing
+ */
+static uint32_t os_kernelstart_cycles = 0;
+
+static OS_START_TIMING_s os_start_timing;
+
+/**
+ * cycle counters of a task, indexed by the TCB number (index 0: unknown task)
+ */
+typedef struct {
+    uint32_t cycles;            /*!< executed cycles, accumulated at every switch out       */
+    uint32_t mark;              /*!< executed cycles at the last OS_MarkActivation()        */
+    uint8_t mark_valid;         /*!< TRUE after the first OS_MarkActivation()               */
+    uint32_t activation_max;    /*!< longest activation in cycles                           */
+    uint32_t slice_max;         /*!< longest time slice in cycles                           */
+    uint32_t cycles_last;       /*!< executed cycles at the last load report                */
+} OS_LOAD_COUNTER_s;
+
+static OS_LOAD_COUNTER_s os_load_counter[OS_LOAD_MAX_TASKS];
+
+/**
+ * TCB number of the running task and cycle counter at its switch in
+ */
+static volatile uint32_t os_load_current = 0;
+static uint32_t os_load_switchin_cycles = 0;
+
+/**
+ * state of the load report
+ */
+static uint32_t os_load_timestamp_last = 0;
+static uint8_t os_load_started = FALSE;
+static uint32_t os_load_tasks_overflow = 0;
+static OS_LOAD_s os_load_new;
+static OS_LOAD_s os_load;
+
+/**
+ * number of sleeps of the idle task (OS_IdleTask()), total and at the last load report
+ */
+static volatile uint32_t os_idle_sleeps = 0;
+static uint32_t os_idle_sleeps_last = 0;
+
+/**
+ * cycles slept in OS_IdleTask() (SysTick based, see OS_GetSysTickCycles()), total and at the last load report
+ */
+static volatile uint32_t os_idle_sleep_cycles = 0;
+static uint32_t os_idle_sleep_cycles_last = 0;
+
+/**
+ * cycle counter at the last tick interrupt (vApplicationTickHook())
+ */
+static volatile uint32_t os_tick_cycles = 0;
+
+/**
+ * tasks registered with OS_RegisterStack(), the load and the stack report are made from this list
+ */
+typedef struct {
+    xTaskHandle handle;         /*!< task handle                                            */
+    const char *name;           /*!< task name                                              */
+    uint32_t number;            /*!< TCB number, index of os_load_counter[]                 */
+    uint32_t size_words;        /*!< stack size in words                                    */
+    volatile uint32_t free_min_words;   /*!< high-water mark, last sample of OS_SampleStack() */
+} OS_TASK_ENTRY_s;
+
+static OS_TASK_ENTRY_s os_task_entry[OS_LOAD_MAX_TASKS];
+static volatile uint8_t os_nr_of_task_entries = 0;
+
+/**
+ * next entry of os_task_entry[] sampled by OS_SampleStack() and tick of the last sample
+ */
+static uint8_t os_stack_sample_index = 0;
+static uint32_t os_stack_sample_tick = 0;
+static OS_STACK_s os_stack_new;
+static OS_STACK_s os_stack;
+
+/**
+ * free FreeRTOS heap after the start up, see OS_GetHeapFree()
+ */
+static uint32_t os_heap_free = 0;
+
 /*================== Function Prototypes ==================================*/
+static uint32_t OS_GetStartTimeUs(void);
+static uint32_t OS_GetSysTickCycles(void);
+static void OS_UpdateStack(uint32_t timestamp);
+static void OS_SampleStack(void);
+static UBaseType_t OS_GetFreeRtosPriority(OS_PRIORITY_e priority);
 
 /*================== Function Implementations =============================*/
 
 void OS_TaskInit() {
 
+    // Start barrier, must exist before the tasks are created
+    os_start_barrier = xEventGroupCreate();
+
     // Configuration of RTOS Queues
     os_boot = OS_ENG_CREATE_QUEUES;
     ENG_CreateQueues();
@@ -107,6 +201,72 @@ void vApplicationIdleHook(void) {
 }
 
 
+void vApplicationTickHook(void) {
+    os_tick_cycles = DWT->CYCCNT;
+}
+
+
+void vApplicationStackOverflowHook(xTaskHandle xTask, char *pcTaskName) {
+    uint32_t lr_register = 0;
+    uint32_t sp_register = 0;
+
+    /*
+     * called in the context switch (main stack), the task stack can not be trusted anymore.
+     * No kernel, event or DIAG_Handler() calls here: only the crash dump is written, the
+     * diagnosis entry is made by DIAG_Init() after the reset.
+     */
+#ifdef STM32F4
+    __ASM volatile ("mov %0, r14" : "=r" (lr_register) );
+    __ASM volatile ("mov %0, r13" : "=r" (sp_register) );
+#endif
+
+    DIAG_CrashDump(NULL_PTR, lr_register, sp_register, DIAG_FAULT_STACKOVERFLOW);
+    diag_crashdump.task = (os_load_current != 0) ? os_load_current : OS_LOAD_MAX_TASKS;
+    __DSB();
+    DIAG_CrashReset();
+}
+
+
+void vApplicationMallocFailedHook(void) {
+    configASSERT(0);
+}
+
+
+xTaskHandle OS_CreateTask(const char *name, os_pthread function, BMS_Task_Definition_s *taskdef, StackType_t *stack) {
+    xTaskHandle handle = NULL;
+
+    if (xTaskGenericCreate((TaskFunction_t)function, name, (uint16_t)taskdef->Stacksize, NULL,
+            OS_GetFreeRtosPriority(taskdef->Priority), &handle, stack, NULL) != pdPASS) {
+        handle = NULL;
+    }
+    OS_RegisterStack(handle, taskdef->Stacksize);
+
+    return handle;
+}
+
+
+uint32_t OS_GetHeapFree(void) {
+    return os_heap_free;
+}
+
+
+/**
+ * @brief   converts a CMSIS priority to a FreeRTOS priority (as osThreadCreate() does)
+ *
+ * @param   priority:   CMSIS priority
+ *
+ * @return  FreeRTOS priority
+ */
+static UBaseType_t OS_GetFreeRtosPriority(OS_PRIORITY_e priority) {
+    UBaseType_t fpriority = tskIDLE_PRIORITY;
+
+    if (priority != OS_PRIORITY_ERROR) {
+        fpriority += (priority - OS_PRIORITY_IDLE);
+    }
+    return fpriority;
+}
+
+
 
 void OS_PostOSInit(void) {
 
@@ -118,7 +278,12 @@ void OS_PostOSInit(void) {
     NVIC_PostOsInit();
 
     os_boot = OS_BMS_INIT;
-    
+
+    /* kernel tasks, created by the scheduler start */
+    OS_RegisterStack(xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE);
+    OS_RegisterStack(xTimerGetTimerDaemonTaskHandle(), configTIMER_TASK_STACK_DEPTH);
+    os_heap_free = xPortGetFreeHeapSize();
+
 
     if(ret_val) {
 
@@ -127,7 +292,29 @@ void OS_PostOSInit(void) {
 }
 
 void OS_IdleTask(void) {
-    ;
+    uint32_t start = 0;
+    uint32_t tick = osKernelSysTick();
+
+    /* one stack per tick, the scan is preempted by every other task */
+    if (tick != os_stack_sample_tick) {
+        os_stack_sample_tick = tick;
+        OS_SampleStack();
+    }
+
+    /* no task is ready: the core sleeps until the next interrupt, at the latest
+       the tick. DWT->CYCCNT stops in the sleep, so the run time of the idle task
+       only holds its awake part and the sleep is measured with SysTick. With the
+       interrupts masked the core still wakes up on the first pending interrupt,
+       which is handled after the second reading, so the sleep does not contain
+       the run time of the interrupt. */
+    os_idle_sleeps++;
+    __disable_irq();
+    start = OS_GetSysTickCycles();
+    __DSB();
+    __WFI();
+    __ISB();
+    os_idle_sleep_cycles += OS_GetSysTickCycles() - start;
+    __enable_irq();
 }
 
 
@@ -203,3 +390,377 @@ void OS_TaskExit_Critical(void)
         taskEXIT_CRITICAL_FROM_ISR(0);      /*  Call exit critical function within ISR context (FreeRTOS-Interrupt) */
 
 }
+
+
+void OS_MarkKernelStart(void) {
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    os_kernelstart_cycles = OS_GetSysTickCycles();
+}
+
+
+void OS_WaitStartBarrier(OS_START_TASK_e task) {
+    if (os_start_barrier != NULL) {
+        while ((xEventGroupWaitBits(os_start_barrier, OS_EVENT_SYSTEM_RUNNING, pdFALSE, pdTRUE, portMAX_DELAY) &
+                OS_EVENT_SYSTEM_RUNNING) == 0) {
+            ;
+        }
+    } else {
+        /* event group could not be allocated: poll, but give the CPU to the lower priority tasks */
+        while (os_boot != OS_SYSTEM_RUNNING) {
+            osDelay(1);
+        }
+    }
+
+    if (task < OS_START_NR_OF_TASKS) {
+        os_start_timing.task[task].released_us = OS_GetStartTimeUs();
+    }
+}
+
+
+void OS_ReleaseStartBarrier(void) {
+    os_start_timing.barrier_us = OS_GetStartTimeUs();
+    os_boot = OS_SYSTEM_RUNNING;
+
+    if (os_start_barrier != NULL) {
+        xEventGroupSetBits(os_start_barrier, OS_EVENT_SYSTEM_RUNNING);
+    }
+}
+
+
+void OS_MarkFirstCycle(OS_START_TASK_e task) {
+    if (task < OS_START_NR_OF_TASKS) {
+        os_start_timing.task[task].first_cycle_us = OS_GetStartTimeUs();
+    }
+}
+
+
+void OS_GetStartTiming(OS_START_TIMING_s *timing) {
+    OS_TaskEnter_Critical();
+    *timing = os_start_timing;
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   returns the time since the start of the scheduler
+ *
+ * @return  time in us
+ */
+static uint32_t OS_GetStartTimeUs(void) {
+    return (OS_GetSysTickCycles() - os_kernelstart_cycles) / (SystemCoreClock / 1000000);
+}
+
+
+/**
+ * @brief   returns the time in CPU cycles from the HAL tick and the SysTick counter
+ *
+ * Unlike DWT->CYCCNT, SysTick and with it the HAL tick (HAL_IncTick() in
+ * SysTick_Handler()) keep counting while the core sleeps in OS_IdleTask().
+ * Wraps after 2^32 cycles, the callers work on differences.
+ *
+ * @return  cycles
+ */
+static uint32_t OS_GetSysTickCycles(void) {
+    uint32_t reload = SysTick->LOAD + 1;
+    uint32_t primask = __get_PRIMASK();
+    uint32_t tick = 0;
+    uint32_t val = 0;
+
+    __disable_irq();
+    tick = HAL_GetTick();
+    val = SysTick->VAL;
+    if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0) {
+        /* the counter has wrapped, HAL_IncTick() has not run yet */
+        tick++;
+        val = SysTick->VAL;
+    }
+    __set_PRIMASK(primask);
+
+    return (tick * reload) + (reload - 1 - val);
+}
+
+
+void OS_ConfigureRunTimeCounter(void) {
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+
+void OS_TraceSwitchedIn(uint32_t tasknumber) {
+    os_load_current = (tasknumber < OS_LOAD_MAX_TASKS) ? tasknumber : 0;
+    os_load_switchin_cycles = DWT->CYCCNT;
+}
+
+
+void OS_TraceSwitchedOut(void) {
+    OS_LOAD_COUNTER_s *counter = &os_load_counter[os_load_current];
+    uint32_t slice = DWT->CYCCNT - os_load_switchin_cycles;
+
+    counter->cycles += slice;
+    if (slice > counter->slice_max) {
+        counter->slice_max = slice;
+    }
+}
+
+
+void OS_MarkActivation(void) {
+    OS_LOAD_COUNTER_s *counter;
+    uint32_t executed;
+
+    taskENTER_CRITICAL();
+    if (os_load_current != 0) {
+        counter = &os_load_counter[os_load_current];
+        /* cycles of the finished slices plus the running slice */
+        executed = counter->cycles + (DWT->CYCCNT - os_load_switchin_cycles);
+
+        if ((counter->mark_valid == TRUE) && ((executed - counter->mark) > counter->activation_max)) {
+            counter->activation_max = executed - counter->mark;
+        }
+        counter->mark = executed;
+        counter->mark_valid = TRUE;
+    }
+    taskEXIT_CRITICAL();
+}
+
+
+uint8_t OS_UpdateLoad(uint32_t timestamp) {
+    TaskHandle_t idle = xTaskGetIdleTaskHandle();
+    OS_LOAD_COUNTER_s *counter = NULL;
+    uint32_t cycles_per_us = SystemCoreClock / 1000000;
+    uint64_t window = 0;
+    uint32_t cycles = 0;
+    uint32_t delta = 0;
+    uint32_t sleeps = 0;
+    uint32_t sleep_cycles = 0;
+    uint32_t nr_of_tasks = 0;
+    uint8_t nr_of_entries = os_nr_of_task_entries;
+    uint8_t i = 0;
+
+    if ((os_load_started == TRUE) && ((timestamp - os_load_timestamp_last) < OS_LOAD_WINDOW_MS)) {
+        return FALSE;
+    }
+    window = (uint64_t)(timestamp - os_load_timestamp_last) * (SystemCoreClock / 1000);
+    os_load_timestamp_last = timestamp;
+    sleeps = os_idle_sleeps - os_idle_sleeps_last;
+    os_idle_sleeps_last += sleeps;
+    sleep_cycles = os_idle_sleep_cycles - os_idle_sleep_cycles_last;
+    os_idle_sleep_cycles_last += sleep_cycles;
+
+    /* tasks that could not be registered (more than OS_LOAD_MAX_TASKS) are not in the report */
+    nr_of_tasks = uxTaskGetNumberOfTasks();
+    if (nr_of_tasks > nr_of_entries) {
+        /* no report, the caller sees the overflow with OS_GetLoadTasksOverflow() */
+        os_load_tasks_overflow = nr_of_tasks;
+        os_load_started = TRUE;
+        return TRUE;
+    }
+    os_load_tasks_overflow = 0;
+
+    if ((os_load_started == FALSE) || (window == 0)) {
+        /* first call: reference of the cycle counters only */
+        for (i = 0; i < nr_of_entries; i++) {
+            counter = &os_load_counter[os_task_entry[i].number];
+            counter->cycles_last = counter->cycles;
+        }
+        os_load_started = TRUE;
+        return FALSE;
+    }
+
+    os_load_new.timestamp = timestamp;
+    os_load_new.window_us = (uint32_t)(window / cycles_per_us);
+    os_load_new.sleep_ppm = (uint32_t)(((uint64_t)sleep_cycles * 1000000) / window);
+    if (os_load_new.sleep_ppm > 1000000) {
+        os_load_new.sleep_ppm = 1000000;
+    }
+    os_load_new.idle_ppm = 0;
+    os_load_new.sleeps = sleeps;
+    os_load_new.nr_of_tasks = 0;
+
+    for (i = 0; i < nr_of_entries; i++) {
+        /* accumulated by OS_TraceSwitchedOut(), the running slice of the caller counts in the next window */
+        counter = &os_load_counter[os_task_entry[i].number];
+        cycles = counter->cycles;
+        delta = cycles - counter->cycles_last;
+        counter->cycles_last = cycles;
+
+        os_load_new.task[i].name = os_task_entry[i].name;
+        os_load_new.task[i].load_ppm = (uint32_t)(((uint64_t)delta * 1000000) / window);
+        os_load_new.task[i].activation_max_us = counter->activation_max / cycles_per_us;
+        os_load_new.task[i].slice_max_us = counter->slice_max / cycles_per_us;
+
+        if (os_task_entry[i].handle == idle) {
+            /* the cycle counter stops in the sleep, the idle task runs awake and sleeps */
+            os_load_new.task[i].load_ppm += os_load_new.sleep_ppm;
+            os_load_new.idle_ppm = os_load_new.task[i].load_ppm;
+        }
+        os_load_new.nr_of_tasks++;
+    }
+
+    if (os_load_new.idle_ppm > 1000000) {
+        os_load_new.idle_ppm = 1000000;
+    }
+    os_load_new.utilization_ppm = 1000000 - os_load_new.idle_ppm;
+    if (os_load_new.utilization_ppm > os_load_new.utilization_max_ppm) {
+        os_load_new.utilization_max_ppm = os_load_new.utilization_ppm;
+    }
+    for (i = os_load_new.nr_of_tasks; i < OS_LOAD_MAX_TASKS; i++) {
+        os_load_new.task[i].name = NULL;
+    }
+
+    OS_TaskEnter_Critical();
+    os_load = os_load_new;
+    OS_TaskExit_Critical();
+
+    OS_UpdateStack(timestamp);
+
+    return TRUE;
+}
+
+
+void OS_GetLoad(OS_LOAD_s *load) {
+    OS_TaskEnter_Critical();
+    *load = os_load;
+    OS_TaskExit_Critical();
+}
+
+
+uint32_t OS_GetUtilization(void) {
+    return os_load.utilization_ppm;
+}
+
+
+uint32_t OS_GetLoadTasksOverflow(void) {
+    return os_load_tasks_overflow;
+}
+
+
+uint32_t OS_GetReleaseLatency(uint32_t due_tick) {
+    uint32_t tick = 0;
+    uint32_t cycles = 0;
+
+    taskENTER_CRITICAL();
+    tick = osKernelSysTick();
+    cycles = DWT->CYCCNT - os_tick_cycles;
+    taskEXIT_CRITICAL();
+
+    return ((tick - due_tick) * portTICK_PERIOD_MS * 1000) + (cycles / (SystemCoreClock / 1000000));
+}
+
+
+void OS_RegisterStack(xTaskHandle handle, uint32_t size_words) {
+    OS_TASK_ENTRY_s *entry = NULL;
+    uint32_t number = 0;
+
+    if (handle == NULL) {
+        return;
+    }
+    /* os_load_counter[] is indexed by the TCB number, later tasks can not be supervised */
+    number = uxTaskGetTaskNumber(handle);
+    if ((os_nr_of_task_entries < OS_LOAD_MAX_TASKS) && (number != 0) && (number < OS_LOAD_MAX_TASKS)) {
+        entry = &os_task_entry[os_nr_of_task_entries];
+        entry->handle = handle;
+        entry->name = pcTaskGetTaskName(handle);
+        entry->number = number;
+        entry->size_words = size_words;
+        entry->free_min_words = uxTaskGetStackHighWaterMark(handle);
+        os_nr_of_task_entries++;    // entry is complete before OS_SampleStack() and OS_UpdateLoad() see it
+    }
+}
+
+
+void OS_GetStackReport(OS_STACK_s *stack) {
+    OS_TaskEnter_Critical();
+    *stack = os_stack;
+    OS_TaskExit_Critical();
+}
+
+
+uint32_t OS_GetStackFreeMin(void) {
+    return os_stack.free_min_words;
+}
+
+
+/**
+ * @brief   samples the stack high-water mark of the next registered task
+ *
+ * Called by OS_IdleTask() once per tick, so every task is sampled at least every
+ * OS_LOAD_MAX_TASKS ticks while the CPU is not saturated. uxTaskGetStackHighWaterMark()
+ * scans the unused part of one stack without suspending the scheduler.
+ *
+ * @return  void
+ */
+static void OS_SampleStack(void) {
+    OS_TASK_ENTRY_s *entry = NULL;
+
+    if (os_nr_of_task_entries == 0) {
+        return;
+    }
+    if (os_stack_sample_index >= os_nr_of_task_entries) {
+        os_stack_sample_index = 0;
+    }
+    entry = &os_task_entry[os_stack_sample_index];
+    entry->free_min_words = uxTaskGetStackHighWaterMark(entry->handle);
+    os_stack_sample_index++;
+}
+
+
+/**
+ * @brief   computes the stack report from the high-water marks sampled by OS_SampleStack()
+ *
+ * The recommended size is the observed peak plus OS_STACK_MARGIN_PERCENT, rounded
+ * up to OS_STACK_GRANULARITY_WORDS and not below configMINIMAL_STACK_SIZE.
+ *
+ * @param   timestamp:      time of the report in ms
+ *
+ * @return  void
+ */
+static void OS_UpdateStack(uint32_t timestamp) {
+    OS_STACK_TASK_s *entry;
+    uint32_t used = 0;
+    uint8_t nr_of_entries = os_nr_of_task_entries;
+    uint8_t i = 0;
+
+    os_stack_new.timestamp = timestamp;
+    os_stack_new.free_min_words = UINT32_MAX;
+    os_stack_new.recoverable_words = 0;
+    os_stack_new.nr_of_tasks = 0;
+
+    for (i = 0; i < nr_of_entries; i++) {
+        entry = &os_stack_new.task[i];
+        entry->name = os_task_entry[i].name;
+        entry->free_min_words = os_task_entry[i].free_min_words;
+        entry->size_words = os_task_entry[i].size_words;
+        entry->recommended_words = 0;
+
+        if (entry->size_words > entry->free_min_words) {
+            used = entry->size_words - entry->free_min_words;
+            entry->recommended_words = used + ((used * OS_STACK_MARGIN_PERCENT) / 100);
+            entry->recommended_words = ((entry->recommended_words + OS_STACK_GRANULARITY_WORDS - 1) /
+                                        OS_STACK_GRANULARITY_WORDS) * OS_STACK_GRANULARITY_WORDS;
+            if (entry->recommended_words < configMINIMAL_STACK_SIZE) {
+                entry->recommended_words = configMINIMAL_STACK_SIZE;
+            }
+            if (entry->size_words > entry->recommended_words) {
+                os_stack_new.recoverable_words += entry->size_words - entry->recommended_words;
+            }
+        }
+
+        if (entry->free_min_words < os_stack_new.free_min_words) {
+            os_stack_new.free_min_words = entry->free_min_words;
+        }
+        os_stack_new.nr_of_tasks++;
+    }
+
+    for (i = os_stack_new.nr_of_tasks; i < OS_LOAD_MAX_TASKS; i++) {
+        os_stack_new.task[i].name = NULL;
+    }
+
+    OS_TaskEnter_Critical();
+    os_stack = os_stack_new;
+    OS_TaskExit_Critical();
+}
@@ -56,6 +56,42 @@
  */
 #define OS_APPL_NUM_OF_EVENTS   0
 
+/**
+ * bit of the start barrier event group, set when the post-OS initialization is done
+ */
+#define OS_EVENT_SYSTEM_RUNNING (1 << 0)
+
+/**
+ * window of the CPU load report (OS_UpdateLoad()).
+ * The run-time counter is the 32bit DWT cycle counter, so the window must be
+ * shorter than one counter overflow (about 23s at 180MHz).
+ */
+#define OS_LOAD_WINDOW_MS       (1000)
+
+/**
+ * maximum number of tasks in the CPU load report, larger than the number of
+ * created tasks (including the idle and the timer task)
+ */
+#define OS_LOAD_MAX_TASKS       (16)
+
+/**
+ * time-triggered executive: a single 1ms task (ENG_TSK_Executive()) runs the cyclic
+ * functions of the engine and application tasks from the schedule table
+ * eng_executive_table[] with the phases and cycle times of their task definitions.
+ * If FALSE, every cyclic function runs in its own task.
+ */
+#define OS_TIME_TRIGGERED_EXECUTIVE     FALSE
+
+/**
+ * margin added to the observed stack peak for the recommended stack size
+ */
+#define OS_STACK_MARGIN_PERCENT     (25)
+
+/**
+ * recommended stack sizes are rounded up to a multiple of this number of words
+ */
+#define OS_STACK_GRANULARITY_WORDS  (8)
+
 /**
  * typedef for thread priority
  */
@@ -130,6 +166,86 @@ typedef struct {
     uint32_t Stacksize;      /*!<  Defines the size, in words, of the stack allocated to the idle task.  */
 } BMS_Task_Definition_s;
 
+/**
+ * tasks that wait at the start barrier, index of OS_START_TIMING_s.task[]
+ */
+typedef enum {
+    OS_START_ENG_CYCLIC_1MS         = 0,
+    OS_START_ENG_CYCLIC_10MS        = 1,
+    OS_START_ENG_CYCLIC_100MS       = 2,
+    OS_START_ENG_EVENTHANDLER       = 3,
+    OS_START_ENG_DIAGNOSIS          = 4,
+    OS_START_APPL_CYCLIC_1MS        = 5,
+    OS_START_APPL_CYCLIC_10MS       = 6,
+    OS_START_APPL_CYCLIC_100MS      = 7,
+    OS_START_NR_OF_TASKS            = 8,
+} OS_START_TASK_e;
+
+/**
+ * start up times of a task, in us since the start of the scheduler
+ */
+typedef struct {
+    uint32_t released_us;       /*!< task has passed the start barrier       */
+    uint32_t first_cycle_us;    /*!< first cyclic execution (after the phase) */
+} OS_START_TASK_TIMING_s;
+
+/**
+ * start up times of the system, in us since the start of the scheduler, 0 if not reached yet
+ */
+typedef struct {
+    uint32_t barrier_us;                                /*!< start barrier released by the engine task  */
+    OS_START_TASK_TIMING_s task[OS_START_NR_OF_TASKS];  /*!< times of the tasks                         */
+} OS_START_TIMING_s;
+
+/**
+ * CPU load of a task
+ */
+typedef struct {
+    const char *name;               /*!< task name, NULL if the entry is unused                         */
+    uint32_t load_ppm;              /*!< share of the CPU time in the last window in ppm                */
+    uint32_t activation_max_us;     /*!< longest activation (cycle of the task loop) since start in us,
+                                         only for tasks that call OS_MarkActivation(), 0 otherwise      */
+    uint32_t slice_max_us;          /*!< longest uninterrupted execution since start in us              */
+} OS_LOAD_TASK_s;
+
+/**
+ * CPU load report, updated every OS_LOAD_WINDOW_MS
+ */
+typedef struct {
+    uint32_t timestamp;                     /*!< time of the report in ms, 0 if no report yet       */
+    uint32_t window_us;                     /*!< measured length of the window in us                */
+    uint32_t idle_ppm;                      /*!< share of the idle task in ppm, including sleep_ppm */
+    uint32_t sleep_ppm;                     /*!< share of the core sleeping in OS_IdleTask() in ppm,
+                                                 measured with SysTick                          */
+    uint32_t sleeps;                        /*!< number of sleeps of the idle task in the window    */
+    uint32_t utilization_ppm;               /*!< CPU utilization (1000000 - idle_ppm)               */
+    uint32_t utilization_max_ppm;           /*!< highest utilization since start                    */
+    uint8_t nr_of_tasks;                    /*!< number of valid entries in task[]                  */
+    OS_LOAD_TASK_s task[OS_LOAD_MAX_TASKS];  /*!< per task load                                      */
+} OS_LOAD_s;
+
+/**
+ * stack usage of a task, sizes in words (StackType_t)
+ */
+typedef struct {
+    const char *name;               /*!< task name, NULL if the entry is unused                         */
+    uint32_t size_words;            /*!< configured stack size (OS_RegisterStack())                     */
+    uint32_t free_min_words;        /*!< high-water mark, smallest free stack since start, sampled by
+                                         the idle task (one task per tick)                              */
+    uint32_t recommended_words;     /*!< peak plus OS_STACK_MARGIN_PERCENT, 0 if size is unknown        */
+} OS_STACK_TASK_s;
+
+/**
+ * stack report, updated with the CPU load report
+ */
+typedef struct {
+    uint32_t timestamp;                     /*!< time of the report in ms, 0 if no report yet               */
+    uint32_t free_min_words;                /*!< smallest high-water mark of all tasks                      */
+    uint32_t recoverable_words;             /*!< sum of (size - recommended) of the oversized stacks        */
+    uint8_t nr_of_tasks;                    /*!< number of valid entries in task[]                          */
+    OS_STACK_TASK_s task[OS_LOAD_MAX_TASKS]; /*!< per task stack usage                                      */
+} OS_STACK_s;
+
 /*================== Constant and Variable Definitions ====================*/
 extern volatile OS_BOOT_STATE_e os_boot;
 extern volatile OS_BOOT_STATE_e os_safety_state;
@@ -157,6 +273,10 @@ extern void OS_TaskInit();
 
 /**
  * @brief   OS_IdleTask, called by vApplicationIdleHook()
+ *
+ * @details Puts the core to sleep (WFI) until the next interrupt. The sleep time
+ *          is measured with SysTick and added to the idle time of the CPU load report.
+ *
  * @return  void
  */
 extern void OS_IdleTask(void);
@@ -168,6 +288,57 @@ extern void OS_IdleTask(void);
  */
 extern void vApplicationIdleHook(void);
 
+/**
+ * @brief   Hook function of the stack overflow check (configCHECK_FOR_STACK_OVERFLOW)
+ *
+ * Called by the scheduler when the switched out task has overflowed its stack.
+ * Only a crash dump (DIAG_FAULT_STACKOVERFLOW) with the task number is written, then
+ * the MCU is reset by DIAG_CrashReset(). DIAG_Init() records DIAG_CH_STACK_OVERFLOW
+ * from the preserved crash dump after the reset.
+ * The function does not return.
+ *
+ * @param   xTask:          handle of the task
+ * @param   pcTaskName:     name of the task
+ *
+ * @return  void
+ */
+extern void vApplicationStackOverflowHook(xTaskHandle xTask, char *pcTaskName);
+
+/**
+ * @brief   Hook function of a failed allocation from the FreeRTOS heap (configUSE_MALLOC_FAILED_HOOK)
+ *
+ * The heap only holds the kernel objects created at start up, so a failed
+ * allocation means configTOTAL_HEAP_SIZE is too small. Handled like a failed configASSERT().
+ *
+ * @return  void
+ */
+extern void vApplicationMallocFailedHook(void);
+
+/**
+ * @brief   creates a task with a statically allocated stack
+ *
+ * Only the task control block is allocated from the FreeRTOS heap. The stack
+ * size is registered for the stack report (OS_RegisterStack()).
+ *
+ * @param   name:       task name
+ * @param   function:   task function
+ * @param   taskdef:    priority and stack size (in words) of the task
+ * @param   stack:      stack of the task, at least taskdef->Stacksize words (MEM_OS_STATIC)
+ *
+ * @return  task handle, NULL if the task could not be created
+ */
+extern xTaskHandle OS_CreateTask(const char *name, os_pthread function, BMS_Task_Definition_s *taskdef, StackType_t *stack);
+
+/**
+ * @brief   returns the free FreeRTOS heap after the creation of the kernel objects
+ *
+ * Recorded by OS_PostOSInit(), i.e. after the scheduler start has created the
+ * idle and the timer task. Margin of configTOTAL_HEAP_SIZE.
+ *
+ * @return  free heap in bytes
+ */
+extern uint32_t OS_GetHeapFree(void);
+
 /**
  * @brief   reads non-volatile memory and initializes the sys module
  *
@@ -216,6 +387,176 @@ extern void OS_TaskExit_Critical(void);
  * @return  void
  */
 extern void OS_TimerTrigger(void);
+
+/**
+ * @brief   stores the start of the scheduler as reference of the start up times
+ *
+ * Called by main() right before osKernelStart().
+ *
+ * @return  void
+ */
+extern void OS_MarkKernelStart(void);
+
+/**
+ * @brief   blocks the calling task until the post-OS initialization is done
+ *
+ * Replaces the spin-wait on os_boot, so lower priority tasks do not use CPU time and
+ * higher priority tasks cannot starve the engine task before OS_ReleaseStartBarrier().
+ *
+ * @param   task:   calling task
+ *
+ * @return  void
+ */
+extern void OS_WaitStartBarrier(OS_START_TASK_e task);
+
+/**
+ * @brief   sets os_boot to OS_SYSTEM_RUNNING and releases all tasks waiting at the start barrier
+ *
+ * @return  void
+ */
+extern void OS_ReleaseStartBarrier(void);
+
+/**
+ * @brief   records the first cyclic execution of a task (call after the phase delay)
+ *
+ * @param   task:   calling task
+ *
+ * @return  void
+ */
+extern void OS_MarkFirstCycle(OS_START_TASK_e task);
+
+/**
+ * @brief   copies the start up times of the system
+ *
+ * @param   timing:     destination
+ *
+ * @return  void
+ */
+extern void OS_GetStartTiming(OS_START_TIMING_s *timing);
+
+/**
+ * @brief   enables the DWT cycle counter as FreeRTOS run-time counter
+ *
+ * Called by the scheduler start (portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()). The
+ * counter stops while the core sleeps in OS_IdleTask(), the sleep is measured
+ * with SysTick instead.
+ *
+ * @return  void
+ */
+extern void OS_ConfigureRunTimeCounter(void);
+
+/**
+ * @brief   trace hook of the scheduler, a task has been switched in (traceTASK_SWITCHED_IN())
+ *
+ * @param   tasknumber:     TCB number of the task (TaskStatus_t.xTaskNumber)
+ *
+ * @return  void
+ */
+extern void OS_TraceSwitchedIn(uint32_t tasknumber);
+
+/**
+ * @brief   trace hook of the scheduler, the running task is switched out (traceTASK_SWITCHED_OUT())
+ *
+ * Accumulates the cycles of the time slice to the task and updates the longest slice.
+ *
+ * @return  void
+ */
+extern void OS_TraceSwitchedOut(void);
+
+/**
+ * @brief   marks the end of an activation of the calling task
+ *
+ * Called once per cycle of the task loop, right before the task blocks. The
+ * activation time is the CPU time of the task since the previous call, i.e.
+ * without the time of preempting tasks.
+ *
+ * @return  void
+ */
+extern void OS_MarkActivation(void);
+
+/**
+ * @brief   computes the CPU load and the stack report when OS_LOAD_WINDOW_MS has elapsed
+ *
+ * Called by DIAG_SysMon(). The load is taken from the cycle counters of the tasks
+ * registered with OS_RegisterStack(), the stack report from the high-water marks the
+ * idle task samples with uxTaskGetStackHighWaterMark(), one task per tick. Neither
+ * suspends the scheduler nor scans a stack in the calling task.
+ *
+ * @param   timestamp:  current time in ms
+ *
+ * @return  TRUE if a window has elapsed: a new report is available, or no report
+ *          could be made because not all tasks are registered (more than OS_LOAD_MAX_TASKS)
+ *          (OS_GetLoadTasksOverflow() != 0); FALSE otherwise
+ */
+extern uint8_t OS_UpdateLoad(uint32_t timestamp);
+
+/**
+ * @brief   copies the last CPU load report
+ *
+ * @param   load:   destination
+ *
+ * @return  void
+ */
+extern void OS_GetLoad(OS_LOAD_s *load);
+
+/**
+ * @brief   returns the CPU utilization of the last window
+ *
+ * @return  utilization in ppm
+ */
+extern uint32_t OS_GetUtilization(void);
+
+/**
+ * @brief   returns the number of tasks if they did not fit into the last load report
+ *
+ * @return  number of tasks if not all of them are registered (more than OS_LOAD_MAX_TASKS), 0 otherwise
+ */
+extern uint32_t OS_GetLoadTasksOverflow(void);
+
+/**
+ * @brief   Hook function of the tick interrupt (configUSE_TICK_HOOK), timestamps
+ *          the tick with the DWT cycle counter
+ *
+ * @return  void
+ */
+extern void vApplicationTickHook(void);
+
+/**
+ * @brief   returns the time from a tick to now, e.g. the delay from the tick that
+ *          made a task ready until it runs
+ *
+ * @param   due_tick:   tick count (osKernelSysTick()) of the tick
+ *
+ * @return  time in us, resolution 1us within the current tick
+ */
+extern uint32_t OS_GetReleaseLatency(uint32_t due_tick);
+
+/**
+ * @brief   registers a task with its stack size for the load and the stack report
+ *
+ * @param   handle:         task handle
+ * @param   size_words:     stack size in words, as passed to osThreadDef()
+ *
+ * @return  void
+ */
+extern void OS_RegisterStack(xTaskHandle handle, uint32_t size_words);
+
+/**
+ * @brief   copies the last stack report
+ *
+ * @param   stack:  destination
+ *
+ * @return  void
+ */
+extern void OS_GetStackReport(OS_STACK_s *stack);
+
+/**
+ * @brief   returns the smallest stack high-water mark of the last report
+ *
+ * @return  free stack in words
+ */
+extern uint32_t OS_GetStackFreeMin(void);
+
 /*================== Function Implementations =============================*/
 
 #endif /* OS_H_ */
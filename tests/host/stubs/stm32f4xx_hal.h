@@ -0,0 +1,242 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    stm32f4xx_hal.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  none
+ *
+ * @brief   Host replacement of the HAL header for the host tests
+ *
+ * Emulates the Cortex-M4 SIMD intrinsics used by the application (ARMv7-M
+ * Architecture Reference Manual, USUB16/SSUB16/SEL/SMLAD) including the GE
+ * flags, so the DSP code paths run on the host. The DWT cycle counter is a
+ * variable that the tests define and advance themselves. Every access to DWT
+ * calls host_dwt_hook (if set), which lets a test model the hardware that runs
+ * while the code under test polls the cycle counter.
+ *
+ * The ADC, GPIO and NVIC declarations cover the fast trip path; the tests that
+ * use them define the HAL functions.
+ */
+
+#ifndef STM32F4XX_HAL_H_
+#define STM32F4XX_HAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * GE[3:0] flags of the APSR, set by __USUB16()/__SSUB16(), used by __SEL()
+ */
+static uint32_t host_apsr_ge = 0;
+
+static inline uint32_t __USUB16(uint32_t a, uint32_t b) {
+    int32_t lo = (int32_t)(a & 0xFFFFU) - (int32_t)(b & 0xFFFFU);
+    int32_t hi = (int32_t)(a >> 16) - (int32_t)(b >> 16);
+
+    host_apsr_ge = ((lo >= 0) ? 0x3U : 0) | ((hi >= 0) ? 0xCU : 0);
+    return ((uint32_t)lo & 0xFFFFU) | ((uint32_t)hi << 16);
+}
+
+static inline uint32_t __SSUB16(uint32_t a, uint32_t b) {
+    int32_t lo = (int32_t)(int16_t)(a & 0xFFFFU) - (int32_t)(int16_t)(b & 0xFFFFU);
+    int32_t hi = (int32_t)(int16_t)(a >> 16) - (int32_t)(int16_t)(b >> 16);
+
+    host_apsr_ge = ((lo >= 0) ? 0x3U : 0) | ((hi >= 0) ? 0xCU : 0);
+    return ((uint32_t)lo & 0xFFFFU) | ((uint32_t)hi << 16);
+}
+
+static inline uint32_t __SEL(uint32_t a, uint32_t b) {
+    uint32_t result = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < 4; i++) {
+        result |= (((host_apsr_ge >> i) & 1U) ? a : b) & (0xFFU << (i * 8));
+    }
+    return result;
+}
+
+static inline uint32_t __SMLAD(uint32_t x, uint32_t y, uint32_t acc) {
+    int32_t lo = (int32_t)(int16_t)(x & 0xFFFFU) * (int32_t)(int16_t)(y & 0xFFFFU);
+    int32_t hi = (int32_t)(int16_t)(x >> 16) * (int32_t)(int16_t)(y >> 16);
+
+    return acc + (uint32_t)lo + (uint32_t)hi;
+}
+
+/**
+ * registers of the DWT and the core debug block that the code under test uses
+ */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk          ((uint32_t)0x00000001)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1UL << 24)
+
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_coredebug;
+extern uint32_t SystemCoreClock;
+extern void (*host_dwt_hook)(void);
+
+static inline DWT_Type *HOST_DwtAccess(void) {
+    if (host_dwt_hook != 0) {
+        host_dwt_hook();
+    }
+    return &host_dwt;
+}
+
+#define DWT                             (HOST_DwtAccess())
+#define CoreDebug                       (&host_coredebug)
+
+static inline void __disable_irq(void) {
+}
+
+static inline void __enable_irq(void) {
+}
+
+/**
+ * NVIC, interrupt numbers of STM32F429
+ */
+typedef enum {
+    SysTick_IRQn        = -1,
+    ADC_IRQn            = 18,
+    TIM3_IRQn           = 29,
+    SPI2_IRQn           = 36,
+    USART2_IRQn         = 38,
+    USART3_IRQn         = 39,
+    DMA2_Stream2_IRQn   = 58,
+    DMA2_Stream3_IRQn   = 59,
+    SPI6_IRQn           = 86,
+} IRQn_Type;
+
+#define NVIC_PRIORITYGROUP_4            (0x00000003U)
+
+extern void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup);
+extern void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+extern void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+extern void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/**
+ * GPIO
+ */
+typedef struct {
+    volatile uint32_t BSRR;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef host_gpiod;
+
+#define GPIOD                           (&host_gpiod)
+#define GPIO_PIN_4                      ((uint16_t)0x0010)
+
+/**
+ * ADC registers and HAL types used by the fast trip path
+ */
+typedef struct {
+    volatile uint32_t SR;
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t HTR;
+    volatile uint32_t LTR;
+    volatile uint32_t DR;
+} ADC_TypeDef;
+
+#define ADC_SR_AWD                      ((uint32_t)0x00000001)
+#define ADC_CR1_AWDIE                   ((uint32_t)0x00000040)
+
+extern ADC_TypeDef host_adc[3];
+
+#define ADC1                            (&host_adc[0])
+#define ADC2                            (&host_adc[1])
+#define ADC3                            (&host_adc[2])
+
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR = 1,
+} HAL_StatusTypeDef;
+
+#define DISABLE                         (0U)
+#define ENABLE                          (1U)
+
+#define ADC_RESOLUTION_12B              (0U)
+#define ADC_DATAALIGN_RIGHT             (0U)
+#define ADC_EXTERNALTRIGCONVEDGE_NONE   (0U)
+#define ADC_SOFTWARE_START              (0x0F000001U)
+#define ADC_EOC_SINGLE_CONV             (1U)
+#define ADC_CLOCKPRESCALER_PCLK_DIV2    (0U)
+#define ADC_CHANNEL_10                  (10U)
+#define ADC_CHANNEL_11                  (11U)
+#define ADC_SAMPLETIME_15CYCLES         (1U)
+#define ADC_ANALOGWATCHDOG_SINGLE_REG   (0x00800200U)
+
+typedef struct {
+    uint32_t ClockPrescaler;
+    uint32_t Resolution;
+    uint32_t DataAlign;
+    uint32_t ScanConvMode;
+    uint32_t EOCSelection;
+    uint32_t ContinuousConvMode;
+    uint32_t NbrOfConversion;
+    uint32_t DiscontinuousConvMode;
+    uint32_t NbrOfDiscConversion;
+    uint32_t ExternalTrigConv;
+    uint32_t ExternalTrigConvEdge;
+    uint32_t DMAContinuousRequests;
+} ADC_InitTypeDef;
+
+typedef struct {
+    ADC_TypeDef *Instance;
+    ADC_InitTypeDef Init;
+} ADC_HandleTypeDef;
+
+typedef struct {
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+    uint32_t Offset;
+} ADC_ChannelConfTypeDef;
+
+typedef struct {
+    uint32_t WatchdogMode;
+    uint32_t HighThreshold;
+    uint32_t LowThreshold;
+    uint32_t Channel;
+    uint32_t ITMode;
+    uint32_t WatchdogNumber;
+} ADC_AnalogWDGConfTypeDef;
+
+#define __HAL_RCC_ADC2_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_ADC3_CLK_ENABLE()     do { } while (0)
+
+extern HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
+extern HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig);
+extern HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, ADC_AnalogWDGConfTypeDef *AnalogWDGConfig);
+extern HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
+
+#endif /* STM32F4XX_HAL_H_ */
@@ -0,0 +1,204 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    test_cellstat_gradient.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Detection time and noise immunity of the temperature gradient estimator
+ *
+ * Feeds cell temperatures, quantized to 1 degree Celsius like the measurement, every
+ * TEST_PERIOD_MS into CELLSTAT_Trigger():
+ * - a constant temperature on a quantization boundary with uniform noise of +/-0.5K must
+ *   not raise DIAG_CH_TEMP_GRADIENT_WARNING
+ * - a 3K/min ramp (heating at high load) must not raise the warning either
+ * - a 60K/min ramp must raise DIAG_CH_TEMP_GRADIENT_ALARM within TEST_ALARM_TARGET_MS
+ */
+
+/*================== Includes =============================================*/
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "general.h"
+#include "cellstat.h"
+
+#include "database.h"
+#include "diag.h"
+#include "latency.h"
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+#define TEST_PERIOD_MS          (200)
+#define TEST_NOISE_MS           (600000)
+#define TEST_ALARM_TARGET_MS    (10000)
+
+/*================== Constant and Variable Definitions ====================*/
+
+static DATA_BLOCK_CELLTEMPERATURE_s test_celltemperature;
+static DATA_BLOCK_CELLVOLTAGE_s test_cellvoltage;
+static uint32_t test_time = 0;
+static uint32_t test_seed = 0x2545F491;
+static uint8_t test_warning = FALSE;
+static uint8_t test_alarm = FALSE;
+
+/*================== Function Implementations =============================*/
+
+void DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e blockID) {
+    if (blockID == DATA_BLOCK_ID_CELLTEMPERATURE) {
+        memcpy(dataptrtoReceiver, &test_celltemperature, sizeof(test_celltemperature));
+    } else if (blockID == DATA_BLOCK_ID_CELLVOLTAGE) {
+        memcpy(dataptrtoReceiver, &test_cellvoltage, sizeof(test_cellvoltage));
+    }
+}
+
+void DB_WriteBlock(void *dataptrfromSender, DATA_BLOCK_ID_TYPE_e blockID) {
+}
+
+DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint8_t item_nr, void*  data) {
+    if (event == DIAG_EVENT_NOK) {
+        if (diag_ch_id == DIAG_CH_TEMP_GRADIENT_WARNING) {
+            test_warning = TRUE;
+        } else if (diag_ch_id == DIAG_CH_TEMP_GRADIENT_ALARM) {
+            test_alarm = TRUE;
+        }
+    }
+    return DIAG_HANDLER_RETURN_OK;
+}
+
+void LAT_MarkSample(DIAG_CH_ID_e id, uint32_t sample_timestamp) {
+}
+
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+/**
+ * @brief   uniform noise in -0.5..0.5
+ */
+static float TEST_Noise(void) {
+    test_seed ^= test_seed << 13;
+    test_seed ^= test_seed >> 17;
+    test_seed ^= test_seed << 5;
+    return (float)(test_seed & 0xFFFF) / 65536.0f - 0.5f;
+}
+
+/**
+ * @brief   writes one measurement of all sensors and runs the estimator
+ *
+ * @param   temperature:    true temperature in degree Celsius
+ * @param   noise:          TRUE to add TEST_Noise() per sensor
+ */
+static void TEST_Measure(float temperature, uint8_t noise) {
+    uint16_t i = 0;
+
+    test_time += TEST_PERIOD_MS;
+    for (i = 0; i < BS_NR_OF_TEMP_SENSORS; i++) {
+        test_celltemperature.temperature[i] = (int16_t)floorf(temperature + 0.5f + ((noise == TRUE) ? TEST_Noise() : 0.0f));
+    }
+    test_celltemperature.timestamp = test_time;
+    CELLSTAT_Trigger();
+}
+
+/**
+ * @brief   runs a ramp until the alarm or the end
+ *
+ * @param   start:      start temperature in degree Celsius
+ * @param   k_min:      slope in K/min
+ * @param   duration:   duration in ms
+ * @param   noise:      TRUE to add noise
+ *
+ * @return  time until the alarm in ms, 0 if none
+ */
+static uint32_t TEST_Ramp(float start, float k_min, uint32_t duration, uint8_t noise) {
+    uint32_t t = 0;
+    CELLSTAT_TEMPERATURE_STATS_s stats;
+    int32_t peak = 0;
+
+    test_warning = FALSE;
+    test_alarm = FALSE;
+    for (t = TEST_PERIOD_MS; t <= duration; t += TEST_PERIOD_MS) {
+        TEST_Measure(start + k_min * (float)t / 60000.0f, noise);
+        CELLSTAT_GetTemperatureStatistics(&stats);
+        if (stats.max_gradient > peak) {
+            peak = stats.max_gradient;
+        }
+        if (test_alarm == TRUE) {
+            break;
+        }
+    }
+    printf("test_cellstat_gradient: %.0fK/min%s, peak %d mK/min, warning %u, alarm after %u ms\n",
+           k_min, (noise == TRUE) ? " with noise" : "", peak, test_warning, (test_alarm == TRUE) ? t : 0);
+    return (test_alarm == TRUE) ? t : 0;
+}
+
+/**
+ * @brief   settles the estimator at a constant temperature
+ */
+static void TEST_Settle(float temperature) {
+    uint32_t t = 0;
+
+    for (t = 0; t < 60000; t += TEST_PERIOD_MS) {
+        TEST_Measure(temperature, FALSE);
+    }
+}
+
+int main(void) {
+    uint32_t failures = 0;
+    uint32_t alarm_time = 0;
+
+    /* first measurement initializes the estimator */
+    TEST_Measure(25.5f, FALSE);
+
+    (void)TEST_Ramp(25.5f, 0.0f, TEST_NOISE_MS, TRUE);
+    if (test_warning == TRUE) {
+        failures++;
+    }
+
+    TEST_Settle(25.0f);
+    (void)TEST_Ramp(25.0f, 3.0f, 300000, TRUE);
+    if (test_warning == TRUE) {
+        failures++;
+    }
+
+    TEST_Settle(40.0f);
+    alarm_time = TEST_Ramp(40.0f, 60.0f, 60000, FALSE);
+    if ((alarm_time == 0) || (alarm_time > TEST_ALARM_TARGET_MS)) {
+        failures++;
+    }
+
+    TEST_Settle(40.0f);
+    alarm_time = TEST_Ramp(40.0f, 60.0f, 60000, TRUE);
+    if ((alarm_time == 0) || (alarm_time > TEST_ALARM_TARGET_MS)) {
+        failures++;
+    }
+
+    printf("test_cellstat_gradient: %u failures\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    test_coulomb.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Integration and plausibility check of the coulomb counting
+ *
+ * A current and power ramp with a sign change is sampled at irregular timestamps and the
+ * counters of COULOMB_GetCounters() are compared with the analytic integral (the trapezoidal
+ * rule is exact for a ramp). Then constant current is fed with sensor counters that are
+ * first exact and then have a gain error of TEST_GAIN_ERROR, and the reports to
+ * DIAG_CH_COULOMB_PLAUSIBILITY are counted.
+ */
+
+/*================== Includes =============================================*/
+#include <stdio.h>
+#include <string.h>
+
+#include "general.h"
+#include "coulomb.h"
+
+#include "database.h"
+#include "diag.h"
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+#define TEST_RAMP_START_MS      (1000)  /* timestamp 0 marks a block that was never written */
+#define TEST_RAMP_END_MS        (1000)
+#define TEST_CONSTANT_START_MS  (3000)
+#define TEST_CURRENT_MA         (3600.0f)
+#define TEST_POWER_W            (10.0f)
+#define TEST_SAMPLE_MS          (100)
+#define TEST_COUNTER_MS         (1000)
+#define TEST_WINDOWS            (3)
+#define TEST_GAIN_ERROR         (1.1f)
+
+/*================== Constant and Variable Definitions ====================*/
+
+static DATA_BLOCK_CURRENT_s test_current;
+static uint32_t test_diag_ok = 0;
+static uint32_t test_diag_nok = 0;
+
+/**
+ * irregular sample times of the ramp relative to TEST_RAMP_START_MS, the sign of the current changes at 750ms
+ */
+static const uint32_t test_ramp_times[] = {
+    0, 1, 7, 10, 53, 100, 101, 250, 251, 333, 500, 749, 750, 751, 752, 900, 999, TEST_RAMP_END_MS,
+};
+
+/*================== Function Implementations =============================*/
+
+void DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e blockID) {
+    if (blockID == DATA_BLOCK_ID_CURRENT) {
+        memcpy(dataptrtoReceiver, &test_current, sizeof(test_current));
+    }
+}
+
+void DB_WriteBlock(void *dataptrfromSender, DATA_BLOCK_ID_TYPE_e blockID) {
+}
+
+DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint8_t item_nr, void*  data) {
+    if (diag_ch_id == DIAG_CH_COULOMB_PLAUSIBILITY) {
+        if (event == DIAG_EVENT_OK) {
+            test_diag_ok++;
+        } else if (event == DIAG_EVENT_NOK) {
+            test_diag_nok++;
+        }
+    }
+    return DIAG_HANDLER_RETURN_OK;
+}
+
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+/**
+ * @brief   ramp I = 1500mA - 2mA/ms * t and P = 3W - 4mW/ms * t from 0 to TEST_RAMP_END_MS
+ *
+ * @return  number of failures
+ */
+static uint32_t TEST_Ramp(void) {
+    COULOMB_COUNTERS_s counters;
+    uint32_t t = 0;
+    uint32_t i = 0;
+    uint32_t failures = 0;
+    /* integral of the ramps from 0 to 1000ms in mA*ms and mW*ms */
+    const int64_t charge_expected = 1500LL * TEST_RAMP_END_MS - TEST_RAMP_END_MS * TEST_RAMP_END_MS;
+    const int64_t energy_expected = 3000LL * TEST_RAMP_END_MS - 2LL * TEST_RAMP_END_MS * TEST_RAMP_END_MS;
+
+    for (i = 0; i < sizeof(test_ramp_times) / sizeof(test_ramp_times[0]); i++) {
+        t = test_ramp_times[i];
+        test_current.current = 1500.0f - 2.0f * (float)t;
+        test_current.power = 3.0f - 0.004f * (float)t;
+        test_current.timestamp = TEST_RAMP_START_MS + t;
+        COULOMB_Trigger();
+        /* called again without a new sample, must not integrate twice */
+        COULOMB_Trigger();
+    }
+
+    COULOMB_GetCounters(&counters);
+    if ((counters.charge_uAs != charge_expected) || (counters.energy_uJ != energy_expected)) {
+        failures++;
+    }
+    printf("test_coulomb: ramp charge %lld uAs (expected %lld), energy %lld uJ (expected %lld)\n",
+           (long long)counters.charge_uAs, (long long)charge_expected,
+           (long long)counters.energy_uJ, (long long)energy_expected);
+    return failures;
+}
+
+/**
+ * @brief   constant current and power for TEST_WINDOWS plausibility windows
+ *
+ * @param   t:      timestamp of the first sample, updated to the timestamp after the last sample
+ * @param   gain:   gain of the sensor counters
+ */
+static void TEST_Constant(uint32_t *t, float gain) {
+    uint32_t end = *t + TEST_WINDOWS * COULOMB_PLAUSIBILITY_WINDOW_MS;
+
+    for (; *t < end; *t += TEST_SAMPLE_MS) {
+        test_current.current = TEST_CURRENT_MA;
+        test_current.power = TEST_POWER_W;
+        test_current.timestamp = *t;
+        if ((*t % TEST_COUNTER_MS) == 0) {
+            test_current.current_counter += gain * TEST_CURRENT_MA * TEST_COUNTER_MS / 1000000.0f;
+            test_current.energy_counter += gain * TEST_POWER_W * TEST_COUNTER_MS / 3600000.0f;
+            test_current.timestamp_cc = *t;
+        }
+        COULOMB_Trigger();
+    }
+}
+
+/**
+ * @brief   exact sensor counters must be reported OK, counters with a gain error NOK
+ *
+ * @return  number of failures
+ */
+static uint32_t TEST_Plausibility(void) {
+    uint32_t t = TEST_CONSTANT_START_MS;
+    uint32_t failures = 0;
+
+    TEST_Constant(&t, 1.0f);
+    printf("test_coulomb: exact counters %u OK, %u NOK\n", test_diag_ok, test_diag_nok);
+    if ((test_diag_ok == 0) || (test_diag_nok != 0)) {
+        failures++;
+    }
+
+    test_diag_ok = 0;
+    test_diag_nok = 0;
+    TEST_Constant(&t, TEST_GAIN_ERROR);
+    printf("test_coulomb: counters with gain %.2f %u OK, %u NOK\n", TEST_GAIN_ERROR, test_diag_ok, test_diag_nok);
+    /* the window that spans the change of the gain may pass */
+    if ((test_diag_nok < TEST_WINDOWS - 1) || (test_diag_ok > 1)) {
+        failures++;
+    }
+    return failures;
+}
+
+int main(void) {
+    uint32_t failures = 0;
+
+    failures += TEST_Ramp();
+    failures += TEST_Plausibility();
+
+    printf("test_coulomb: %u failures\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
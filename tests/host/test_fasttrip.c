@@ -0,0 +1,260 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    test_fasttrip.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Self test and trip of the fast trip path with FTRIP_ENABLE set
+ *
+ * The boot order of main() is replayed: NVIC_PreOsInit() with nvic_interrupts[] and then
+ * FTRIP_Init(). The ADCs, their analog watchdogs and the NVIC are modeled in the DWT hook
+ * of the HAL stub, so they run while FTRIP_Init() polls the cycle counter: a conversion
+ * every TEST_CONVERSION_CYCLES, the watchdog flag outside the window and the call of
+ * FTRIP_IRQHandler() if the interrupt is enabled in the NVIC. Without NVIC_PreOsInit()
+ * the self test must fail, as the interrupt is only enabled by NVIC_PostOsInit() after
+ * the scheduler start.
+ */
+
+/*================== Includes =============================================*/
+#include <stdio.h>
+
+#include "general.h"
+#include "fasttrip.h"
+
+#include "diag.h"
+#include "evt.h"
+#include "mcu.h"
+#include "nvic.h"
+
+/*================== Macros and Definitions ===============================*/
+
+#define TEST_CYCLES_PER_ACCESS      (4)     /* core cycles between two accesses to DWT */
+#define TEST_CONVERSION_CYCLES      (108)   /* 15 + 12 ADCCLK at 42MHz, in 168MHz core cycles */
+#define TEST_IRQ_ENTRY_CYCLES       (12)
+#define TEST_TRIP_STEPS             (1000)
+#define TEST_NR_OF_IRQS             (100)
+
+/*================== Constant and Variable Definitions ====================*/
+
+DWT_Type host_dwt;
+CoreDebug_Type host_coredebug;
+uint32_t SystemCoreClock = 168000000;
+void (*host_dwt_hook)(void) = NULL;
+GPIO_TypeDef host_gpiod;
+ADC_TypeDef host_adc[3];
+
+static uint8_t test_irq_enabled[TEST_NR_OF_IRQS];
+static uint32_t test_irq_priority[TEST_NR_OF_IRQS];
+static uint8_t test_adc_running[3];
+static uint32_t test_adc_input[3];
+static uint32_t test_adc_conversion[3];
+static uint8_t test_in_isr = FALSE;
+
+/*================== Function Implementations =============================*/
+
+void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup) {
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority) {
+    if ((IRQn >= 0) && (IRQn < TEST_NR_OF_IRQS)) {
+        test_irq_priority[IRQn] = PreemptPriority;
+    }
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn) {
+    if ((IRQn >= 0) && (IRQn < TEST_NR_OF_IRQS)) {
+        test_irq_enabled[IRQn] = TRUE;
+    }
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn) {
+    if ((IRQn >= 0) && (IRQn < TEST_NR_OF_IRQS)) {
+        test_irq_enabled[IRQn] = FALSE;
+    }
+}
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_AnalogWDGConfig(ADC_HandleTypeDef *hadc, ADC_AnalogWDGConfTypeDef *AnalogWDGConfig) {
+    hadc->Instance->HTR = AnalogWDGConfig->HighThreshold;
+    hadc->Instance->LTR = AnalogWDGConfig->LowThreshold;
+    if (AnalogWDGConfig->ITMode == ENABLE) {
+        hadc->Instance->CR1 |= ADC_CR1_AWDIE;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc) {
+    uint32_t i = (uint32_t)(hadc->Instance - host_adc);
+
+    test_adc_running[i] = TRUE;
+    test_adc_conversion[i] = host_dwt.CYCCNT;
+    return HAL_OK;
+}
+
+DIAG_RETURNTYPE_e DIAG_Handler(DIAG_CH_ID_e diag_ch_id, DIAG_EVENT_e event, uint8_t item_nr, void*  data) {
+    return DIAG_HANDLER_RETURN_OK;
+}
+
+STD_RETURN_TYPE_e EVT_Post(EVT_TYPE_e type, uint32_t data) {
+    return E_OK;
+}
+
+uint32_t MCU_GetTimeStamp(void) {
+    return host_dwt.CYCCNT / (SystemCoreClock / 1000);
+}
+
+/**
+ * @brief   hardware model, runs at every access to DWT: time, conversions, watchdog and interrupt
+ */
+static void TEST_Hardware(void) {
+    ADC_TypeDef *adc = NULL_PTR;
+    uint8_t pending = FALSE;
+    uint8_t i = 0;
+
+    host_dwt.CYCCNT += TEST_CYCLES_PER_ACCESS;
+    if (test_in_isr == TRUE) {
+        return;
+    }
+
+    for (i = 0; i < 3; i++) {
+        adc = &host_adc[i];
+        if ((test_adc_running[i] == TRUE) && ((host_dwt.CYCCNT - test_adc_conversion[i]) >= TEST_CONVERSION_CYCLES)) {
+            test_adc_conversion[i] += TEST_CONVERSION_CYCLES;
+            adc->DR = test_adc_input[i];
+            if ((adc->DR < adc->LTR) || (adc->DR > adc->HTR)) {
+                adc->SR |= ADC_SR_AWD;
+            }
+        }
+        if (((adc->SR & ADC_SR_AWD) != 0) && ((adc->CR1 & ADC_CR1_AWDIE) != 0)) {
+            pending = TRUE;
+        }
+    }
+
+    if ((pending == TRUE) && (test_irq_enabled[ADC_IRQn] == TRUE)) {
+        host_dwt.CYCCNT += TEST_IRQ_ENTRY_CYCLES;
+        test_in_isr = TRUE;
+        FTRIP_IRQHandler();
+        test_in_isr = FALSE;
+    }
+}
+
+/**
+ * @brief   self test before NVIC_PreOsInit(): the interrupt is disabled, the self test must time out
+ *
+ * @return  number of failures
+ */
+static uint32_t TEST_SelfTestWithoutInterrupt(void) {
+    STD_RETURN_TYPE_e retval = FTRIP_Init();
+
+    printf("test_fasttrip: self test without NVIC_PreOsInit() %s\n", (retval == E_OK) ? "passed" : "timed out");
+    return (retval == E_NOT_OK) ? 0 : 1;
+}
+
+/**
+ * @brief   boot order of main(): NVIC_PreOsInit(), then the self test must pass on every channel
+ *
+ * @return  number of failures
+ */
+static uint32_t TEST_SelfTest(void) {
+    FTRIP_STATUS_s status;
+    STD_RETURN_TYPE_e retval = E_NOT_OK;
+    uint32_t failures = 0;
+    uint8_t i = 0;
+
+    NVIC_PreOsInit();
+    if ((test_irq_enabled[ADC_IRQn] != TRUE) || (test_irq_priority[ADC_IRQn] != 0)) {
+        failures++;
+    }
+    /* the other interrupts are set up after the scheduler start */
+    if ((test_irq_enabled[USART2_IRQn] == TRUE) || (test_irq_enabled[SPI6_IRQn] == TRUE)) {
+        failures++;
+    }
+
+    retval = FTRIP_Init();
+    FTRIP_GetStatus(&status);
+    if ((retval != E_OK) || (status.tripped_channels != 0)) {
+        failures++;
+    }
+    for (i = 0; i < FTRIP_NR_OF_CHANNELS; i++) {
+        printf("test_fasttrip: self test channel %u %u cycles\n", i, status.selftest_cycles[i]);
+        if ((status.selftest_cycles[i] == 0) || (status.selftest_cycles[i] >= FTRIP_SELFTEST_TIMEOUT_CYCLES)) {
+            failures++;
+        }
+        if ((ftrip_channels[i].adc->Instance->CR1 & ADC_CR1_AWDIE) == 0) {
+            failures++;     // not armed after the self test
+        }
+    }
+    return failures;
+}
+
+/**
+ * @brief   a current above the window trips channel 0 and drives the interlock line low
+ *
+ * @return  number of failures
+ */
+static uint32_t TEST_Trip(void) {
+    FTRIP_STATUS_s status;
+    uint32_t failures = 0;
+    uint32_t i = 0;
+
+    host_gpiod.BSRR = 0;
+    test_adc_input[1] = ftrip_channels[0].high_raw + 1;
+    for (i = 0; i < TEST_TRIP_STEPS; i++) {
+        TEST_Hardware();
+    }
+    FTRIP_GetStatus(&status);
+    printf("test_fasttrip: trip channels 0x%x, count %u, isr %u cycles\n",
+           status.tripped_channels, status.trip_count, status.isr_cycles_last);
+    if ((status.tripped_channels != 0x1) || (status.trip_count != 1) ||
+        (host_gpiod.BSRR != ((uint32_t)FTRIP_INTERLOCK_PIN << 16))) {
+        failures++;
+    }
+    return failures;
+}
+
+int main(void) {
+    uint32_t failures = 0;
+
+    /* inside both windows: zero current and half of the maximum pack voltage */
+    test_adc_input[1] = FTRIP_RAW_CURRENT(0);
+    test_adc_input[2] = FTRIP_RAW_VOLTAGE(FTRIP_PACK_VOLTAGE_MAX_MV / 2);
+    host_dwt_hook = TEST_Hardware;
+
+    failures += TEST_SelfTestWithoutInterrupt();
+    failures += TEST_SelfTest();
+    failures += TEST_Trip();
+
+    printf("test_fasttrip: %u failures\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
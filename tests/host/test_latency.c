@@ -0,0 +1,266 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    test_latency.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Simulation of the violation to interlock latency with the measurement of latency.c
+ *
+ * The checks, the BMS state machine and the interlock are modeled with the task periods
+ * of lat_channels[], the DIAG thresholds of diag_ch_cfg[], the BMS state machine times and
+ * the TEST_SIM_xxx parameters. The stages are timestamped by latency.c, with the DWT cycle
+ * counter of the host stub running at 1 cycle per us. The latency distribution of every
+ * channel is printed, and each channel must complete every run within the bounds of the
+ * model.
+ */
+
+/*================== Includes =============================================*/
+#include <stdio.h>
+
+#include "general.h"
+#include "latency.h"
+
+#include "bms_cfg.h"
+#include "database.h"
+#include "diag.h"
+#include "mcu.h"
+#include "os.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * number of simulated violations per channel, spread over one sample period
+ */
+#define TEST_SIM_RUNS               (200)
+
+/**
+ * period of the task that runs the checks and the BMS state machine (APPL_Cyclic_1ms) in ms
+ */
+#define TEST_SIM_APPL_PERIOD_MS     (1)
+
+/**
+ * start of the engine 1ms task (ILCK_Trigger()) relative to the application 1ms task in us
+ */
+#define TEST_SIM_ENGINE_OFFSET_US   (500)
+
+/**
+ * largest release jitter of the simulated tasks in us, uniformly distributed
+ */
+#define TEST_SIM_TASK_JITTER_US     (100)
+
+/**
+ * number of ILCK_Trigger() calls from the open request to interlock off
+ */
+#define TEST_SIM_ILCK_CYCLES        (1)
+
+/*================== Constant and Variable Definitions ====================*/
+
+DWT_Type host_dwt;
+CoreDebug_Type host_coredebug;
+void (*host_dwt_hook)(void) = NULL;
+uint32_t SystemCoreClock = 1000000;     /* one cycle per us */
+
+static uint32_t test_sim_seed = 1;
+
+/*================== Function Implementations =============================*/
+
+uint32_t MCU_GetTimeStamp(void) {
+    return host_dwt.CYCCNT / 1000;
+}
+
+void OS_TaskEnter_Critical(void) {
+}
+
+void OS_TaskExit_Critical(void) {
+}
+
+void DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e blockID) {
+}
+
+void DB_WriteBlock(void *dataptrfromSender, DATA_BLOCK_ID_TYPE_e blockID) {
+}
+
+/**
+ * @brief   returns a simulated task release jitter
+ *
+ * @return  jitter in us, 0 <= jitter <= TEST_SIM_TASK_JITTER_US
+ */
+static uint32_t TEST_SimJitter(void) {
+    test_sim_seed = test_sim_seed * 1664525UL + 1013904223UL;
+    return (test_sim_seed >> 8) % (TEST_SIM_TASK_JITTER_US + 1);
+}
+
+/**
+ * @brief   returns the first release of a periodic task at or after a time
+ *
+ * @param   t:          time in us
+ * @param   period:     task period in us
+ * @param   offset:     first release in us
+ *
+ * @return  release time in us, including the jitter
+ */
+static uint32_t TEST_SimRelease(uint32_t t, uint32_t period, uint32_t offset) {
+    uint32_t n = (t - offset + period - 1) / period;
+
+    return n * period + offset + TEST_SimJitter();
+}
+
+/**
+ * @brief   returns the DIAG threshold of a channel from diag_ch_cfg[]
+ *
+ * @param   id:     DIAG channel
+ *
+ * @return  number of NOK events until the error flag is set
+ */
+static uint16_t TEST_SimThreshold(DIAG_CH_ID_e id) {
+    uint8_t i = 0;
+
+    for (i = 0; i < diag_dev.nr_of_ch; i++) {
+        if ((diag_dev.ch_cfg[i].id == id) && (diag_dev.ch_cfg[i].thresholds > 0)) {
+            return diag_dev.ch_cfg[i].thresholds;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief   simulates TEST_SIM_RUNS violations of a channel
+ *
+ * @param   c:  index in lat_channels[]
+ */
+static void TEST_Simulate(uint8_t c) {
+    uint32_t appl_us = TEST_SIM_APPL_PERIOD_MS * 1000UL;
+    uint32_t sample_us = lat_channels[c].sample_period_ms * 1000UL;
+    uint32_t check_us = lat_channels[c].check_period_ms * 1000UL;
+    uint16_t threshold = TEST_SimThreshold(lat_channels[c].id);
+    uint32_t t_sample = 0;
+    uint32_t t = 0;
+    uint16_t run = 0;
+
+    for (run = 0; run < TEST_SIM_RUNS; run++) {
+        /* violations spread over one sample period, far enough apart to be independent */
+        t_sample = (run + 1) * (LAT_EPISODE_TIMEOUT_MS + 1000UL) * 1000UL + (run * sample_us) / TEST_SIM_RUNS;
+
+        /* first check after the database write, the threshold is crossed by the n-th check */
+        host_dwt.CYCCNT = TEST_SimRelease(t_sample, check_us, 0);
+        LAT_MarkSample(lat_channels[c].id, t_sample / 1000);
+        host_dwt.CYCCNT += (threshold - 1) * check_us;
+        LAT_MarkChannel(lat_channels[c].id, LAT_STAGE_THRESHOLD);
+        LAT_MarkChannel(lat_channels[c].id, LAT_STAGE_ERRORFLAG);
+
+        /* checks of BMS_Trigger() run before the state machine in the same call */
+        if (check_us != appl_us) {
+            host_dwt.CYCCNT = TEST_SimRelease(host_dwt.CYCCNT, appl_us, 0);
+        }
+        LAT_Mark(LAT_STAGE_STATE);
+
+        /* entry action of the error state after its timer */
+        host_dwt.CYCCNT += BMS_STATEMACH_SHORTTIME_MS * 1000UL;
+        LAT_Mark(LAT_STAGE_REQUEST);
+
+        /* interlock state machine and ENG_InterlockSwitchingAccounting() in the engine 1ms task */
+        t = TEST_SimRelease(host_dwt.CYCCNT, 1000UL, TEST_SIM_ENGINE_OFFSET_US);
+        host_dwt.CYCCNT = t + (TEST_SIM_ILCK_CYCLES - 1) * 1000UL;
+        LAT_Mark(LAT_STAGE_ILCK_OFF);
+    }
+}
+
+/**
+ * @brief   prints the latency distribution of a channel
+ *
+ * @param   c:      index in lat_channels[]
+ * @param   stats:  statistics of the channel
+ */
+static void TEST_Print(uint8_t c, const LAT_STATISTICS_s *stats) {
+    uint8_t i = 0;
+    uint8_t s = 0;
+
+    for (i = 0; i < diag_dev.nr_of_ch; i++) {
+        if (diag_dev.ch_cfg[i].id == lat_channels[c].id) {
+            break;
+        }
+    }
+    printf("test_latency: %-40s threshold %5u, %lu runs\n",
+           (i < diag_dev.nr_of_ch) ? (const char *)diag_dev.ch_cfg[i].description : "unconfigured",
+           TEST_SimThreshold(lat_channels[c].id), (unsigned long)stats->count);
+    printf("    total us: min %lu max %lu mean %lu\n", (unsigned long)stats->total_min_us,
+           (unsigned long)stats->total_max_us,
+           (unsigned long)((stats->count > 0) ? (stats->total_sum_us / stats->count) : 0));
+    printf("    stage us (min..max):");
+    for (s = LAT_STAGE_THRESHOLD; s < LAT_NR_OF_STAGES; s++) {
+        printf(" %lu..%lu", (unsigned long)stats->stage_min_us[s], (unsigned long)stats->stage_max_us[s]);
+    }
+    printf("\n    histogram:");
+    for (i = 0; i < LAT_HISTOGRAM_BINS; i++) {
+        if ((stats->histogram[i] != 0) && (i < (LAT_HISTOGRAM_BINS - 1))) {
+            printf(" <%lu:%u", (unsigned long)LAT_HISTOGRAM_FIRST_US << i, stats->histogram[i]);
+        } else if (stats->histogram[i] != 0) {
+            printf(" >=%lu:%u", (unsigned long)LAT_HISTOGRAM_FIRST_US << (i - 1), stats->histogram[i]);
+        }
+    }
+    printf("\n");
+}
+
+int main(void) {
+    LAT_STATISTICS_s stats;
+    uint32_t failures = 0;
+    uint32_t bound_min = 0;
+    uint32_t bound_max = 0;
+    uint32_t check_us = 0;
+    uint16_t threshold = 0;
+    uint8_t c = 0;
+
+    LAT_Init();
+
+    for (c = 0; c < LAT_NR_OF_CHANNELS; c++) {
+        TEST_Simulate(c);
+        LAT_GetStatistics(c, &stats);
+        TEST_Print(c, &stats);
+
+        /*
+         * bounds of the model: the n-th check after the sample (at most one check period plus
+         * jitter late), the state machine in the next application cycle, its timer and the next
+         * engine cycle (at least its offset minus the jitter after the application cycle); the
+         * sample timestamp has a resolution of 1ms, which can only lengthen the measurement
+         */
+        check_us = lat_channels[c].check_period_ms * 1000UL;
+        threshold = TEST_SimThreshold(lat_channels[c].id);
+        bound_min = (threshold - 1) * check_us + BMS_STATEMACH_SHORTTIME_MS * 1000UL +
+                    TEST_SIM_ENGINE_OFFSET_US - TEST_SIM_TASK_JITTER_US;
+        bound_max = threshold * check_us + TEST_SIM_APPL_PERIOD_MS * 1000UL + BMS_STATEMACH_SHORTTIME_MS * 1000UL +
+                    TEST_SIM_ILCK_CYCLES * 1000UL + 3 * TEST_SIM_TASK_JITTER_US + 1000UL;
+        if ((stats.count != TEST_SIM_RUNS) || (stats.incomplete != 0) ||
+                (stats.total_min_us < bound_min) || (stats.total_max_us > bound_max)) {
+            printf("    FAIL: expected %u runs within %lu..%lu us\n", TEST_SIM_RUNS,
+                   (unsigned long)bound_min, (unsigned long)bound_max);
+            failures++;
+        }
+    }
+
+    printf("test_latency: %u failures\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    test_soa_derating.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Equivalence of the fixed-point and the floating point derating lookup
+ *
+ * SOA_DeratingLookup() is compared with SOA_DeratingLookup_Ref() for both tables
+ * of soa_cfg.c, every temperature from TEST_TEMPERATURE_MIN to TEST_TEMPERATURE_MAX
+ * (inside and outside the table) and every SOC in 0.01% steps.
+ */
+
+/*================== Includes =============================================*/
+#include <stdio.h>
+
+#include "general.h"
+#include "soa_derating.h"
+
+/*================== Macros and Definitions ===============================*/
+
+#define TEST_TEMPERATURE_MIN    (SOA_DERATING_TEMPERATURE_MIN - 20)
+#define TEST_TEMPERATURE_MAX    (SOA_DERATING_TEMPERATURE_MIN + SOA_DERATING_NR_OF_TEMPERATURES * SOA_DERATING_TEMPERATURE_STEP + 20)
+
+/**
+ * allowed deviation in Q15 LSB: each of the three interpolation steps truncates once
+ */
+#define TEST_TOLERANCE_LSB      (3.0f)
+
+/*================== Function Implementations =============================*/
+
+static uint32_t TEST_Table(const uint16_t table[SOA_DERATING_NR_OF_TEMPERATURES][SOA_DERATING_NR_OF_SOCS],
+                           const char *name) {
+    float error = 0.0f;
+    float error_max = 0.0f;
+    uint32_t failures = 0;
+    uint32_t checks = 0;
+    int16_t t = 0;
+    uint16_t soc = 0;
+
+    for (t = TEST_TEMPERATURE_MIN; t <= TEST_TEMPERATURE_MAX; t++) {
+        for (soc = 0; soc <= 10000; soc++) {
+            error = (float)SOA_DeratingLookup(table, t, soc) - SOA_DeratingLookup_Ref(table, t,(float)soc);
+            error = (error >= 0.0f) ? error : -error;
+            if (error > error_max) {
+                error_max = error;
+            }
+            if (error > TEST_TOLERANCE_LSB) {
+                if (failures < 10) {
+                    printf("FAIL %s: %d degC, SOC %u: %u, reference %f\n", name, t, soc,
+                           SOA_DeratingLookup(table, t, soc), SOA_DeratingLookup_Ref(table, t, soc));
+                }
+                failures++;
+            }
+            checks++;
+        }
+    }
+    printf("test_soa_derating: %s %u checks, max deviation %.2f LSB, %u failures\n", name, checks, error_max, failures);
+    return failures;
+}
+
+int main(void) {
+    uint32_t failures = 0;
+
+    failures += TEST_Table(soa_derating_discharge, "soa_derating_discharge");
+    failures += TEST_Table(soa_derating_charge, "soa_derating_charge");
+
+    return (failures == 0) ? 0 : 1;
+}
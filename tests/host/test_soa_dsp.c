@@ -0,0 +1,179 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    test_soa_dsp.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Equivalence of the DSP and the reference implementations of soa_dsp.c
+ *
+ * soa_dsp.c is built with the emulated SIMD intrinsics of stubs/stm32f4xx_hal.h,
+ * every cell count from 1 to TEST_MAX_CELLS is checked with pseudo-random data,
+ * with data at the limits and with constant data (ties of minimum and maximum).
+ */
+
+/*================== Includes =============================================*/
+#include <stdio.h>
+#include <string.h>
+
+#include "general.h"
+#include "soa_dsp.h"
+
+/*================== Macros and Definitions ===============================*/
+
+#define TEST_MAX_CELLS      (600)
+#define TEST_NR_OF_PATTERNS (4)
+
+/*================== Constant and Variable Definitions ====================*/
+
+static uint32_t test_seed = 0x12345678U;
+static uint32_t test_checks = 0;
+static uint32_t test_failures = 0;
+
+/* one element more than needed: the data is also checked at an odd (unaligned) start */
+static uint16_t test_voltage[TEST_MAX_CELLS + 1];
+static int16_t test_temperature[TEST_MAX_CELLS + 1];
+
+/*================== Function Implementations =============================*/
+
+static uint32_t TEST_Random(void) {
+    test_seed ^= test_seed << 13;
+    test_seed ^= test_seed >> 17;
+    test_seed ^= test_seed << 5;
+    return test_seed;
+}
+
+static void TEST_Expect(uint8_t condition, const char *what, uint16_t nr, uint8_t pattern) {
+    test_checks++;
+    if (condition == FALSE) {
+        test_failures++;
+        printf("FAIL %s: %u cells, pattern %u\n", what, nr, pattern);
+    }
+}
+
+/**
+ * pattern 0: random over the whole range, 1: random around the limits,
+ * 2: constant, 3: random with few distinct values (many ties)
+ */
+static void TEST_Fill(uint8_t pattern) {
+    uint16_t i = 0;
+
+    for (i = 0; i < TEST_MAX_CELLS + 1; i++) {
+        switch (pattern) {
+            case 0:
+                test_voltage[i] = (uint16_t)TEST_Random();
+                test_temperature[i] = (int16_t)TEST_Random();
+                break;
+            case 1:
+                test_voltage[i] = (uint16_t)(1698 + (TEST_Random() % 5) + ((TEST_Random() & 1) ? 1100 : 0));
+                test_temperature[i] = (int16_t)(-22 + (TEST_Random() % 5) + ((TEST_Random() & 1) ? 75 : 0));
+                break;
+            case 2:
+                test_voltage[i] = 3300;
+                test_temperature[i] = -5;
+                break;
+            default:
+                test_voltage[i] = (uint16_t)(3000 + (TEST_Random() % 3));
+                test_temperature[i] = (int16_t)(20 - (int16_t)(TEST_Random() % 3));
+                break;
+        }
+    }
+}
+
+static uint8_t TEST_MinMaxEqual(const DATA_BLOCK_MINMAX_s *a, const DATA_BLOCK_MINMAX_s *b) {
+    return (a->voltage_min == b->voltage_min) && (a->voltage_max == b->voltage_max) &&
+           (a->voltage_mean == b->voltage_mean) &&
+           (a->voltage_module_number_min == b->voltage_module_number_min) &&
+           (a->voltage_cell_number_min == b->voltage_cell_number_min) &&
+           (a->voltage_module_number_max == b->voltage_module_number_max) &&
+           (a->voltage_cell_number_max == b->voltage_cell_number_max) &&
+           (a->temperature_min == b->temperature_min) && (a->temperature_max == b->temperature_max) &&
+           (a->temperature_mean == b->temperature_mean) &&
+           (a->temperature_module_number_min == b->temperature_module_number_min) &&
+           (a->temperature_sensor_number_min == b->temperature_sensor_number_min) &&
+           (a->temperature_module_number_max == b->temperature_module_number_max) &&
+           (a->temperature_sensor_number_max == b->temperature_sensor_number_max);
+}
+
+static void TEST_Run(uint16_t nr, uint8_t pattern, uint8_t offset) {
+    const uint16_t *voltage = &test_voltage[offset];
+    const int16_t *temperature = &test_temperature[offset];
+    uint32_t under[2][SOA_MASK_WORDS(TEST_MAX_CELLS)];
+    uint32_t over[2][SOA_MASK_WORDS(TEST_MAX_CELLS)];
+    uint32_t sums[2][TEST_MAX_CELLS];
+    DATA_BLOCK_MINMAX_s minmax[2];
+    uint8_t ret[2];
+    uint16_t cells_per_module = 0;
+
+    ret[0] = SOA_CheckVoltages(voltage, nr, 1700, 2800, under[0], over[0]);
+    ret[1] = SOA_CheckVoltages_Ref(voltage, nr, 1700, 2800, under[1], over[1]);
+    TEST_Expect((ret[0] == ret[1]) &&
+                (memcmp(under[0], under[1], SOA_MASK_WORDS(nr) * sizeof(uint32_t)) == 0) &&
+                (memcmp(over[0], over[1], SOA_MASK_WORDS(nr) * sizeof(uint32_t)) == 0),
+                "SOA_CheckVoltages", nr, pattern);
+
+    ret[0] = SOA_CheckTemperatures(temperature, nr, -20, 55, under[0], over[0]);
+    ret[1] = SOA_CheckTemperatures_Ref(temperature, nr, -20, 55, under[1], over[1]);
+    TEST_Expect((ret[0] == ret[1]) &&
+                (memcmp(under[0], under[1], SOA_MASK_WORDS(nr) * sizeof(uint32_t)) == 0) &&
+                (memcmp(over[0], over[1], SOA_MASK_WORDS(nr) * sizeof(uint32_t)) == 0),
+                "SOA_CheckTemperatures", nr, pattern);
+
+    memset(minmax, 0, sizeof(minmax));
+    SOA_CalcVoltageMinMax(voltage, nr, 12, &minmax[0]);
+    SOA_CalcTemperatureMinMax(temperature, nr, 6, &minmax[0]);
+    SOA_CalcVoltageMinMax_Ref(voltage, nr, 12, &minmax[1]);
+    SOA_CalcTemperatureMinMax_Ref(temperature, nr, 6, &minmax[1]);
+    TEST_Expect(TEST_MinMaxEqual(&minmax[0], &minmax[1]), "SOA_CalcMinMax", nr, pattern);
+
+    /* every divider of nr as module size, odd sizes take the reference path */
+    for (cells_per_module = 1; cells_per_module <= nr; cells_per_module++) {
+        if ((nr % cells_per_module) == 0) {
+            SOA_CalcModuleSums(voltage, nr / cells_per_module, cells_per_module, sums[0]);
+            SOA_CalcModuleSums_Ref(voltage, nr / cells_per_module, cells_per_module, sums[1]);
+            TEST_Expect(memcmp(sums[0], sums[1], (nr / cells_per_module) * sizeof(uint32_t)) == 0,
+                        "SOA_CalcModuleSums", nr, pattern);
+        }
+    }
+}
+
+int main(void) {
+    uint8_t pattern = 0;
+    uint8_t offset = 0;
+    uint16_t nr = 0;
+
+    for (pattern = 0; pattern < TEST_NR_OF_PATTERNS; pattern++) {
+        TEST_Fill(pattern);
+        for (offset = 0; offset < 2; offset++) {
+            for (nr = 1; nr <= TEST_MAX_CELLS; nr++) {
+                TEST_Run(nr, pattern, offset);
+            }
+        }
+    }
+
+    printf("test_soa_dsp: %u checks, %u failures\n", test_checks, test_failures);
+    return (test_failures == 0) ? 0 : 1;
+}
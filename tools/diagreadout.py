@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+# @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der
+#   angewandten Forschung e.V. All rights reserved.
+#
+# BSD 3-Clause License
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1.  Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+# 2.  Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+# 3.  Neither the name of the copyright holder nor the names of its
+#     contributors may be used to endorse or promote products derived from this
+#     software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# We kindly request you to use one or more of the following phrases to refer to
+# foxBMS in your hardware, software, documentation or advertising materials:
+#
+# &Prime;This product uses parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product includes parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product is derived from foxBMS&reg;&Prime;
+
+"""Reads the diagnosis memory of the secondary MCU over the FTDI UART
+
+The requests are processed by DIAG_ReadoutCommand() (src/engine/diag/diag.c),
+the framing is done by src/engine/com/com.c:
+
+    request:  0xA5, command, argument (16bit, little endian), XOR checksum
+    response: 0xA5, length n, n bytes, XOR checksum of length and data
+
+Usage: diagreadout.py PORT [--ack]
+    Prints all unread entries, --ack acknowledges them afterwards.
+Requires pyserial.
+"""
+
+import argparse
+import struct
+import sys
+
+import serial
+
+SYNC = 0xA5
+CMD_STATUS = 0x01
+CMD_READ = 0x02
+CMD_ACK = 0x03
+RESPONSE_OK = 0x00
+RETRIES = 3
+
+
+def request(port, cmd, arg=0):
+    """sends a request and returns the payload of the response (without cmd and result)"""
+    body = bytes([cmd, arg & 0xFF, (arg >> 8) & 0xFF])
+    checksum = body[0] ^ body[1] ^ body[2]
+    for _ in range(RETRIES):
+        port.reset_input_buffer()
+        port.write(bytes([SYNC]) + body + bytes([checksum]))
+        header = port.read(2)
+        if len(header) != 2 or header[0] != SYNC:
+            continue
+        data = port.read(header[1] + 1)
+        if len(data) != header[1] + 1:
+            continue
+        check = header[1]
+        for byte in data[:-1]:
+            check ^= byte
+        if check != data[-1] or data[0] != cmd:
+            continue
+        if data[1] != RESPONSE_OK:
+            return None
+        return data[2:-1]
+    raise IOError('no valid response to command 0x%02x' % cmd)
+
+
+def main():
+    """reads and prints the unread entries"""
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('port', help='serial port of the FTDI bridge')
+    parser.add_argument('--ack', action='store_true', help='acknowledge the printed entries')
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, 115200, timeout=0.5) as port:
+        unread, lost, rdcnt, wrcnt = struct.unpack('<IIII', request(port, CMD_STATUS))
+        print('unread %d, lost %d, read counter %d, write counter %d' % (unread, lost, rdcnt, wrcnt))
+        printed = 0
+        for offset in range(unread):
+            entry = request(port, CMD_READ, offset)
+            if entry is None:
+                print('entry %d overwritten while reading' % offset)
+                break
+            (yy, mon, day, hh, mm, ss, event, event_id, item,
+             val0, val1, val2, val3) = struct.unpack('<9B4I', entry)
+            print('20%02d-%02d-%02d %02d:%02d:%02d id %3d item %3d event %d  %08x %08x %08x %08x' %
+                  (yy, mon, day, hh, mm, ss, event_id, item, event, val0, val1, val2, val3))
+            printed += 1
+        if args.ack and printed > 0:
+            acked = struct.unpack('<I', request(port, CMD_ACK, printed))[0]
+            print('acknowledged %d entries' % acked)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())